@@ -0,0 +1,24 @@
+# Defines the functions to use QuadMath
+#
+# .. cmake_function:: add_dune_quadmath_flags
+#
+#    .. cmake_param:: targets
+#       :positional:
+#       :single:
+#       :required:
+#
+#       A list of targets to use QuadMath with.
+#
+
+function(add_dune_quadmath_flags _targets)
+  if(QUADMATH_FOUND)
+    foreach(_target ${_targets})
+      target_link_libraries(${_target} "quadmath")
+      target_compile_definitions(${_target} PUBLIC ENABLE_QUADMATH=1 _GLIBCXX_USE_FLOAT128=1)
+      # -fext-numeric-literals is a GCC extension not available in other compilers like clang
+      if(${CMAKE_CXX_COMPILER_ID} STREQUAL GNU)
+        target_compile_options(${_target} PUBLIC -fext-numeric-literals)
+      endif()
+    endforeach(_target ${_targets})
+  endif(QUADMATH_FOUND)
+endfunction(add_dune_quadmath_flags)
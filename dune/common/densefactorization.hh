@@ -0,0 +1,674 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_DENSEFACTORIZATION_HH
+#define DUNE_DENSEFACTORIZATION_HH
+
+/** \file
+ * \brief Reusable LU, Cholesky and LDL^T factorizations of dense matrices
+ *
+ * The classes in this file factorize a square FieldMatrix or DynamicMatrix
+ * once and keep the factors, so that linear systems with many right hand
+ * sides, the determinant and the inverse can be computed without repeating
+ * the elimination.  Large matrices are factorized in panels of
+ * \c blockSize columns, which keeps the trailing updates in cache.  For a
+ * FieldMatrix the matrix size is a compile-time constant, so the compiler
+ * can unroll all loops.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/densematrix.hh>
+#include <dune/common/densevector.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/ftraits.hh>
+#include <dune/common/math.hh>
+#include <dune/common/precision.hh>
+#include <dune/common/typetraits.hh>
+
+namespace Dune {
+
+  /**
+     @addtogroup DenseMatVec
+     @{
+   */
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // storage of the factors of a matrix of type MAT, the size is a
+    // compile-time constant for FieldMatrix
+    template<class MAT>
+    struct DenseFactorizationTraits
+    {
+      static constexpr std::size_t staticSize = 0;
+      typedef std::vector<std::size_t> PivotVector;
+
+      static void resize (PivotVector& pivot, std::size_t n)
+      {
+        pivot.resize(n);
+      }
+
+      static void resize (MAT& m, std::size_t n)
+      {
+        if (m.N() != n || m.M() != n)
+          m.resize(n, n);
+      }
+    };
+
+    template<class K, int n>
+    struct DenseFactorizationTraits<FieldMatrix<K,n,n> >
+    {
+      static constexpr std::size_t staticSize = n;
+      typedef std::array<std::size_t,n> PivotVector;
+
+      static void resize (PivotVector&, std::size_t) {}
+      static void resize (FieldMatrix<K,n,n>&, std::size_t) {}
+    };
+
+    template<class K>
+    K realPart (const K& k)
+    {
+      return k;
+    }
+
+    template<class K>
+    K realPart (const std::complex<K>& k)
+    {
+      return k.real();
+    }
+
+    // x = b for vectors and matrices of matching size
+    template<class X, class B>
+    void copyRightHandSide (DenseVector<X>& x, const DenseVector<B>& b)
+    {
+      assert(x.size() == b.size());
+      for (std::size_t i = 0; i < b.size(); ++i)
+        x[i] = b[i];
+    }
+
+    template<class X, class B>
+    void copyRightHandSide (DenseMatrix<X>& x, const DenseMatrix<B>& b)
+    {
+      assert(x.N() == b.N() && x.M() == b.M());
+      for (std::size_t i = 0; i < b.N(); ++i)
+        for (std::size_t j = 0; j < b.M(); ++j)
+          x[i][j] = b[i][j];
+    }
+
+    // x[i] -= a*x[k] for vectors (one right hand side) and matrices
+    // (one right hand side per column)
+    template<class X, class K>
+    void axpyRow (DenseVector<X>& x, std::size_t i, const K& a, std::size_t k)
+    {
+      x[i] -= a*x[k];
+    }
+
+    template<class X, class K>
+    void axpyRow (DenseMatrix<X>& x, std::size_t i, const K& a, std::size_t k)
+    {
+      auto&& xi = x[i];
+      const auto& xk = x[k];
+      for (std::size_t j = 0; j < x.M(); ++j)
+        xi[j] -= a*xk[j];
+    }
+
+    template<class X, class K>
+    void scaleRow (DenseVector<X>& x, std::size_t i, const K& a)
+    {
+      x[i] *= a;
+    }
+
+    template<class X, class K>
+    void scaleRow (DenseMatrix<X>& x, std::size_t i, const K& a)
+    {
+      x[i] *= a;
+    }
+
+    template<class X>
+    void swapRows (DenseVector<X>& x, std::size_t i, std::size_t k)
+    {
+      using std::swap;
+      swap(x[i], x[k]);
+    }
+
+    template<class X>
+    void swapRows (DenseMatrix<X>& x, std::size_t i, std::size_t k)
+    {
+      using std::swap;
+      for (std::size_t j = 0; j < x.M(); ++j)
+        swap(x[i][j], x[k][j]);
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  /** \brief LU factorization with partial pivoting of a square dense matrix
+   *
+   * Computes \f$PA = LU\f$ once, with unit lower triangular \f$L\f$ and
+   * upper triangular \f$U\f$, and solves with the stored factors.  Columns
+   * are eliminated in panels of blockSize columns, the rest of the matrix
+   * is updated once per panel.
+   *
+   * \tparam MAT a FieldMatrix or DynamicMatrix with a number field type
+   */
+  template<class MAT>
+  class DenseLUFactorization
+  {
+    typedef Impl::DenseFactorizationTraits<MAT> Traits;
+
+  public:
+    //! type of the matrix entries
+    typedef typename MAT::field_type field_type;
+
+    //! type used for sizes
+    typedef typename MAT::size_type size_type;
+
+    //! number of columns eliminated per panel
+    static constexpr size_type blockSize = 32;
+
+    static_assert(IsNumber<field_type>::value,
+                  "DenseLUFactorization needs a number type as field type");
+
+    //! construct an empty factorization, call factorize() before use
+    DenseLUFactorization () = default;
+
+    //! factorize the matrix A
+    explicit DenseLUFactorization (const MAT& A)
+    {
+      factorize(A);
+    }
+
+    /** \brief factorize the matrix A
+     *
+     * The storage of a previous factorization of the same size is reused.
+     *
+     * \exception FMatrixError if A is not square or a pivot is smaller than
+     *            FMatrixPrecision<>::absolute_limit()
+     */
+    void factorize (const MAT& A)
+    {
+      using std::abs;
+      using std::swap;
+      typedef typename FieldTraits<field_type>::real_type real_type;
+
+      if (A.N() != A.M())
+        DUNE_THROW(FMatrixError, "Can't factorize a " << A.N() << "x" << A.M() << " matrix!");
+      lu_ = A;
+      const size_type n = N();
+      Traits::resize(pivot_, n);
+
+      for (size_type k0 = 0; k0 < n; k0 += blockSize)
+      {
+        const size_type k1 = std::min(n, k0 + blockSize);
+
+        // eliminate the columns of the panel [k0,k1), update only the panel
+        for (size_type k = k0; k < k1; ++k)
+        {
+          size_type p = k;
+          real_type pivmax = abs(lu_[k][k]);
+          for (size_type i = k+1; i < n; ++i)
+            if (abs(lu_[i][k]) > pivmax)
+            {
+              pivmax = abs(lu_[i][k]);
+              p = i;
+            }
+          // the same threshold as DenseMatrix::solve() and invert()
+          if (pivmax < FMatrixPrecision<>::absolute_limit())
+            DUNE_THROW(FMatrixError, "matrix is singular");
+
+          pivot_[k] = p;
+          if (p != k)
+            for (size_type j = 0; j < n; ++j)
+              swap(lu_[k][j], lu_[p][j]);
+
+          const field_type inv = field_type(1) / lu_[k][k];
+          const auto& uk = lu_[k];
+          for (size_type i = k+1; i < n; ++i)
+          {
+            auto&& li = lu_[i];
+            li[k] *= inv;
+            const field_type l = li[k];
+            for (size_type j = k+1; j < k1; ++j)
+              li[j] -= l*uk[j];
+          }
+        }
+
+        // U12 = L11^{-1} A12
+        for (size_type k = k0; k < k1; ++k)
+        {
+          const auto& uk = lu_[k];
+          for (size_type i = k+1; i < k1; ++i)
+          {
+            auto&& ui = lu_[i];
+            const field_type l = ui[k];
+            for (size_type j = k1; j < n; ++j)
+              ui[j] -= l*uk[j];
+          }
+        }
+
+        // A22 -= L21 U12
+        for (size_type i = k1; i < n; ++i)
+        {
+          auto&& ai = lu_[i];
+          for (size_type k = k0; k < k1; ++k)
+          {
+            const field_type l = ai[k];
+            const auto& uk = lu_[k];
+            for (size_type j = k1; j < n; ++j)
+              ai[j] -= l*uk[j];
+          }
+        }
+      }
+    }
+
+    //! number of rows and columns of the factorized matrix
+    size_type N () const
+    {
+      return Traits::staticSize ? size_type(Traits::staticSize) : lu_.N();
+    }
+
+    /** \brief solve A x = b
+     *
+     * x and b may be the same vector, otherwise x must have the size of b.
+     */
+    template<class X, class B>
+    void solve (DenseVector<X>& x, const DenseVector<B>& b) const
+    {
+      solveImpl(x, b);
+    }
+
+    /** \brief solve A X = B for all columns of B at once
+     *
+     * X and B may be the same matrix, otherwise X must have the size of B.
+     */
+    template<class X, class B>
+    void solve (DenseMatrix<X>& x, const DenseMatrix<B>& b) const
+    {
+      solveImpl(x, b);
+    }
+
+    //! determinant of the factorized matrix
+    field_type determinant () const
+    {
+      field_type det = field_type(1);
+      for (size_type i = 0; i < N(); ++i)
+        det *= (pivot_[i] == i) ? lu_[i][i] : -lu_[i][i];
+      return det;
+    }
+
+    //! compute the inverse of the factorized matrix
+    void inverse (MAT& inv) const
+    {
+      const size_type n = N();
+      Traits::resize(inv, n);
+      for (size_type i = 0; i < n; ++i)
+        for (size_type j = 0; j < n; ++j)
+          inv[i][j] = field_type(i == j ? 1 : 0);
+      solve(inv, inv);
+    }
+
+  private:
+    template<class X, class B>
+    void solveImpl (X& x, const B& b) const
+    {
+      const size_type n = N();
+      if (static_cast<const void*>(&x) != static_cast<const void*>(&b))
+        Impl::copyRightHandSide(x, b);
+
+      // x = P b
+      for (size_type k = 0; k < n; ++k)
+        if (pivot_[k] != k)
+          Impl::swapRows(x, k, pivot_[k]);
+
+      // L y = P b
+      for (size_type i = 0; i < n; ++i)
+        for (size_type k = 0; k < i; ++k)
+          Impl::axpyRow(x, i, lu_[i][k], k);
+
+      // U x = y
+      for (size_type i = n; i > 0;)
+      {
+        --i;
+        for (size_type k = i+1; k < n; ++k)
+          Impl::axpyRow(x, i, lu_[i][k], k);
+        Impl::scaleRow(x, i, field_type(1) / lu_[i][i]);
+      }
+    }
+
+    MAT lu_;
+    typename Traits::PivotVector pivot_;
+  };
+
+  template<class MAT>
+  constexpr typename DenseLUFactorization<MAT>::size_type DenseLUFactorization<MAT>::blockSize;
+
+  /** \brief Cholesky factorization of a symmetric (hermitian) positive definite dense matrix
+   *
+   * Computes \f$A = LL^H\f$ once, with lower triangular \f$L\f$, and solves
+   * with the stored factor.  Only the lower triangle of A is referenced.
+   * Columns are factorized in panels of blockSize columns, the rest of the
+   * matrix is updated once per panel.
+   *
+   * \tparam MAT a FieldMatrix or DynamicMatrix with a number field type
+   */
+  template<class MAT>
+  class DenseCholeskyFactorization
+  {
+    typedef Impl::DenseFactorizationTraits<MAT> Traits;
+
+  public:
+    //! type of the matrix entries
+    typedef typename MAT::field_type field_type;
+
+    //! type used for sizes
+    typedef typename MAT::size_type size_type;
+
+    //! number of columns factorized per panel
+    static constexpr size_type blockSize = 32;
+
+    static_assert(IsNumber<field_type>::value,
+                  "DenseCholeskyFactorization needs a number type as field type");
+
+    //! construct an empty factorization, call factorize() before use
+    DenseCholeskyFactorization () = default;
+
+    //! factorize the matrix A
+    explicit DenseCholeskyFactorization (const MAT& A)
+    {
+      factorize(A);
+    }
+
+    /** \brief factorize the matrix A
+     *
+     * The storage of a previous factorization of the same size is reused.
+     *
+     * \exception FMatrixError if A is not square or not positive definite
+     */
+    void factorize (const MAT& A)
+    {
+      using std::sqrt;
+      typedef typename FieldTraits<field_type>::real_type real_type;
+
+      if (A.N() != A.M())
+        DUNE_THROW(FMatrixError, "Can't factorize a " << A.N() << "x" << A.M() << " matrix!");
+      l_ = A;
+      const size_type n = N();
+
+      for (size_type k0 = 0; k0 < n; k0 += blockSize)
+      {
+        const size_type k1 = std::min(n, k0 + blockSize);
+
+        // factorize the columns of the panel [k0,k1), update only the panel
+        for (size_type k = k0; k < k1; ++k)
+        {
+          const real_type d = Impl::realPart(l_[k][k]);
+          if (!(d > real_type(0)))
+            DUNE_THROW(FMatrixError, "matrix is not positive definite");
+          const real_type lkk = sqrt(d);
+          l_[k][k] = lkk;
+
+          const field_type inv = field_type(1) / field_type(lkk);
+          for (size_type i = k+1; i < n; ++i)
+          {
+            auto&& li = l_[i];
+            li[k] *= inv;
+            const field_type lik = li[k];
+            for (size_type j = k+1; j < std::min(i+1, k1); ++j)
+              li[j] -= lik*conjugateComplex(l_[j][k]);
+          }
+        }
+
+        // A22 -= L21 L21^H, lower triangle only
+        for (size_type i = k1; i < n; ++i)
+        {
+          auto&& li = l_[i];
+          for (size_type j = k1; j <= i; ++j)
+          {
+            const auto& lj = l_[j];
+            field_type s = field_type(0);
+            for (size_type k = k0; k < k1; ++k)
+              s += li[k]*conjugateComplex(lj[k]);
+            li[j] -= s;
+          }
+        }
+      }
+    }
+
+    //! number of rows and columns of the factorized matrix
+    size_type N () const
+    {
+      return Traits::staticSize ? size_type(Traits::staticSize) : l_.N();
+    }
+
+    /** \brief solve A x = b
+     *
+     * x and b may be the same vector, otherwise x must have the size of b.
+     */
+    template<class X, class B>
+    void solve (DenseVector<X>& x, const DenseVector<B>& b) const
+    {
+      solveImpl(x, b);
+    }
+
+    /** \brief solve A X = B for all columns of B at once
+     *
+     * X and B may be the same matrix, otherwise X must have the size of B.
+     */
+    template<class X, class B>
+    void solve (DenseMatrix<X>& x, const DenseMatrix<B>& b) const
+    {
+      solveImpl(x, b);
+    }
+
+    //! determinant of the factorized matrix
+    field_type determinant () const
+    {
+      field_type det = field_type(1);
+      for (size_type i = 0; i < N(); ++i)
+        det *= l_[i][i]*l_[i][i];
+      return det;
+    }
+
+    //! compute the inverse of the factorized matrix
+    void inverse (MAT& inv) const
+    {
+      const size_type n = N();
+      Traits::resize(inv, n);
+      for (size_type i = 0; i < n; ++i)
+        for (size_type j = 0; j < n; ++j)
+          inv[i][j] = field_type(i == j ? 1 : 0);
+      solve(inv, inv);
+    }
+
+  private:
+    template<class X, class B>
+    void solveImpl (X& x, const B& b) const
+    {
+      const size_type n = N();
+      if (static_cast<const void*>(&x) != static_cast<const void*>(&b))
+        Impl::copyRightHandSide(x, b);
+
+      // L y = b
+      for (size_type i = 0; i < n; ++i)
+      {
+        for (size_type k = 0; k < i; ++k)
+          Impl::axpyRow(x, i, l_[i][k], k);
+        Impl::scaleRow(x, i, field_type(1) / l_[i][i]);
+      }
+
+      // L^H x = y
+      for (size_type i = n; i > 0;)
+      {
+        --i;
+        Impl::scaleRow(x, i, field_type(1) / l_[i][i]);
+        for (size_type k = 0; k < i; ++k)
+          Impl::axpyRow(x, k, conjugateComplex(l_[i][k]), i);
+      }
+    }
+
+    MAT l_;
+  };
+
+  template<class MAT>
+  constexpr typename DenseCholeskyFactorization<MAT>::size_type DenseCholeskyFactorization<MAT>::blockSize;
+
+  /** \brief LDL^T factorization of a symmetric (hermitian) dense matrix
+   *
+   * Computes \f$A = LDL^H\f$ once, with unit lower triangular \f$L\f$ and
+   * diagonal \f$D\f$, and solves with the stored factors.  Only the lower
+   * triangle of A is referenced.  Unlike the Cholesky factorization no
+   * square roots are taken, and D may have negative entries, but there is
+   * no pivoting: the factorization is stable for positive definite and
+   * for quasi-definite matrices.
+   *
+   * \tparam MAT a FieldMatrix or DynamicMatrix with a number field type
+   */
+  template<class MAT>
+  class DenseLDLTFactorization
+  {
+    typedef Impl::DenseFactorizationTraits<MAT> Traits;
+
+  public:
+    //! type of the matrix entries
+    typedef typename MAT::field_type field_type;
+
+    //! type used for sizes
+    typedef typename MAT::size_type size_type;
+
+    static_assert(IsNumber<field_type>::value,
+                  "DenseLDLTFactorization needs a number type as field type");
+
+    //! construct an empty factorization, call factorize() before use
+    DenseLDLTFactorization () = default;
+
+    //! factorize the matrix A
+    explicit DenseLDLTFactorization (const MAT& A)
+    {
+      factorize(A);
+    }
+
+    /** \brief factorize the matrix A
+     *
+     * The storage of a previous factorization of the same size is reused.
+     *
+     * \exception FMatrixError if A is not square or a pivot is smaller than
+     *            FMatrixPrecision<>::absolute_limit()
+     */
+    void factorize (const MAT& A)
+    {
+      if (A.N() != A.M())
+        DUNE_THROW(FMatrixError, "Can't factorize a " << A.N() << "x" << A.M() << " matrix!");
+      ldl_ = A;
+      const size_type n = N();
+
+      for (size_type k = 0; k < n; ++k)
+      {
+        using std::abs;
+        const field_type d = ldl_[k][k];
+        if (abs(d) < FMatrixPrecision<>::absolute_limit())
+          DUNE_THROW(FMatrixError, "matrix is singular");
+        const field_type inv = field_type(1) / d;
+
+        // rows are updated from the bottom, so that the unscaled entries
+        // ldl_[j][k], j < i, are still available
+        for (size_type i = n; i > k+1;)
+        {
+          --i;
+          auto&& li = ldl_[i];
+          const field_type l = li[k]*inv;
+          for (size_type j = k+1; j <= i; ++j)
+            li[j] -= l*conjugateComplex(ldl_[j][k]);
+          li[k] = l;
+        }
+      }
+    }
+
+    //! number of rows and columns of the factorized matrix
+    size_type N () const
+    {
+      return Traits::staticSize ? size_type(Traits::staticSize) : ldl_.N();
+    }
+
+    /** \brief solve A x = b
+     *
+     * x and b may be the same vector, otherwise x must have the size of b.
+     */
+    template<class X, class B>
+    void solve (DenseVector<X>& x, const DenseVector<B>& b) const
+    {
+      solveImpl(x, b);
+    }
+
+    /** \brief solve A X = B for all columns of B at once
+     *
+     * X and B may be the same matrix, otherwise X must have the size of B.
+     */
+    template<class X, class B>
+    void solve (DenseMatrix<X>& x, const DenseMatrix<B>& b) const
+    {
+      solveImpl(x, b);
+    }
+
+    //! determinant of the factorized matrix
+    field_type determinant () const
+    {
+      field_type det = field_type(1);
+      for (size_type i = 0; i < N(); ++i)
+        det *= ldl_[i][i];
+      return det;
+    }
+
+    //! compute the inverse of the factorized matrix
+    void inverse (MAT& inv) const
+    {
+      const size_type n = N();
+      Traits::resize(inv, n);
+      for (size_type i = 0; i < n; ++i)
+        for (size_type j = 0; j < n; ++j)
+          inv[i][j] = field_type(i == j ? 1 : 0);
+      solve(inv, inv);
+    }
+
+  private:
+    template<class X, class B>
+    void solveImpl (X& x, const B& b) const
+    {
+      const size_type n = N();
+      if (static_cast<const void*>(&x) != static_cast<const void*>(&b))
+        Impl::copyRightHandSide(x, b);
+
+      // L y = b
+      for (size_type i = 0; i < n; ++i)
+        for (size_type k = 0; k < i; ++k)
+          Impl::axpyRow(x, i, ldl_[i][k], k);
+
+      // D z = y
+      for (size_type i = 0; i < n; ++i)
+        Impl::scaleRow(x, i, field_type(1) / ldl_[i][i]);
+
+      // L^H x = z
+      for (size_type i = n; i > 0;)
+      {
+        --i;
+        for (size_type k = 0; k < i; ++k)
+          Impl::axpyRow(x, k, conjugateComplex(ldl_[i][k]), i);
+      }
+    }
+
+    MAT ldl_;
+  };
+
+  /** @} end documentation */
+
+} // end namespace Dune
+
+#endif // DUNE_DENSEFACTORIZATION_HH
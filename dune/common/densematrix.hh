@@ -12,6 +12,7 @@
 
 #include <dune/common/boundschecking.hh>
 #include <dune/common/classname.hh>
+#include <dune/common/densematrixmultiply.hh>
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
 #include <dune/common/math.hh>
@@ -97,9 +98,17 @@ namespace Dune
       }
     };
 
+    // whether the rows of RHS can be copied into the rows of DenseMatrix,
+    // either by conversion or, for proxy rows, by assignment
+    template< class DenseMatrix, class RHSRow >
+    struct IsRowAssignable
+      : public std::integral_constant< bool, std::is_convertible< RHSRow, typename DenseMatrix::iterator::value_type >::value
+          || (!Dune::IsNumber< RHSRow >::value && std::is_assignable< typename DenseMatrix::row_reference, const RHSRow & >::value) >
+    {};
+
     template< class DenseMatrix, class RHS >
     class DenseMatrixAssigner< DenseMatrix, RHS, std::enable_if_t< !std::is_same< typename RHS::const_iterator, void >::value
-        && std::is_convertible< typename RHS::const_iterator::value_type, typename DenseMatrix::iterator::value_type >::value > >
+        && IsRowAssignable< DenseMatrix, typename RHS::const_iterator::value_type >::value > >
     {
     public:
       static void apply ( DenseMatrix &denseMatrix, const RHS &rhs )
@@ -617,13 +626,8 @@ namespace Dune
       DUNE_ASSERT_BOUNDS(M.rows() == rows());
       MAT C(asImp());
 
-      for (size_type i=0; i<rows(); i++)
-        for (size_type j=0; j<cols(); j++) {
-          (*this)[i][j] = 0;
-          for (size_type k=0; k<rows(); k++)
-            (*this)[i][j] += M[i][k]*C[k][j];
-        }
-
+      DenseMatrixHelp::multMatrix(static_cast<const M2&>(M), asImp(), C);
+      asImp() = std::move(C);
       return asImp();
     }
 
@@ -635,12 +639,8 @@ namespace Dune
       DUNE_ASSERT_BOUNDS(M.cols() == cols());
       MAT C(asImp());
 
-      for (size_type i=0; i<rows(); i++)
-        for (size_type j=0; j<cols(); j++) {
-          (*this)[i][j] = 0;
-          for (size_type k=0; k<cols(); k++)
-            (*this)[i][j] += C[i][k]*M[k][j];
-        }
+      DenseMatrixHelp::multMatrix(asImp(), static_cast<const M2&>(M), C);
+      asImp() = std::move(C);
       return asImp();
     }
 
@@ -943,7 +943,7 @@ namespace Dune
                         < FMatrixPrecision<>::absolute_limit()))
         DUNE_THROW(FMatrixError,"matrix is singular");
 #endif
-      detinv = 1.0/detinv;
+      detinv = field_type( 1 ) / detinv;
 
       x[0] = detinv*((*this)[1][1]*b[0]-(*this)[0][1]*b[1]);
       x[1] = detinv*((*this)[0][0]*b[1]-(*this)[1][0]*b[0]);
@@ -1069,10 +1069,10 @@ namespace Dune
       DenseMatrix<MAT>& U=A;
 
       // initialize inverse
-      *this=field_type();
+      *this=field_type(0);
 
       for(size_type i=0; i<rows(); ++i)
-        (*this)[i][i]=1;
+        (*this)[i][i]=field_type(1);
 
       // L Y = I; multiple right hand sides
       for (size_type i=0; i<rows(); i++)
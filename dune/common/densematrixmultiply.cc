@@ -0,0 +1,104 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+
+#include <dune/common/densematrixmultiply.hh>
+#include <dune/common/unused.hh>
+
+#if HAVE_BLAS
+
+#define DGEMM_FORTRAN FC_FUNC (dgemm, DGEMM)
+
+// dgemm declaration (in libblas)
+extern "C" {
+
+  /*
+   *
+   **  purpose
+   **  =======
+   **
+   **  xgemm performs the matrix-matrix operation
+   **
+   **     c := alpha*op( a )*op( b ) + beta*c,
+   **
+   **  where op( x ) is one of op( x ) = x or op( x ) = x**T, alpha and beta
+   **  are scalars, and a, b and c are matrices, with op( a ) an m by k
+   **  matrix, op( b ) a k by n matrix and c an m by n matrix.
+   **  All matrices are stored column-major.
+   **
+   **  arguments
+   **  =========
+   **
+   **  transa  (input) char
+   **          = 'n': op( a ) = a;
+   **          = 't': op( a ) = a**T.
+   **
+   **  transb  (input) char
+   **          = 'n': op( b ) = b;
+   **          = 't': op( b ) = b**T.
+   **
+   **  m, n, k (input) long int
+   **          the dimensions of the product, m, n, k >= 0.
+   **
+   **  a       (input) BASE DATA TYPE array, dimension (lda, ka)
+   **          ka is k when transa = 'n' and m otherwise.
+   **
+   **  lda     (input) long int
+   **          the leading dimension of the array a.
+   **
+   **  b       (input) BASE DATA TYPE array, dimension (ldb, kb)
+   **          kb is n when transb = 'n' and k otherwise.
+   **
+   **  ldb     (input) long int
+   **          the leading dimension of the array b.
+   **
+   **  c       (input/output) BASE DATA TYPE array, dimension (ldc, n)
+   **          on exit, c is overwritten by the m by n result.
+   **
+   **  ldc     (input) long int
+   **          the leading dimension of the array c.  ldc >= max(1,m).
+   **
+   **/
+  extern void DGEMM_FORTRAN(const char* transa, const char* transb,
+                            const long int* m, const long int* n, const long int* k,
+                            const double* alpha, const double* a, const long int* lda,
+                            const double* b, const long int* ldb,
+                            const double* beta, double* c, const long int* ldc);
+
+} // end extern C
+#endif
+
+namespace Dune {
+
+  namespace DenseMatrixHelp {
+
+    bool gemmBlasCall(
+      std::size_t m, std::size_t n, std::size_t k,
+      const double* a, std::size_t lda, const double* b, std::size_t ldb,
+      double* c, std::size_t ldc)
+    {
+#if HAVE_BLAS
+      // row-major C = A B is column-major C^T = B^T A^T
+      const char trans = 'n';
+      const long int M = n, N = m, K = k;
+      const long int ldbt = ldb, ldat = lda, ldct = ldc;
+      const double alpha = 1.0, beta = 0.0;
+      DGEMM_FORTRAN(&trans, &trans, &M, &N, &K, &alpha, b, &ldbt, a, &ldat,
+                    &beta, c, &ldct);
+      return true;
+#else
+      // silence unused variable warnings
+      DUNE_UNUSED_PARAMETER(m), DUNE_UNUSED_PARAMETER(n), DUNE_UNUSED_PARAMETER(k);
+      DUNE_UNUSED_PARAMETER(a), DUNE_UNUSED_PARAMETER(lda), DUNE_UNUSED_PARAMETER(b);
+      DUNE_UNUSED_PARAMETER(ldb), DUNE_UNUSED_PARAMETER(c), DUNE_UNUSED_PARAMETER(ldc);
+      return false;
+#endif
+    }
+
+  } // end namespace DenseMatrixHelp
+
+} // end namespace Dune
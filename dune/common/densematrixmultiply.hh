@@ -0,0 +1,307 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_DENSEMATRIXMULTIPLY_HH
+#define DUNE_DENSEMATRIXMULTIPLY_HH
+
+/** \file
+ * \brief Kernels for the product of two dense matrices
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/typetraits.hh>
+
+namespace Dune {
+
+  /**
+     @addtogroup DenseMatVec
+     @{
+   */
+
+  namespace DenseMatrixHelp {
+
+    // defined in densematrixmultiply.cc, computes the row-major product
+    // c = a*b by BLAS dgemm and returns true if dune-common was built
+    // with BLAS, returns false without touching c otherwise
+    extern bool gemmBlasCall(
+      std::size_t m, std::size_t n, std::size_t k,
+      const double* a, std::size_t lda, const double* b, std::size_t ldb,
+      double* c, std::size_t ldc);
+
+    /** \brief Blocking parameters of the matrix-matrix product kernel
+     *
+     * The product \f$C = A B\f$ is computed panel-wise: blocks of
+     * <code>mc × kc</code> entries of A and <code>kc × nc</code> entries of
+     * B are copied into contiguous buffers, and tiles of
+     * <code>mr × nr</code> entries of C are accumulated in local variables
+     * the compiler can keep in registers.
+     *
+     * \tparam K field type of the matrices
+     */
+    template<class K>
+    struct GemmBlocking
+    {
+      //! number of rows of a register tile
+      static constexpr std::size_t mr = 4;
+      //! number of columns of a register tile
+      static constexpr std::size_t nr = 4;
+      //! number of rows of the packed block of A
+      static constexpr std::size_t mc = 64;
+      //! number of columns of A (rows of B) in a packed block
+      static constexpr std::size_t kc = 256;
+      //! number of columns of the packed block of B
+      static constexpr std::size_t nc = 1024;
+      //! products with fewer multiply-adds use the plain triple loop
+      static constexpr std::size_t minBlockedSize = 16*16*16;
+      //! products with at least this many multiply-adds are passed to BLAS, if available
+      static constexpr std::size_t minBlasSize = 32*32*32;
+    };
+
+    template<class K> constexpr std::size_t GemmBlocking<K>::mr;
+    template<class K> constexpr std::size_t GemmBlocking<K>::nr;
+    template<class K> constexpr std::size_t GemmBlocking<K>::mc;
+    template<class K> constexpr std::size_t GemmBlocking<K>::kc;
+    template<class K> constexpr std::size_t GemmBlocking<K>::nc;
+    template<class K> constexpr std::size_t GemmBlocking<K>::minBlockedSize;
+    template<class K> constexpr std::size_t GemmBlocking<K>::minBlasSize;
+
+  } // end namespace DenseMatrixHelp
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // whether a matrix exposes row-major contiguous storage through
+    // data() and leadingDimension()
+    template<class M, class = void>
+    struct HasContiguousStorage
+      : public std::false_type
+    {};
+
+    template<class M>
+    struct HasContiguousStorage<M, void_t<decltype(std::declval<const M&>().data()),
+                                          decltype(std::declval<const M&>().leadingDimension())> >
+      : public std::true_type
+    {};
+
+    // c = a*b, with the plain triple loop
+    template<class K, class A, class B, class C>
+    void gemmNaive (std::size_t m, std::size_t n, std::size_t k,
+                    const A& a, const B& b, C& c)
+    {
+      for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+        {
+          c[i][j] = K(0);
+          for (std::size_t p = 0; p < k; ++p)
+            c[i][j] += a[i][p]*b[p][j];
+        }
+    }
+
+    // copy the block a[i0..i0+mb)[p0..p0+kb) into row panels of height mr,
+    // each panel stored column by column, padded with zeros
+    template<class K, class A>
+    void gemmPackA (const A& a, std::size_t i0, std::size_t mb,
+                    std::size_t p0, std::size_t kb, K* buffer)
+    {
+      constexpr std::size_t mr = DenseMatrixHelp::GemmBlocking<K>::mr;
+      for (std::size_t i = 0; i < mb; i += mr, buffer += mr*kb)
+        for (std::size_t ii = 0; ii < mr; ++ii)
+        {
+          if (i+ii < mb)
+            for (std::size_t p = 0; p < kb; ++p)
+              buffer[p*mr+ii] = a[i0+i+ii][p0+p];
+          else
+            for (std::size_t p = 0; p < kb; ++p)
+              buffer[p*mr+ii] = K(0);
+        }
+    }
+
+    // copy the block b[p0..p0+kb)[j0..j0+nb) into column panels of width nr,
+    // each panel stored row by row, padded with zeros
+    template<class K, class B>
+    void gemmPackB (const B& b, std::size_t p0, std::size_t kb,
+                    std::size_t j0, std::size_t nb, K* buffer)
+    {
+      constexpr std::size_t nr = DenseMatrixHelp::GemmBlocking<K>::nr;
+      for (std::size_t p = 0; p < kb; ++p)
+        for (std::size_t j = 0; j < nb; j += nr)
+        {
+          K* panel = buffer + j*kb + p*nr;
+          const std::size_t w = std::min(nr, nb-j);
+          for (std::size_t jj = 0; jj < w; ++jj)
+            panel[jj] = b[p0+p][j0+j+jj];
+          for (std::size_t jj = w; jj < nr; ++jj)
+            panel[jj] = K(0);
+        }
+    }
+
+    // tile = (packed row panel of a) * (packed column panel of b)
+    template<class K>
+    void gemmMicroKernel (std::size_t kb, const K* a, const K* b,
+                          K (&tile)[DenseMatrixHelp::GemmBlocking<K>::mr][DenseMatrixHelp::GemmBlocking<K>::nr])
+    {
+      constexpr std::size_t mr = DenseMatrixHelp::GemmBlocking<K>::mr;
+      constexpr std::size_t nr = DenseMatrixHelp::GemmBlocking<K>::nr;
+      for (std::size_t i = 0; i < mr; ++i)
+        for (std::size_t j = 0; j < nr; ++j)
+          tile[i][j] = K(0);
+      for (std::size_t p = 0; p < kb; ++p, a += mr, b += nr)
+        for (std::size_t i = 0; i < mr; ++i)
+          for (std::size_t j = 0; j < nr; ++j)
+            tile[i][j] += a[i]*b[j];
+    }
+
+    // the packed blocks of gemmBlocked, kept per thread, so that
+    // products of small matrices like a FieldMatrix do not allocate
+    // memory on every call
+    template<class K>
+    K* gemmPackBuffer (int which, std::size_t size)
+    {
+      thread_local std::vector<K> buffers[2];
+      std::vector<K>& buffer = buffers[which];
+      if (buffer.size() < size)
+        buffer.resize(size);
+      return buffer.data();
+    }
+
+    // c = a*b, cache-blocked with packing and register tiles
+    template<class K, class A, class B, class C>
+    void gemmBlocked (std::size_t m, std::size_t n, std::size_t k,
+                      const A& a, const B& b, C& c)
+    {
+      typedef DenseMatrixHelp::GemmBlocking<K> Blocking;
+      constexpr std::size_t mr = Blocking::mr;
+      constexpr std::size_t nr = Blocking::nr;
+      constexpr std::size_t mc = Blocking::mc;
+      constexpr std::size_t kc = Blocking::kc;
+      constexpr std::size_t nc = Blocking::nc;
+
+      for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+          c[i][j] = K(0);
+
+      const std::size_t kmax = std::min(kc, k);
+      K* packedA = gemmPackBuffer<K>(0, (std::min(mc, m)+mr-1)/mr*mr*kmax);
+      K* packedB = gemmPackBuffer<K>(1, (std::min(nc, n)+nr-1)/nr*nr*kmax);
+      K tile[mr][nr];
+
+      for (std::size_t jc = 0; jc < n; jc += nc)
+      {
+        const std::size_t nb = std::min(nc, n-jc);
+        for (std::size_t pc = 0; pc < k; pc += kc)
+        {
+          const std::size_t kb = std::min(kc, k-pc);
+          gemmPackB(b, pc, kb, jc, nb, packedB);
+          for (std::size_t ic = 0; ic < m; ic += mc)
+          {
+            const std::size_t mb = std::min(mc, m-ic);
+            gemmPackA(a, ic, mb, pc, kb, packedA);
+            for (std::size_t jr = 0; jr < nb; jr += nr)
+            {
+              const std::size_t w = std::min(nr, nb-jr);
+              for (std::size_t ir = 0; ir < mb; ir += mr)
+              {
+                const std::size_t h = std::min(mr, mb-ir);
+                gemmMicroKernel(kb, packedA + ir*kb, packedB + jr*kb, tile);
+                for (std::size_t ii = 0; ii < h; ++ii)
+                  for (std::size_t jj = 0; jj < w; ++jj)
+                    c[ic+ir+ii][jc+jr+jj] += tile[ii][jj];
+              }
+            }
+          }
+        }
+      }
+    }
+
+    // c = a*b through BLAS dgemm, returns whether BLAS was used
+    template<class A, class B, class C>
+    bool gemmBlas (std::size_t m, std::size_t n, std::size_t k,
+                   const A& a, const B& b, C& c, std::true_type)
+    {
+      if (m*n*k < DenseMatrixHelp::GemmBlocking<double>::minBlasSize)
+        return false;
+      return DenseMatrixHelp::gemmBlasCall(m, n, k,
+                                           a.data(), a.leadingDimension(),
+                                           b.data(), b.leadingDimension(),
+                                           c.data(), c.leadingDimension());
+    }
+
+    template<class A, class B, class C>
+    bool gemmBlas (std::size_t, std::size_t, std::size_t,
+                   const A&, const B&, C&, std::false_type)
+    {
+      return false;
+    }
+
+    // c = a*b, blocked for number types and by the triple loop otherwise
+    template<class K, class A, class B, class C>
+    void gemmGeneric (std::size_t m, std::size_t n, std::size_t k,
+                      const A& a, const B& b, C& c, std::true_type)
+    {
+      if (m*n*k >= DenseMatrixHelp::GemmBlocking<K>::minBlockedSize)
+        gemmBlocked<K>(m, n, k, a, b, c);
+      else
+        gemmNaive<K>(m, n, k, a, b, c);
+    }
+
+    template<class K, class A, class B, class C>
+    void gemmGeneric (std::size_t m, std::size_t n, std::size_t k,
+                      const A& a, const B& b, C& c, std::false_type)
+    {
+      gemmNaive<K>(m, n, k, a, b, c);
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  namespace DenseMatrixHelp {
+
+    /** \brief calculates c = a * b for dense matrices
+     *
+     * The algorithm is picked by the size of the product: small products
+     * use the plain triple loop, larger products of number types use a
+     * cache-blocked kernel.  If dune-common was built with BLAS, large
+     * products of double matrices with contiguous storage (see
+     * DynamicMatrix::data()) are computed by dgemm.
+     *
+     * \param[in]  a  left factor of size <code>m × k</code>
+     * \param[in]  b  right factor of size <code>k × n</code>
+     * \param[out] c  product of size <code>m × n</code>, must not alias a or b
+     */
+    template<class A, class B, class C>
+    void multMatrix (const A& a, const B& b, C& c)
+    {
+      typedef typename C::field_type K;
+      const std::size_t m = a.N();
+      const std::size_t n = b.M();
+      const std::size_t k = a.M();
+      assert(b.N() == k);
+      assert(c.N() == m && c.M() == n);
+
+      typedef std::integral_constant<bool,
+        std::is_same<typename A::field_type, double>::value
+        && std::is_same<typename B::field_type, double>::value
+        && std::is_same<K, double>::value
+        && Impl::HasContiguousStorage<A>::value
+        && Impl::HasContiguousStorage<B>::value
+        && Impl::HasContiguousStorage<C>::value> UseBlas;
+      typedef std::integral_constant<bool, IsNumber<K>::value> UseBlocked;
+
+      if (m == 0 || n == 0)
+        return;
+      if (!Impl::gemmBlas(m, n, k, a, b, c, UseBlas()))
+        Impl::gemmGeneric<K>(m, n, k, a, b, c, UseBlocked());
+    }
+
+  } // end namespace DenseMatrixHelp
+
+  /** @} end documentation */
+
+} // end namespace Dune
+
+#endif // DUNE_DENSEMATRIXMULTIPLY_HH
@@ -3,6 +3,7 @@
 #ifndef DUNE_DENSEVECTOR_HH
 #define DUNE_DENSEVECTOR_HH
 
+#include <functional>
 #include <limits>
 #include <type_traits>
 
@@ -12,11 +13,14 @@
 #include "promotiontraits.hh"
 #include "dotproduct.hh"
 #include "boundschecking.hh"
+#include "densevectorreduction.hh"
+#include "typetraits.hh"
 
 namespace Dune {
 
   // forward declaration of template
   template<typename V> class DenseVector;
+  template<class E> class DenseVectorExpression;
 
   template<typename V>
   struct FieldTraits< DenseVector<V> >
@@ -118,6 +122,30 @@ namespace Dune {
 
   }
 
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // Whether the binary arithmetic operators of the dense vector V build
+    // lazy expressions instead of temporaries.  Vectors with a dynamic size
+    // specialize this, FieldVector keeps returning its results by value.
+    template<class V>
+    struct DenseVectorUsesExpressions : std::false_type {};
+
+    // vector type an expression with leftmost operand V evaluates to
+    template<class V>
+    struct DenseVectorExpressionResult
+    {
+      typedef typename DenseVector<V>::derived_type type;
+    };
+
+    template<class E> struct DenseVectorExpressionTraits;
+    template<class V> class DenseVectorLeaf;
+    template<class L, class R, class Op> class DenseVectorBinaryExpression;
+    template<class E, class F> class DenseVectorMapExpression;
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
   /*! \brief Generic iterator class for dense vector and matrix implementations
 
      provides sequential access to DenseVector, FieldVector and FieldMatrix
@@ -298,6 +326,21 @@ namespace Dune {
       return *this;
     }
 
+    /** \brief Assignment from a vector expression
+     *
+     * The expression is evaluated entry by entry in a single loop.  Every
+     * entry of an expression only depends on the entries with the same
+     * index of its operands, hence this vector may appear in e.
+     */
+    template <class E>
+    derived_type& operator= (const DenseVectorExpression<E>& e)
+    {
+      DUNE_ASSERT_BOUNDS(e.size() == size());
+      for (size_type i=0; i<size(); i++)
+        asImp()[i] = e[i];
+      return asImp();
+    }
+
     //===== access to components
 
     //! random access
@@ -413,8 +456,29 @@ namespace Dune {
       return asImp();
     }
 
+    //! vector space addition of a vector expression
+    template <class E>
+    derived_type& operator+= (const DenseVectorExpression<E>& e)
+    {
+      DUNE_ASSERT_BOUNDS(e.size() == size());
+      for (size_type i=0; i<size(); i++)
+        (*this)[i] += e[i];
+      return asImp();
+    }
+
+    //! vector space subtraction of a vector expression
+    template <class E>
+    derived_type& operator-= (const DenseVectorExpression<E>& e)
+    {
+      DUNE_ASSERT_BOUNDS(e.size() == size());
+      for (size_type i=0; i<size(); i++)
+        (*this)[i] -= e[i];
+      return asImp();
+    }
+
     //! Binary vector addition
-    template <class Other>
+    template <class Other, class W = V,
+              std::enable_if_t<!Impl::DenseVectorUsesExpressions<W>::value, int> = 0>
     derived_type operator+ (const DenseVector<Other>& b) const
     {
       derived_type z = asImp();
@@ -422,13 +486,36 @@ namespace Dune {
     }
 
     //! Binary vector subtraction
-    template <class Other>
+    template <class Other, class W = V,
+              std::enable_if_t<!Impl::DenseVectorUsesExpressions<W>::value, int> = 0>
     derived_type operator- (const DenseVector<Other>& b) const
     {
       derived_type z = asImp();
       return (z-=b);
     }
 
+    /** \brief Binary vector addition for vectors with dynamic size
+     *
+     * No temporary vector is created, the result is a DenseVectorExpression
+     * that is evaluated when it is assigned or converted to a vector.
+     */
+    template <class Other, class W = V,
+              std::enable_if_t<Impl::DenseVectorUsesExpressions<W>::value, int> = 0>
+    Impl::DenseVectorBinaryExpression<Impl::DenseVectorLeaf<V>, Impl::DenseVectorLeaf<Other>, std::plus<> >
+    operator+ (const DenseVector<Other>& b) const
+    {
+      return { Impl::DenseVectorLeaf<V>(*this), Impl::DenseVectorLeaf<Other>(b) };
+    }
+
+    //! Binary vector subtraction for vectors with dynamic size, see operator+()
+    template <class Other, class W = V,
+              std::enable_if_t<Impl::DenseVectorUsesExpressions<W>::value, int> = 0>
+    Impl::DenseVectorBinaryExpression<Impl::DenseVectorLeaf<V>, Impl::DenseVectorLeaf<Other>, std::minus<> >
+    operator- (const DenseVector<Other>& b) const
+    {
+      return { Impl::DenseVectorLeaf<V>(*this), Impl::DenseVectorLeaf<Other>(b) };
+    }
+
     //! \brief vector space add scalar to all comps
     /**
        we use enable_if to avoid an ambiguity, if the
@@ -556,13 +643,8 @@ namespace Dune {
      */
     template<class Other>
     typename PromotionTraits<field_type,typename DenseVector<Other>::field_type>::PromotedType operator* (const DenseVector<Other>& y) const {
-      typedef typename PromotionTraits<field_type, typename DenseVector<Other>::field_type>::PromotedType PromotedType;
-      PromotedType result(0);
       assert(y.size() == size());
-      for (size_type i=0; i<size(); i++) {
-        result += PromotedType((*this)[i]*y[i]);
-      }
-      return result;
+      return product(y, BlockedWith<Other>());
     }
 
     /**
@@ -574,7 +656,14 @@ namespace Dune {
      */
     template<class Other>
     typename PromotionTraits<field_type,typename DenseVector<Other>::field_type>::PromotedType dot(const DenseVector<Other>& y) const {
-      typedef typename PromotionTraits<field_type, typename DenseVector<Other>::field_type>::PromotedType PromotedType;
+      assert(y.size() == size());
+      return dotProduct(y, BlockedWith<Other>());
+    }
+
+    //! vector dot product \f$\left (x^H \cdot y \right)\f$ with a vector expression
+    template<class E>
+    typename PromotionTraits<field_type,typename DenseVectorExpression<E>::field_type>::PromotedType dot(const DenseVectorExpression<E>& y) const {
+      typedef typename PromotionTraits<field_type, typename DenseVectorExpression<E>::field_type>::PromotedType PromotedType;
       PromotedType result(0);
       assert(y.size() == size());
       for (size_type i=0; i<size(); i++) {
@@ -587,39 +676,30 @@ namespace Dune {
 
     //! one norm (sum over absolute values of entries)
     typename FieldTraits<value_type>::real_type one_norm() const {
-      using std::abs;
-      typename FieldTraits<value_type>::real_type result( 0 );
-      for (size_type i=0; i<size(); i++)
-        result += abs((*this)[i]);
-      return result;
+      return oneNorm(HasContiguousData<V>());
     }
 
 
     //! simplified one norm (uses Manhattan norm for complex values)
     typename FieldTraits<value_type>::real_type one_norm_real () const
     {
-      typename FieldTraits<value_type>::real_type result( 0 );
-      for (size_type i=0; i<size(); i++)
-        result += fvmeta::absreal((*this)[i]);
-      return result;
+      return oneNormReal(HasContiguousData<V>());
     }
 
-    //! two norm sqrt(sum over squared values of entries)
+    /** \brief two norm sqrt(sum over squared values of entries)
+     *
+     * For contiguous float and double entries, the result does not overflow
+     * or underflow unless the norm itself does.
+     */
     typename FieldTraits<value_type>::real_type two_norm () const
     {
-      typename FieldTraits<value_type>::real_type result( 0 );
-      for (size_type i=0; i<size(); i++)
-        result += fvmeta::abs2((*this)[i]);
-      return fvmeta::sqrt(result);
+      return twoNorm(HasContiguousData<V>());
     }
 
     //! square of two norm (sum over squared values of entries), need for block recursion
     typename FieldTraits<value_type>::real_type two_norm2 () const
     {
-      typename FieldTraits<value_type>::real_type result( 0 );
-      for (size_type i=0; i<size(); i++)
-        result += fvmeta::abs2((*this)[i]);
-      return result;
+      return twoNorm2(HasContiguousData<V>());
     }
 
     //! infinity norm (maximum of absolute values of entries)
@@ -657,7 +737,140 @@ namespace Dune {
     template <typename vt = value_type,
               typename std::enable_if<HasNaN<vt>::value, int>::type = 0>
     typename FieldTraits<vt>::real_type infinity_norm() const {
-      using real_type = typename FieldTraits<vt>::real_type;
+      return infinityNorm(HasContiguousData<V>());
+    }
+
+    //! simplified infinity norm (uses Manhattan norm for complex values)
+    template <typename vt = value_type,
+              typename std::enable_if<HasNaN<vt>::value, int>::type = 0>
+    typename FieldTraits<vt>::real_type infinity_norm_real() const {
+      return infinityNormReal(HasContiguousData<V>());
+    }
+
+    //===== sizes
+
+    //! number of blocks in the vector (are of size 1 here)
+    size_type N () const
+    {
+      return size();
+    }
+
+    //! dimension of the vector space
+    size_type dim () const
+    {
+      return size();
+    }
+
+  private:
+    // Reductions over contiguous float or double entries use the kernels
+    // of densevectorreduction.hh, all other vectors use the loops below.
+    template <class W>
+    using HasContiguousData = Impl::DenseVectorHasContiguousData<typename DenseVector<W>::derived_type>;
+
+    template <class Other>
+    using BlockedWith = Impl::DenseVectorHasContiguousData<derived_type, typename DenseVector<Other>::derived_type>;
+
+    template <class Other>
+    typename PromotionTraits<field_type,typename DenseVector<Other>::field_type>::PromotedType
+    product (const DenseVector<Other>& y, std::false_type) const
+    {
+      typedef typename PromotionTraits<field_type, typename DenseVector<Other>::field_type>::PromotedType PromotedType;
+      PromotedType result(0);
+      for (size_type i=0; i<size(); i++) {
+        result += PromotedType((*this)[i]*y[i]);
+      }
+      return result;
+    }
+
+    template <class Other>
+    value_type product (const DenseVector<Other>& y, std::true_type) const
+    {
+      typedef typename DenseVector<Other>::derived_type OtherImp;
+      return Impl::blockedDot(asImp().data(), static_cast<const OtherImp&>(y).data(), size());
+    }
+
+    template <class Other>
+    typename PromotionTraits<field_type,typename DenseVector<Other>::field_type>::PromotedType
+    dotProduct (const DenseVector<Other>& y, std::false_type) const
+    {
+      typedef typename PromotionTraits<field_type, typename DenseVector<Other>::field_type>::PromotedType PromotedType;
+      PromotedType result(0);
+      for (size_type i=0; i<size(); i++) {
+        result += Dune::dot((*this)[i],y[i]);
+      }
+      return result;
+    }
+
+    // for real entries, dot() and operator* agree
+    template <class Other>
+    typename PromotionTraits<field_type,typename DenseVector<Other>::field_type>::PromotedType
+    dotProduct (const DenseVector<Other>& y, std::true_type) const
+    {
+      return product(y, std::true_type());
+    }
+
+    typename FieldTraits<value_type>::real_type oneNorm (std::false_type) const
+    {
+      using std::abs;
+      typename FieldTraits<value_type>::real_type result( 0 );
+      for (size_type i=0; i<size(); i++)
+        result += abs((*this)[i]);
+      return result;
+    }
+
+    value_type oneNorm (std::true_type) const
+    {
+      return Impl::blockedOneNorm(asImp().data(), size());
+    }
+
+    typename FieldTraits<value_type>::real_type oneNormReal (std::false_type) const
+    {
+      typename FieldTraits<value_type>::real_type result( 0 );
+      for (size_type i=0; i<size(); i++)
+        result += fvmeta::absreal((*this)[i]);
+      return result;
+    }
+
+    value_type oneNormReal (std::true_type) const
+    {
+      return Impl::blockedOneNorm(asImp().data(), size());
+    }
+
+    typename FieldTraits<value_type>::real_type twoNorm (std::false_type) const
+    {
+      return fvmeta::sqrt(twoNorm2(std::false_type()));
+    }
+
+    value_type twoNorm (std::true_type) const
+    {
+      return Impl::blockedTwoNorm(asImp().data(), size());
+    }
+
+    typename FieldTraits<value_type>::real_type twoNorm2 (std::false_type) const
+    {
+      typename FieldTraits<value_type>::real_type result( 0 );
+      for (size_type i=0; i<size(); i++)
+        result += fvmeta::abs2((*this)[i]);
+      return result;
+    }
+
+    value_type twoNorm2 (std::true_type) const
+    {
+      return Impl::blockedTwoNorm2(asImp().data(), size());
+    }
+
+    value_type infinityNorm (std::true_type) const
+    {
+      return Impl::blockedMaxAbs(asImp().data(), size());
+    }
+
+    value_type infinityNormReal (std::true_type) const
+    {
+      return Impl::blockedMaxAbs(asImp().data(), size());
+    }
+
+    typename FieldTraits<value_type>::real_type infinityNorm (std::false_type) const {
+      using real_type = typename FieldTraits<value_type>::real_type;
       using std::abs;
       using std::max;
 
@@ -671,11 +884,8 @@ namespace Dune {
       return norm * (isNaN / isNaN);
     }
 
-    //! simplified infinity norm (uses Manhattan norm for complex values)
-    template <typename vt = value_type,
-              typename std::enable_if<HasNaN<vt>::value, int>::type = 0>
-    typename FieldTraits<vt>::real_type infinity_norm_real() const {
-      using real_type = typename FieldTraits<vt>::real_type;
+    typename FieldTraits<value_type>::real_type infinityNormReal (std::false_type) const {
+      using real_type = typename FieldTraits<value_type>::real_type;
       using std::max;
 
       real_type norm = 0;
@@ -687,10 +897,119 @@ namespace Dune {
       }
       return norm * (isNaN / isNaN);
     }
+  };
 
-    //===== sizes
+  /** \brief Write a DenseVector to an output stream
+   *  \relates DenseVector
+   *
+   *  \param[in]  s  std :: ostream to write to
+   *  \param[in]  v  DenseVector to write
+   *
+   *  \returns the output stream (s)
+   */
+  template<typename V>
+  std::ostream& operator<< (std::ostream& s, const DenseVector<V>& v)
+  {
+    for (typename DenseVector<V>::size_type i=0; i<v.size(); i++)
+      s << ((i>0) ? " " : "") << v[i];
+    return s;
+  }
 
-    //! number of blocks in the vector (are of size 1 here)
+#ifndef DOXYGEN
+  namespace Impl {
+
+    template<class V>
+    struct DenseVectorExpressionTraits< DenseVectorLeaf<V> >
+    {
+      typedef typename DenseVector<V>::value_type value_type;
+      typedef typename DenseVector<V>::size_type size_type;
+      typedef typename DenseVectorExpressionResult<V>::type result_type;
+    };
+
+    template<class L, class R, class Op>
+    struct DenseVectorExpressionTraits< DenseVectorBinaryExpression<L,R,Op> >
+    {
+      typedef std::decay_t<decltype(std::declval<Op>()(std::declval<typename L::value_type>(),
+                                                       std::declval<typename R::value_type>()))> value_type;
+      typedef typename L::size_type size_type;
+      typedef typename L::result_type result_type;
+    };
+
+    template<class E, class F>
+    struct DenseVectorExpressionTraits< DenseVectorMapExpression<E,F> >
+    {
+      typedef std::decay_t<decltype(std::declval<const F&>()(std::declval<typename E::value_type>()))> value_type;
+      typedef typename E::size_type size_type;
+      typedef typename E::result_type result_type;
+    };
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  /** \brief Interface for lazily evaluated arithmetic expressions of dense vectors
+   *
+   * Sums, differences, negations and scalar multiples of vectors with a
+   * dynamic size (e.g. DynamicVector) do not compute their result
+   * immediately.  Instead, they return an expression object that computes
+   * its entries on demand, so that an assignment like
+   * @code
+   * x = y + a*z - w;
+   * @endcode
+   * is evaluated in a single loop without any temporary vector.  Arithmetic
+   * of FieldVector is not affected, its operators still return vectors.
+   *
+   * An expression is evaluated when it is assigned to a vector, added to or
+   * subtracted from a vector or converted to its result_type.  Entry i of an
+   * expression only depends on the entries i of its operands, so the vector
+   * that is assigned to may appear in the expression itself.
+   *
+   * \note Expressions store references to their vector operands.  They
+   *       should not be kept beyond the full expression they are created in,
+   *       in particular <code>auto x = y + z;</code> does not create a vector.
+   *
+   * \tparam E implementation class of the expression
+   */
+  template<class E>
+  class DenseVectorExpression
+  {
+    typedef Impl::DenseVectorExpressionTraits<E> Traits;
+
+    // Curiously recurring template pattern
+    const E & asImp () const { return static_cast<const E&>(*this); }
+
+  protected:
+    // construction allowed to derived classes only
+    DenseVectorExpression () = default;
+
+  public:
+    //! type of the entries of the expression
+    typedef typename Traits::value_type value_type;
+
+    //! export the type representing the field
+    typedef typename FieldTraits<value_type>::field_type field_type;
+
+    //! export the type representing the real type of the field
+    typedef typename FieldTraits<value_type>::real_type real_type;
+
+    //! The type used for the index access and size operation
+    typedef typename Traits::size_type size_type;
+
+    //! vector type the expression evaluates to
+    typedef typename Traits::result_type result_type;
+
+    //! compute entry i of the expression
+    value_type operator[] (size_type i) const
+    {
+      return asImp()[i];
+    }
+
+    //! size method
+    size_type size () const
+    {
+      return asImp().size();
+    }
+
+    //! number of blocks in the expression (are of size 1 here)
     size_type N () const
     {
       return size();
@@ -702,24 +1021,365 @@ namespace Dune {
       return size();
     }
 
+    //! evaluate the expression into a new vector
+    operator result_type () const
+    {
+      return result_type(*this);
+    }
+
+    //! indefinite dot product with a vector or another expression
+    template<class Other>
+    typename PromotionTraits<field_type, typename Other::field_type>::PromotedType
+    operator* (const Other& y) const
+    {
+      typedef typename PromotionTraits<field_type, typename Other::field_type>::PromotedType PromotedType;
+      PromotedType result(0);
+      assert(y.size() == size());
+      for (size_type i=0; i<size(); i++)
+        result += PromotedType((*this)[i]*y[i]);
+      return result;
+    }
+
+    //! dot product with a vector or another expression, see DenseVector::dot()
+    template<class Other>
+    typename PromotionTraits<field_type, typename Other::field_type>::PromotedType
+    dot (const Other& y) const
+    {
+      typedef typename PromotionTraits<field_type, typename Other::field_type>::PromotedType PromotedType;
+      PromotedType result(0);
+      assert(y.size() == size());
+      for (size_type i=0; i<size(); i++)
+        result += Dune::dot((*this)[i],y[i]);
+      return result;
+    }
+
+    //===== norms, evaluated without creating the result vector
+
+    //! one norm (sum over absolute values of entries)
+    real_type one_norm () const
+    {
+      using std::abs;
+      real_type result( 0 );
+      for (size_type i=0; i<size(); i++)
+        result += abs((*this)[i]);
+      return result;
+    }
+
+    //! simplified one norm (uses Manhattan norm for complex values)
+    real_type one_norm_real () const
+    {
+      real_type result( 0 );
+      for (size_type i=0; i<size(); i++)
+        result += fvmeta::absreal((*this)[i]);
+      return result;
+    }
+
+    //! two norm sqrt(sum over squared values of entries)
+    real_type two_norm () const
+    {
+      return fvmeta::sqrt(two_norm2());
+    }
+
+    //! square of two norm (sum over squared values of entries)
+    real_type two_norm2 () const
+    {
+      real_type result( 0 );
+      for (size_type i=0; i<size(); i++)
+        result += fvmeta::abs2((*this)[i]);
+      return result;
+    }
+
+    //! infinity norm (maximum of absolute values of entries)
+    real_type infinity_norm () const
+    {
+      using std::abs;
+      using std::max;
+      real_type norm = 0;
+      real_type isNaN = 1;
+      for (size_type i=0; i<size(); i++)
+      {
+        real_type const a = abs((*this)[i]);
+        norm = max(a, norm);
+        isNaN += a;
+      }
+      return propagateNaN(norm, isNaN);
+    }
+
+    //! simplified infinity norm (uses Manhattan norm for complex values)
+    real_type infinity_norm_real () const
+    {
+      using std::max;
+      real_type norm = 0;
+      real_type isNaN = 1;
+      for (size_type i=0; i<size(); i++)
+      {
+        real_type const a = fvmeta::absreal((*this)[i]);
+        norm = max(a, norm);
+        isNaN += a;
+      }
+      return propagateNaN(norm, isNaN);
+    }
+
+  private:
+    // std::max ignores NaN entries, the sum of all entries does not
+    template <typename vt = value_type,
+              typename std::enable_if<HasNaN<vt>::value, int>::type = 0>
+    static real_type propagateNaN (const real_type& norm, const real_type& isNaN)
+    {
+      return norm * (isNaN / isNaN);
+    }
+
+    template <typename vt = value_type,
+              typename std::enable_if<!HasNaN<vt>::value, int>::type = 0>
+    static real_type propagateNaN (const real_type& norm, const real_type&)
+    {
+      return norm;
+    }
   };
 
-  /** \brief Write a DenseVector to an output stream
-   *  \relates DenseVector
-   *
-   *  \param[in]  s  std :: ostream to write to
-   *  \param[in]  v  DenseVector to write
-   *
-   *  \returns the output stream (s)
+  /** \brief Write a vector expression to an output stream
+   *  \relates DenseVectorExpression
    */
-  template<typename V>
-  std::ostream& operator<< (std::ostream& s, const DenseVector<V>& v)
+  template<class E>
+  std::ostream& operator<< (std::ostream& s, const DenseVectorExpression<E>& e)
   {
-    for (typename DenseVector<V>::size_type i=0; i<v.size(); i++)
-      s << ((i>0) ? " " : "") << v[i];
+    for (typename DenseVectorExpression<E>::size_type i=0; i<e.size(); i++)
+      s << ((i>0) ? " " : "") << e[i];
     return s;
   }
 
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // a vector operand of an expression, stored by reference
+    template<class V>
+    class DenseVectorLeaf
+      : public DenseVectorExpression< DenseVectorLeaf<V> >
+    {
+      typedef DenseVectorExpression< DenseVectorLeaf<V> > Base;
+
+    public:
+      typedef typename Base::size_type size_type;
+
+      explicit DenseVectorLeaf (const DenseVector<V>& v)
+        : v_(v)
+      {}
+
+      const typename Base::value_type& operator[] (size_type i) const { return v_[i]; }
+      size_type size () const { return v_.size(); }
+
+    private:
+      const DenseVector<V>& v_;
+    };
+
+    // entrywise operation on two expressions, stored by value
+    template<class L, class R, class Op>
+    class DenseVectorBinaryExpression
+      : public DenseVectorExpression< DenseVectorBinaryExpression<L,R,Op> >
+    {
+      typedef DenseVectorExpression< DenseVectorBinaryExpression<L,R,Op> > Base;
+
+    public:
+      typedef typename Base::size_type size_type;
+      typedef typename Base::value_type value_type;
+
+      DenseVectorBinaryExpression (const L& l, const R& r)
+        : l_(l), r_(r)
+      {
+        DUNE_ASSERT_BOUNDS(l.size() == r.size());
+      }
+
+      value_type operator[] (size_type i) const { return Op()(l_[i], r_[i]); }
+      size_type size () const { return l_.size(); }
+
+    private:
+      L l_;
+      R r_;
+    };
+
+    // entrywise function of an expression, e.g. scaling or negation
+    template<class E, class F>
+    class DenseVectorMapExpression
+      : public DenseVectorExpression< DenseVectorMapExpression<E,F> >
+    {
+      typedef DenseVectorExpression< DenseVectorMapExpression<E,F> > Base;
+
+    public:
+      typedef typename Base::size_type size_type;
+      typedef typename Base::value_type value_type;
+
+      DenseVectorMapExpression (const E& e, const F& f)
+        : e_(e), f_(f)
+      {}
+
+      value_type operator[] (size_type i) const { return f_(e_[i]); }
+      size_type size () const { return e_.size(); }
+
+    private:
+      E e_;
+      F f_;
+    };
+
+    template<class K>
+    struct DenseVectorScaleFromLeft
+    {
+      template<class T>
+      auto operator() (const T& x) const { return k*x; }
+      K k;
+    };
+
+    template<class K>
+    struct DenseVectorDivideBy
+    {
+      template<class T>
+      auto operator() (const T& x) const { return x/k; }
+      K k;
+    };
+
+    template<class V>
+    DenseVectorLeaf<V> asDenseVectorExpression (const DenseVector<V>& v)
+    {
+      return DenseVectorLeaf<V>(v);
+    }
+
+    template<class E>
+    const E& asDenseVectorExpression (const DenseVectorExpression<E>& e)
+    {
+      return static_cast<const E&>(e);
+    }
+
+    template<class Op, class A, class B>
+    auto denseVectorBinary (const A& a, const B& b)
+    {
+      typedef std::decay_t<decltype(asDenseVectorExpression(a))> L;
+      typedef std::decay_t<decltype(asDenseVectorExpression(b))> R;
+      return DenseVectorBinaryExpression<L,R,Op>(asDenseVectorExpression(a), asDenseVectorExpression(b));
+    }
+
+    template<class A, class F>
+    auto denseVectorMap (const A& a, const F& f)
+    {
+      typedef std::decay_t<decltype(asDenseVectorExpression(a))> E;
+      return DenseVectorMapExpression<E,F>(asDenseVectorExpression(a), f);
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  //! \brief sum of two vector expressions \relates DenseVectorExpression
+  template<class L, class R>
+  auto operator+ (const DenseVectorExpression<L>& a, const DenseVectorExpression<R>& b)
+  {
+    return Impl::denseVectorBinary<std::plus<> >(a, b);
+  }
+
+  //! \brief sum of a vector expression and a vector \relates DenseVectorExpression
+  template<class L, class V>
+  auto operator+ (const DenseVectorExpression<L>& a, const DenseVector<V>& b)
+  {
+    return Impl::denseVectorBinary<std::plus<> >(a, b);
+  }
+
+  //! \brief sum of a vector and a vector expression \relates DenseVectorExpression
+  template<class V, class R,
+           std::enable_if_t<Impl::DenseVectorUsesExpressions<V>::value, int> = 0>
+  auto operator+ (const DenseVector<V>& a, const DenseVectorExpression<R>& b)
+  {
+    return Impl::denseVectorBinary<std::plus<> >(a, b);
+  }
+
+  //! \brief difference of two vector expressions \relates DenseVectorExpression
+  template<class L, class R>
+  auto operator- (const DenseVectorExpression<L>& a, const DenseVectorExpression<R>& b)
+  {
+    return Impl::denseVectorBinary<std::minus<> >(a, b);
+  }
+
+  //! \brief difference of a vector expression and a vector \relates DenseVectorExpression
+  template<class L, class V>
+  auto operator- (const DenseVectorExpression<L>& a, const DenseVector<V>& b)
+  {
+    return Impl::denseVectorBinary<std::minus<> >(a, b);
+  }
+
+  //! \brief difference of a vector and a vector expression \relates DenseVectorExpression
+  template<class V, class R,
+           std::enable_if_t<Impl::DenseVectorUsesExpressions<V>::value, int> = 0>
+  auto operator- (const DenseVector<V>& a, const DenseVectorExpression<R>& b)
+  {
+    return Impl::denseVectorBinary<std::minus<> >(a, b);
+  }
+
+  //! \brief negation of a vector expression \relates DenseVectorExpression
+  template<class E>
+  auto operator- (const DenseVectorExpression<E>& a)
+  {
+    return Impl::denseVectorMap(a, std::negate<>());
+  }
+
+  //! \brief negation of a vector with dynamic size \relates DenseVectorExpression
+  template<class V,
+           std::enable_if_t<Impl::DenseVectorUsesExpressions<V>::value, int> = 0>
+  auto operator- (const DenseVector<V>& a)
+  {
+    return Impl::denseVectorMap(a, std::negate<>());
+  }
+
+  //! \brief multiplication of a vector expression by a scalar \relates DenseVectorExpression
+  template<class K, class E,
+           std::enable_if_t<IsNumber<K>::value, int> = 0>
+  auto operator* (const K& k, const DenseVectorExpression<E>& a)
+  {
+    return Impl::denseVectorMap(a, Impl::DenseVectorScaleFromLeft<K>{k});
+  }
+
+  //! \brief multiplication of a vector expression by a scalar \relates DenseVectorExpression
+  template<class E, class K,
+           std::enable_if_t<IsNumber<K>::value, int> = 0>
+  auto operator* (const DenseVectorExpression<E>& a, const K& k)
+  {
+    return Impl::denseVectorMap(a, Impl::DenseVectorScaleFromLeft<K>{k});
+  }
+
+  //! \brief division of a vector expression by a scalar \relates DenseVectorExpression
+  template<class E, class K,
+           std::enable_if_t<IsNumber<K>::value, int> = 0>
+  auto operator/ (const DenseVectorExpression<E>& a, const K& k)
+  {
+    return Impl::denseVectorMap(a, Impl::DenseVectorDivideBy<K>{k});
+  }
+
+  //! \brief multiplication of a vector with dynamic size by a scalar \relates DenseVectorExpression
+  template<class K, class V,
+           std::enable_if_t<IsNumber<K>::value && Impl::DenseVectorUsesExpressions<V>::value, int> = 0>
+  auto operator* (const K& k, const DenseVector<V>& a)
+  {
+    return Impl::denseVectorMap(a, Impl::DenseVectorScaleFromLeft<K>{k});
+  }
+
+  //! \brief multiplication of a vector with dynamic size by a scalar \relates DenseVectorExpression
+  template<class V, class K,
+           std::enable_if_t<IsNumber<K>::value && Impl::DenseVectorUsesExpressions<V>::value, int> = 0>
+  auto operator* (const DenseVector<V>& a, const K& k)
+  {
+    return Impl::denseVectorMap(a, Impl::DenseVectorScaleFromLeft<K>{k});
+  }
+
+  //! \brief division of a vector with dynamic size by a scalar \relates DenseVectorExpression
+  template<class V, class K,
+           std::enable_if_t<IsNumber<K>::value && Impl::DenseVectorUsesExpressions<V>::value, int> = 0>
+  auto operator/ (const DenseVector<V>& a, const K& k)
+  {
+    return Impl::denseVectorMap(a, Impl::DenseVectorDivideBy<K>{k});
+  }
+
+  //! \brief indefinite dot product of a vector and a vector expression \relates DenseVectorExpression
+  template<class V, class E>
+  auto operator* (const DenseVector<V>& a, const DenseVectorExpression<E>& b)
+  {
+    return b * a;
+  }
+
   /** @} end documentation */
 
 } // end namespace
@@ -0,0 +1,192 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_DENSEVECTORREDUCTION_HH
+#define DUNE_DENSEVECTORREDUCTION_HH
+
+/** \file
+ * \brief Kernels for the norms and dot products of contiguous dense vectors
+ *
+ * DenseVector uses these kernels for implementations that store their
+ * entries contiguously and provide access to them through a member
+ * function <code>data()</code>, if the entries are of type float or double
+ * (e.g. DynamicVector).  Instead of a single accumulator, the kernels
+ * keep DenseVectorReduction::blockSize independent partial results, one
+ * for every index modulo the block size, so that the compiler can keep
+ * them in SIMD registers and does not have to wait for the previous
+ * addition to finish.  The partial results are combined pairwise at the
+ * end.
+ *
+ * The summation order only depends on the size of the vector, not on the
+ * alignment of the data.  Equal vectors therefore give bitwise identical
+ * results on every process of a parallel program that runs the same
+ * binary.  This does not extend to builds with different compilers or
+ * flags: the compiler may contract a multiplication and an addition into
+ * a fused multiply-add (e.g. with <code>-ffp-contract=fast</code> or
+ * <code>-march=native</code>), which rounds differently, and it may
+ * reassociate the operations (e.g. with <code>-ffast-math</code>).
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/typetraits.hh>
+
+namespace Dune {
+
+  /**
+     @addtogroup DenseMatVec
+     @{
+   */
+
+  namespace DenseVectorReduction {
+
+    //! number of independent partial results kept by the reduction kernels
+    static constexpr std::size_t blockSize = 8;
+
+  } // end namespace DenseVectorReduction
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // whether V provides contiguous float or double entries through data()
+    template<class V, class = void>
+    struct DenseVectorHasContiguousDataImpl : std::false_type {};
+
+    template<class V>
+    struct DenseVectorHasContiguousDataImpl<V, void_t<decltype(std::declval<const V&>().data())> >
+      : std::integral_constant<bool,
+          (std::is_same<typename V::value_type, double>::value
+           || std::is_same<typename V::value_type, float>::value)
+          && std::is_same<decltype(std::declval<const V&>().data()),
+                          const typename V::value_type*>::value>
+    {};
+
+    // whether V and W both have contiguous entries of the same type, must
+    // not be used before V and W are complete
+    template<class V, class W = V>
+    struct DenseVectorHasContiguousData
+      : std::integral_constant<bool,
+          DenseVectorHasContiguousDataImpl<V>::value
+          && DenseVectorHasContiguousDataImpl<W>::value
+          && std::is_same<typename V::value_type, typename W::value_type>::value>
+    {};
+
+    // The kernels below are written out instead of being expressed by a
+    // common function taking the summand as a functor: with the functor,
+    // gcc vectorizes across consecutive blocks instead of within a block
+    // and the reduction becomes slower than the plain loop.
+
+    // combine the partial results pairwise
+    template<class K>
+    K combineBlock (K (&acc)[DenseVectorReduction::blockSize])
+    {
+      for (std::size_t w = DenseVectorReduction::blockSize/2; w > 0; w /= 2)
+        for (std::size_t l = 0; l < w; ++l)
+          acc[l] += acc[l+w];
+      return acc[0];
+    }
+
+    template<class K>
+    K blockedOneNorm (const K* x, std::size_t n)
+    {
+      using std::abs;
+      constexpr std::size_t B = DenseVectorReduction::blockSize;
+      K acc[B] = {};
+      const K* end = x + (n - n%B);
+      for (; x != end; x += B)
+        for (std::size_t l = 0; l < B; ++l)
+          acc[l] += abs(x[l]);
+      for (std::size_t l = 0; l < n%B; ++l)
+        acc[l] += abs(x[l]);
+      return combineBlock(acc);
+    }
+
+    template<class K>
+    K blockedTwoNorm2 (const K* x, std::size_t n)
+    {
+      constexpr std::size_t B = DenseVectorReduction::blockSize;
+      K acc[B] = {};
+      const K* end = x + (n - n%B);
+      for (; x != end; x += B)
+        for (std::size_t l = 0; l < B; ++l)
+          acc[l] += x[l]*x[l];
+      for (std::size_t l = 0; l < n%B; ++l)
+        acc[l] += x[l]*x[l];
+      return combineBlock(acc);
+    }
+
+    template<class K>
+    K blockedDot (const K* x, const K* y, std::size_t n)
+    {
+      constexpr std::size_t B = DenseVectorReduction::blockSize;
+      K acc[B] = {};
+      const K* end = x + (n - n%B);
+      for (; x != end; x += B, y += B)
+        for (std::size_t l = 0; l < B; ++l)
+          acc[l] += x[l]*y[l];
+      for (std::size_t l = 0; l < n%B; ++l)
+        acc[l] += x[l]*y[l];
+      return combineBlock(acc);
+    }
+
+    // maximum of |x_i|, NaN if any entry is NaN
+    template<class K>
+    K blockedMaxAbs (const K* x, std::size_t n)
+    {
+      using std::abs;
+      constexpr std::size_t B = DenseVectorReduction::blockSize;
+      // a NaN in a partial result is never replaced
+      auto update = [](K& m, const K& a) { m = (a > m || a != a) ? a : m; };
+      K acc[B] = {};
+      const K* end = x + (n - n%B);
+      for (; x != end; x += B)
+        for (std::size_t l = 0; l < B; ++l)
+          update(acc[l], abs(x[l]));
+      for (std::size_t l = 0; l < n%B; ++l)
+        update(acc[l], abs(x[l]));
+      for (std::size_t w = B/2; w > 0; w /= 2)
+        for (std::size_t l = 0; l < w; ++l)
+          update(acc[l], acc[l+w]);
+      return acc[0];
+    }
+
+    // Euclidean norm that neither overflows nor loses accuracy by underflow.
+    // The sum of squares is only recomputed with scaled entries if it is
+    // not a normalized finite number.
+    template<class K>
+    K blockedTwoNorm (const K* x, std::size_t n)
+    {
+      using std::sqrt;
+      const K s = blockedTwoNorm2(x, n);
+      if (s >= std::numeric_limits<K>::min() && s <= std::numeric_limits<K>::max())
+        return sqrt(s);
+
+      // zero, infinite or NaN entries determine the result directly
+      const K scale = blockedMaxAbs(x, n);
+      if (!(scale > K(0)) || !(scale <= std::numeric_limits<K>::max()))
+        return scale;
+
+      // divide instead of multiplying by the reciprocal, which overflows
+      // for subnormal scales
+      constexpr std::size_t B = DenseVectorReduction::blockSize;
+      K acc[B] = {};
+      const K* end = x + (n - n%B);
+      for (; x != end; x += B)
+        for (std::size_t l = 0; l < B; ++l)
+          acc[l] += (x[l]/scale)*(x[l]/scale);
+      for (std::size_t l = 0; l < n%B; ++l)
+        acc[l] += (x[l]/scale)*(x[l]/scale);
+      return scale * sqrt(combineBlock(acc));
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  /** @} end documentation */
+
+} // end namespace Dune
+
+#endif // DUNE_DENSEVECTORREDUCTION_HH
@@ -3,10 +3,13 @@
 #ifndef DUNE_DYNMATRIX_HH
 #define DUNE_DYNMATRIX_HH
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <iostream>
 #include <initializer_list>
+#include <utility>
+#include <vector>
 
 #include <dune/common/boundschecking.hh>
 #include <dune/common/exceptions.hh>
@@ -27,13 +30,146 @@ namespace Dune
    */
 
   template< class K > class DynamicMatrix;
+  template< class K > class DynamicMatrixRow;
+
+  template< class K >
+  struct DenseMatVecTraits< DynamicMatrixRow<K> >
+  {
+    typedef DynamicMatrixRow<K> derived_type;
+    typedef K* container_type;
+    typedef K value_type;
+    typedef typename std::vector<K>::size_type size_type;
+  };
+
+  template< class K >
+  struct FieldTraits< DynamicMatrixRow<K> >
+  {
+    typedef typename FieldTraits<K>::field_type field_type;
+    typedef typename FieldTraits<K>::real_type real_type;
+  };
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // arithmetic of matrix rows builds expressions which evaluate to a
+    // DynamicVector, see DenseVectorExpression
+    template< class K >
+    struct DenseVectorUsesExpressions< DynamicMatrixRow<K> >
+      : std::true_type
+    {};
+
+    template< class K >
+    struct DenseVectorExpressionResult< DynamicMatrixRow<K> >
+    {
+      typedef DynamicVector<K> type;
+    };
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  /** \brief Row proxy of a DynamicMatrix
+   *
+   * The rows handed out by a DynamicMatrix do not own their entries, they
+   * refer to one row of the contiguous storage of the matrix.  Such a proxy
+   * is invalidated when the matrix is resized or destroyed.  Assignment
+   * copies the entries into the row, which keeps its size.  Copy and move
+   * construction from a row of a matrix, e.g. <code>auto r = A[i];</code>,
+   * and construction from a size create an independent row owning its
+   * entries, like a DynamicVector.  Hence <code>std::swap(A[i], A[j])</code>
+   * swaps the entries of the rows.
+   *
+   * \tparam K is the field type (use float, double, complex, etc)
+   */
+  template< class K >
+  class DynamicMatrixRow : public DenseVector< DynamicMatrixRow<K> >
+  {
+    typedef DenseVector< DynamicMatrixRow<K> > Base;
+
+    template< class > friend class DynamicMatrix;
+
+  public:
+    typedef typename Base::size_type size_type;
+    typedef typename Base::value_type value_type;
+
+    //! Constructor referring to <code>n</code> entries starting at <code>data</code>
+    DynamicMatrixRow (K *data, size_type n)
+      : _data(data), _size(n)
+    {}
+
+    //! Constructor of an independent row of <code>n</code> entries <code>c</code>
+    explicit DynamicMatrixRow (size_type n, value_type c = value_type())
+      : _storage(n, c), _data(_storage.data()), _size(n)
+    {}
+
+    //! Copy constructor, creates an independent row owning a copy of the entries
+    DynamicMatrixRow (const DynamicMatrixRow &other)
+      : Base(), _storage(other._data, other._data + other._size),
+        _data(_storage.data()), _size(other._size)
+    {}
+
+    //! Move constructor, takes over the entries of an independent row and copies those of a proxy
+    DynamicMatrixRow (DynamicMatrixRow &&other)
+      : Base(),
+        _storage(other._storage.empty()
+                 ? std::vector<K>(other._data, other._data + other._size)
+                 : std::move(other._storage)),
+        _data(_storage.data()), _size(other._size)
+    {}
+
+    using Base::operator=;
+
+    /** \brief Copy assignment, copies the entries of the other row
+     *
+     * \throw RangeError if the rows differ in size, as the size of a row
+     *        of a matrix cannot change
+     */
+    DynamicMatrixRow &operator= (const DynamicMatrixRow &other)
+    {
+      if (other.size() != size())
+        DUNE_THROW(RangeError, "Cannot assign a row of size " << other.size()
+                   << " to a row of size " << size());
+      std::copy(other._data, other._data + _size, _data);
+      return *this;
+    }
+
+    //==== make this thing a vector
+    size_type size () const { return _size; }
+    K & operator[] (size_type i) {
+      DUNE_ASSERT_BOUNDS(i < size());
+      return _data[i];
+    }
+    const K & operator[] (size_type i) const {
+      DUNE_ASSERT_BOUNDS(i < size());
+      return _data[i];
+    }
+
+    //! pointer to the first entry of the row
+    K *data () { return _data; }
+    const K *data () const { return _data; }
+
+  private:
+    // the entries of an independent row, empty for a proxy
+    std::vector<K> _storage;
+    K *_data;
+    size_type _size;
+  };
+
+  /** \brief Swap the entries of two rows
+   *  \relates DynamicMatrixRow
+   */
+  template< class K >
+  inline void swap (DynamicMatrixRow<K> &a, DynamicMatrixRow<K> &b)
+  {
+    DUNE_ASSERT_BOUNDS(a.size() == b.size());
+    std::swap_ranges(a.data(), a.data() + a.size(), b.data());
+  }
 
   template< class K >
   struct DenseMatVecTraits< DynamicMatrix<K> >
   {
     typedef DynamicMatrix<K> derived_type;
 
-    typedef DynamicVector<K> row_type;
+    typedef DynamicMatrixRow<K> row_type;
 
     typedef row_type &row_reference;
     typedef const row_type &const_row_reference;
@@ -51,13 +187,17 @@ namespace Dune
   };
 
   /** \brief Construct a matrix with a dynamic size.
+   *
+   * The entries are stored row-wise in a single contiguous buffer, the
+   * entry <code>(i,j)</code> is found at <code>data()[i*leadingDimension()+j]</code>.
+   * Rows are accessed through DynamicMatrixRow proxies referring into that
+   * buffer.
    *
    * \tparam K is the field type (use float, double, complex, etc)
    */
   template<class K>
   class DynamicMatrix : public DenseMatrix< DynamicMatrix<K> >
   {
-    std::vector< DynamicVector<K> > _data;
     typedef DenseMatrix< DynamicMatrix<K> > Base;
   public:
     typedef typename Base::size_type size_type;
@@ -66,36 +206,75 @@ namespace Dune
 
     //===== constructors
     //! \brief Default constructor
-    DynamicMatrix () {}
+    DynamicMatrix () : _cols(0) {}
 
     //! \brief Constructor initializing the whole matrix with a scalar
     DynamicMatrix (size_type r, size_type c, value_type v = value_type() ) :
-      _data(r, row_type(c, v) )
-    {}
+      _cols(0)
+    {
+      resize(r, c, v);
+    }
 
     /** \brief Constructor initializing the matrix from a list of vector
      */
-    DynamicMatrix (std::initializer_list<DynamicVector<K>> const &ll)
-      : _data(ll)
-    {}
+    DynamicMatrix (std::initializer_list<DynamicVector<K>> const &ll) :
+      _cols(0)
+    {
+      resize(ll.size(), ll.size() ? ll.begin()->size() : 0);
+      size_type i = 0;
+      for (const auto &row : ll)
+      {
+        DUNE_ASSERT_BOUNDS(row.size() == _cols);
+        std::copy(row.begin(), row.end(), _data.begin() + i*_cols);
+        ++i;
+      }
+    }
 
 
     template <class T,
               typename = std::enable_if_t<!Dune::IsNumber<T>::value && HasDenseMatrixAssigner<DynamicMatrix, T>::value>>
-    DynamicMatrix(T const& rhs)
+    DynamicMatrix(T const& rhs) :
+      _cols(0)
     {
       *this = rhs;
     }
 
+    //! \brief Copy constructor
+    DynamicMatrix (const DynamicMatrix &other) :
+      Base(), _data(other._data), _cols(other._cols)
+    {
+      setupRows(other.rows());
+    }
+
+    //! \brief Move constructor, the row proxies stay valid as the buffer is taken over
+    DynamicMatrix (DynamicMatrix &&other) = default;
+
+    //! \brief Copy assignment operator
+    DynamicMatrix &operator= (const DynamicMatrix &other)
+    {
+      if (this != &other)
+      {
+        _data = other._data;
+        _cols = other._cols;
+        setupRows(other.rows());
+      }
+      return *this;
+    }
+
+    //! \brief Move assignment operator
+    DynamicMatrix &operator= (DynamicMatrix &&other) = default;
+
     //==== resize related methods
     /**
      * \brief resize matrix to <code>r × c</code>
      *
      * Resize the matrix to <code>r × c</code>, using <code>v</code>
-     * as the value of all entries.
+     * as the value of all entries.  No memory is allocated if the new
+     * matrix does not have more entries than the matrix had before.
      *
      * \warning All previous entries are lost, even when the matrix
      *          was not actually resized.
+     * \warning All row proxies obtained before are invalidated.
      *
      * \param r number of rows
      * \param c number of columns
@@ -103,8 +282,9 @@ namespace Dune
      */
     void resize (size_type r, size_type c, value_type v = value_type() )
     {
-      _data.resize(0);
-      _data.resize(r, row_type(c, v) );
+      _data.assign(r*c, v);
+      _cols = c;
+      setupRows(r);
     }
 
     //===== assignment
@@ -112,8 +292,7 @@ namespace Dune
     template <typename T,
               typename = std::enable_if_t<!Dune::IsNumber<T>::value>>
     DynamicMatrix& operator=(T const& rhs) {
-      _data.resize(rhs.N());
-      std::fill(_data.begin(), _data.end(), row_type(rhs.M(), K(0)));
+      resize(rhs.N(), rhs.M(), K(0));
       Base::operator=(rhs);
       return *this;
     }
@@ -126,20 +305,43 @@ namespace Dune
       return *this;
     }
 
+    //===== direct access to the storage
+
+    //! pointer to the contiguous row-major storage
+    K *data () { return _data.data(); }
+    const K *data () const { return _data.data(); }
+
+    //! distance between the first entries of two consecutive rows in data()
+    size_type leadingDimension () const { return _cols; }
+
     // make this thing a matrix
-    size_type mat_rows() const { return _data.size(); }
+    size_type mat_rows() const { return _rows.size(); }
     size_type mat_cols() const {
       assert(this->rows());
-      return _data.front().size();
+      return _cols;
     }
     row_type & mat_access(size_type i) {
-      DUNE_ASSERT_BOUNDS(i < _data.size());
-      return _data[i];
+      DUNE_ASSERT_BOUNDS(i < _rows.size());
+      return _rows[i];
     }
     const row_type & mat_access(size_type i) const {
-      DUNE_ASSERT_BOUNDS(i < _data.size());
-      return _data[i];
+      DUNE_ASSERT_BOUNDS(i < _rows.size());
+      return _rows[i];
     }
+
+  private:
+    // (re-)create the row proxies, reusing the capacity of _rows
+    void setupRows (size_type r)
+    {
+      _rows.clear();
+      _rows.reserve(r);
+      for (size_type i = 0; i < r; ++i)
+        _rows.emplace_back(_data.data() + i*_cols, _cols);
+    }
+
+    std::vector<K> _data;
+    std::vector<row_type> _rows;
+    size_type _cols;
   };
 
   /** @} end documentation */
@@ -19,6 +19,9 @@
 // nonsymmetric matrices
 #define DGEEV_FORTRAN FC_FUNC (dgeev, DGEEV)
 
+// symmetric matrices, relatively robust representations
+#define DSYEVR_FORTRAN FC_FUNC (dsyevr, DSYEVR)
+
 // dsyev declaration (in liblapack)
 extern "C" {
 
@@ -127,6 +130,109 @@ extern "C" {
                             const long int* ldvl, double* vr, const long int* ldvr, double* work,
                             const long int* lwork, const long int* info);
 
+  /*
+   *
+   **  purpose
+   **  =======
+   **
+   **  xsyevr computes selected eigenvalues and, optionally, eigenvectors
+   **  of a BASE DATA TYPE symmetric matrix a.  eigenvalues and
+   **  eigenvectors can be selected by specifying either a range of values
+   **  or a range of indices for the desired eigenvalues.
+   **
+   **  arguments
+   **  =========
+   **
+   **  jobz    (input) char
+   **          = 'n':  compute eigenvalues only;
+   **          = 'v':  compute eigenvalues and eigenvectors.
+   **
+   **  range   (input) char
+   **          = 'a': all eigenvalues will be found.
+   **          = 'v': all eigenvalues in the half-open interval (vl,vu]
+   **                 will be found.
+   **          = 'i': the il-th through iu-th eigenvalues will be found.
+   **
+   **  uplo    (input) char
+   **          = 'u':  upper triangle of a is stored;
+   **          = 'l':  lower triangle of a is stored.
+   **
+   **  n       (input) long int
+   **          the order of the matrix a.  n >= 0.
+   **
+   **  a       (input/output) BASE DATA TYPE array, dimension (lda, n)
+   **          on entry, the symmetric matrix a.  on exit, the triangle
+   **          selected by uplo, including the diagonal, is destroyed.
+   **
+   **  lda     (input) long int
+   **          the leading dimension of the array a.  lda >= max(1,n).
+   **
+   **  vl, vu  (input) BASE DATA TYPE
+   **          if range='v', the lower and upper bounds of the interval to
+   **          be searched for eigenvalues.  not referenced otherwise.
+   **
+   **  il, iu  (input) long int
+   **          if range='i', the indices (in ascending order, starting at
+   **          1) of the smallest and largest eigenvalues to be returned.
+   **          not referenced otherwise.
+   **
+   **  abstol  (input) BASE DATA TYPE
+   **          the absolute error tolerance for the eigenvalues, a value
+   **          <= 0 selects a default based on the machine precision.
+   **
+   **  m       (output) long int
+   **          the total number of eigenvalues found.
+   **
+   **  w       (output) BASE DATA TYPE array, dimension (n)
+   **          the first m elements contain the selected eigenvalues in
+   **          ascending order.
+   **
+   **  z       (output) BASE DATA TYPE array, dimension (ldz, max(1,m))
+   **          if jobz = 'v', the first m columns of z contain the
+   **          orthonormal eigenvectors of a corresponding to the selected
+   **          eigenvalues.  if jobz = 'n', z is not referenced.
+   **
+   **  ldz     (input) long int
+   **          the leading dimension of the array z.  ldz >= 1, and if
+   **          jobz = 'v', ldz >= max(1,n).
+   **
+   **  isuppz  (output) long int array, dimension ( 2*max(1,m) )
+   **          the support of the eigenvectors in z.
+   **
+   **  work    (workspace/output) BASE DATA TYPE array, dimension (max(1,lwork))
+   **          on exit, if info = 0, work(1) returns the optimal lwork.
+   **
+   **  lwork   (input) long int
+   **          the dimension of the array work.  lwork >= max(1,26*n).
+   **          if lwork = -1, then a workspace query is assumed; the routine
+   **          only calculates the optimal sizes of the work and iwork
+   **          arrays and returns these values as the first entries of
+   **          work and iwork.
+   **
+   **  iwork   (workspace/output) long int array, dimension (max(1,liwork))
+   **          on exit, if info = 0, iwork(1) returns the optimal liwork.
+   **
+   **  liwork  (input) long int
+   **          the dimension of the array iwork.  liwork >= max(1,10*n).
+   **          if liwork = -1, then a workspace query is assumed, see lwork.
+   **
+   **  info    (output) long int
+   **          = 0:  successful exit
+   **          < 0:  if info = -i, the i-th argument had an illegal value.
+   **          > 0:  internal error
+   **
+   **/
+
+  extern void DSYEVR_FORTRAN(const char* jobz, const char* range, const char* uplo,
+                             const long int* n, double* a, const long int* lda,
+                             const double* vl, const double* vu,
+                             const long int* il, const long int* iu,
+                             const double* abstol, long int* m, double* w,
+                             double* z, const long int* ldz, long int* isuppz,
+                             double* work, const long int* lwork,
+                             long int* iwork, const long int* liwork,
+                             long int* info);
+
 } // end extern C
 #endif
 
@@ -154,6 +260,32 @@ namespace Dune {
 #endif
     }
 
+    void eigenValuesSymLapackCall(
+      const char* jobz, const char* range, const char* uplo,
+      const long int* n, double* a, const long int* lda,
+      const double* vl, const double* vu, const long int* il,
+      const long int* iu, const double* abstol, long int* m, double* w,
+      double* z, const long int* ldz, long int* isuppz, double* work,
+      const long int* lwork, long int* iwork, const long int* liwork,
+      long int* info)
+    {
+#if HAVE_LAPACK
+      // call LAPACK dsyevr
+      DSYEVR_FORTRAN(jobz, range, uplo, n, a, lda, vl, vu, il, iu, abstol,
+                     m, w, z, ldz, isuppz, work, lwork, iwork, liwork, info);
+#else
+      // silence unused variable warnings
+      DUNE_UNUSED_PARAMETER(jobz), DUNE_UNUSED_PARAMETER(range), DUNE_UNUSED_PARAMETER(uplo);
+      DUNE_UNUSED_PARAMETER(n), DUNE_UNUSED_PARAMETER(a), DUNE_UNUSED_PARAMETER(lda);
+      DUNE_UNUSED_PARAMETER(vl), DUNE_UNUSED_PARAMETER(vu), DUNE_UNUSED_PARAMETER(il);
+      DUNE_UNUSED_PARAMETER(iu), DUNE_UNUSED_PARAMETER(abstol), DUNE_UNUSED_PARAMETER(m);
+      DUNE_UNUSED_PARAMETER(w), DUNE_UNUSED_PARAMETER(z), DUNE_UNUSED_PARAMETER(ldz);
+      DUNE_UNUSED_PARAMETER(isuppz), DUNE_UNUSED_PARAMETER(work), DUNE_UNUSED_PARAMETER(lwork);
+      DUNE_UNUSED_PARAMETER(iwork), DUNE_UNUSED_PARAMETER(liwork), DUNE_UNUSED_PARAMETER(info);
+      DUNE_THROW(NotImplemented,"eigenValuesSymLapackCall: LAPACK not found!");
+#endif
+    }
+
   } // end namespace FMatrixHelp
 
 } // end namespace Dune
@@ -3,8 +3,13 @@
 #ifndef DUNE_DYNMATRIXEIGENVALUES_HH
 #define DUNE_DYNMATRIXEIGENVALUES_HH
 
+#include <algorithm>
+#include <complex>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/std/memory.hh>
 
 #include "dynmatrix.hh"
@@ -21,67 +26,358 @@ namespace Dune {
 
   namespace DynamicMatrixHelp {
 
-    // defined in fmatrixev_ext.cpp
+    // defined in dynmatrixev.cc
     extern void eigenValuesNonsymLapackCall(
       const char* jobvl, const char* jobvr, const long
       int* n, double* a, const long int* lda, double* wr, double* wi, double* vl,
       const long int* ldvl, double* vr, const long int* ldvr, double* work,
       const long int* lwork, const long int* info);
 
-    /** \brief calculates the eigenvalues of a symmetric field matrix
-        \param[in]  matrix matrix eigenvalues are calculated for
-        \param[out] eigenValues FieldVector that contains eigenvalues in
-                    ascending order
+    // defined in dynmatrixev.cc
+    extern void eigenValuesSymLapackCall(
+      const char* jobz, const char* range, const char* uplo,
+      const long int* n, double* a, const long int* lda,
+      const double* vl, const double* vu, const long int* il,
+      const long int* iu, const double* abstol, long int* m, double* w,
+      double* z, const long int* ldz, long int* isuppz, double* work,
+      const long int* lwork, long int* iwork, const long int* liwork,
+      long int* info);
+
+    /** \brief Reusable eigenvalue solver for symmetric dynamic matrices
+
+        Computes all or selected eigenvalues, and optionally the
+        eigenvectors, of a symmetric matrix with LAPACK::dsyevr.  The
+        optimal workspace size is queried once per matrix size, and all
+        buffers are kept between calls, so repeated computations on matrices
+        of the same size do not allocate memory.
+
+        The row-wise storage of a DynamicMatrix is passed to LAPACK as a
+        column-major matrix, i.e. as the transpose of the matrix, which is
+        the matrix itself in the symmetric case.  For the same reason the
+        eigenvectors are written by LAPACK directly into the storage of the
+        result matrix, one eigenvector per row.
 
-        \note LAPACK::dgeev is used to calculate the eigen values
+        \note Only the upper triangle of the matrix is referenced.
      */
-    template <typename K, class C>
-    static void eigenValuesNonSym(const DynamicMatrix<K>& matrix,
-                                  DynamicVector<C>& eigenValues)
+    class SymmetricEigenSolver
     {
+    public:
+      /** \brief calculates all eigenvalues
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[out] eigenValues eigenvalues in ascending order
+       */
+      template <typename K>
+      void eigenValues(const DynamicMatrix<K>& matrix,
+                       DynamicVector<double>& eigenValues)
       {
-        const long int N = matrix.rows();
-        const char jobvl = 'n';
-        const char jobvr = 'n';
+        compute(matrix, 'n', 'a', 0.0, 0.0, 0, 0, eigenValues, nullptr);
+      }
+
+      /** \brief calculates all eigenvalues and eigenvectors
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[out] eigenValues eigenvalues in ascending order
+          \param[out] eigenVectors matrix whose i-th row is the normalized
+                      eigenvector of eigenValues[i]
+       */
+      template <typename K>
+      void eigenValuesVectors(const DynamicMatrix<K>& matrix,
+                              DynamicVector<double>& eigenValues,
+                              DynamicMatrix<double>& eigenVectors)
+      {
+        compute(matrix, 'v', 'a', 0.0, 0.0, 0, 0, eigenValues, &eigenVectors);
+      }
+
+      /** \brief calculates the eigenvalues in the interval (lower, upper]
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[in]  lower lower bound of the interval, exclusive
+          \param[in]  upper upper bound of the interval, inclusive
+          \param[out] eigenValues eigenvalues in ascending order
+       */
+      template <typename K>
+      void eigenValuesInInterval(const DynamicMatrix<K>& matrix,
+                                 double lower, double upper,
+                                 DynamicVector<double>& eigenValues)
+      {
+        compute(matrix, 'n', 'v', lower, upper, 0, 0, eigenValues, nullptr);
+      }
+
+      /** \brief calculates the eigenvalues in the interval (lower, upper] and their eigenvectors
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[in]  lower lower bound of the interval, exclusive
+          \param[in]  upper upper bound of the interval, inclusive
+          \param[out] eigenValues eigenvalues in ascending order
+          \param[out] eigenVectors matrix whose i-th row is the normalized
+                      eigenvector of eigenValues[i]
+       */
+      template <typename K>
+      void eigenValuesVectorsInInterval(const DynamicMatrix<K>& matrix,
+                                        double lower, double upper,
+                                        DynamicVector<double>& eigenValues,
+                                        DynamicMatrix<double>& eigenVectors)
+      {
+        compute(matrix, 'v', 'v', lower, upper, 0, 0, eigenValues, &eigenVectors);
+      }
+
+      /** \brief calculates the eigenvalues with indices first, ..., last-1
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[in]  first index of the smallest eigenvalue, counting from 0
+                      in ascending order
+          \param[in]  last index past the largest eigenvalue
+          \param[out] eigenValues eigenvalues in ascending order
+       */
+      template <typename K>
+      void eigenValuesByIndex(const DynamicMatrix<K>& matrix,
+                              std::size_t first, std::size_t last,
+                              DynamicVector<double>& eigenValues)
+      {
+        compute(matrix, 'n', 'i', 0.0, 0.0, first, last, eigenValues, nullptr);
+      }
+
+      /** \brief calculates the eigenvalues with indices first, ..., last-1 and their eigenvectors
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[in]  first index of the smallest eigenvalue, counting from 0
+                      in ascending order
+          \param[in]  last index past the largest eigenvalue
+          \param[out] eigenValues eigenvalues in ascending order
+          \param[out] eigenVectors matrix whose i-th row is the normalized
+                      eigenvector of eigenValues[i]
+       */
+      template <typename K>
+      void eigenValuesVectorsByIndex(const DynamicMatrix<K>& matrix,
+                                     std::size_t first, std::size_t last,
+                                     DynamicVector<double>& eigenValues,
+                                     DynamicMatrix<double>& eigenVectors)
+      {
+        compute(matrix, 'v', 'i', 0.0, 0.0, first, last, eigenValues, &eigenVectors);
+      }
 
+    private:
+      template <typename K>
+      void compute(const DynamicMatrix<K>& matrix, char jobz, char range,
+                   double lower, double upper, std::size_t first, std::size_t last,
+                   DynamicVector<double>& eigenValues,
+                   DynamicMatrix<double>* eigenVectors)
+      {
+        if (matrix.N() != matrix.M())
+          DUNE_THROW(InvalidStateException, "eigenValues: matrix is not square!");
+        const long int n = matrix.N();
+        if (range == 'i' && (first > last || last > matrix.N()))
+          DUNE_THROW(RangeError, "eigenValues: invalid index range ["
+                     << first << "," << last << ") for a matrix of size " << n);
 
-        // matrix to put into dgeev
-        std::unique_ptr<double[]> matrixVector = Std::make_unique<double[]>(N*N);
+        // the row-wise storage of matrix is its column-major transpose
+        a_.resize(n*n);
+        std::copy(matrix.data(), matrix.data() + n*n, a_.begin());
+        w_.resize(n);
+        if (n != querySize_)
+          queryWorkspace(n);
 
-        // copy matrix
-        int row = 0;
-        for(int i=0; i<N; ++i)
+        long int m = 0;
+        if (n > 0 && (range != 'i' || first < last))
         {
-          for(int j=0; j<N; ++j, ++row)
+          // eigenvectors go straight into the result if their number is known
+          double* z = nullptr;
+          const bool direct = (eigenVectors && range != 'v');
+          if (direct)
+          {
+            const std::size_t rows = (range == 'a') ? n : last - first;
+            if (eigenVectors->N() != rows || eigenVectors->M() != std::size_t(n))
+              eigenVectors->resize(rows, n);
+            z = eigenVectors->data();
+          }
+          else if (eigenVectors)
+          {
+            z_.resize(n*n);
+            z = z_.data();
+          }
+
+          const char uplo = 'l'; // the upper triangle of the row-wise storage
+          const long int il = first + 1, iu = last;
+          const double abstol = 0.0;
+          const long int lwork = work_.size(), liwork = iwork_.size();
+          long int info = 0;
+          eigenValuesSymLapackCall(&jobz, &range, &uplo, &n, a_.data(), &n,
+                                   &lower, &upper, &il, &iu, &abstol, &m,
+                                   w_.data(), z, &n, isuppz_.data(),
+                                   work_.data(), &lwork, iwork_.data(), &liwork,
+                                   &info);
+          if (info != 0)
+            DUNE_THROW(InvalidStateException, "eigenValues: Eigenvalue calculation failed with info = " << info << "!");
+
+          if (eigenVectors && !direct)
           {
-            matrixVector[ row ] = matrix[ i ][ j ];
+            eigenVectors->resize(m, n);
+            std::copy(z_.begin(), z_.begin() + m*n, eigenVectors->data());
           }
         }
+        else if (eigenVectors)
+          eigenVectors->resize(0, n);
 
-        // working memory
-        std::unique_ptr<double[]> eigenR = Std::make_unique<double[]>(N);
-        std::unique_ptr<double[]> eigenI = Std::make_unique<double[]>(N);
-        std::unique_ptr<double[]> work = Std::make_unique<double[]>(3*N);
+        eigenValues.resize(m);
+        std::copy(w_.begin(), w_.begin() + m, eigenValues.begin());
+      }
 
-        // return value information
-        long int info = 0;
-        long int lwork = 3*N;
+      void queryWorkspace(long int n)
+      {
+        const char jobz = 'v', range = 'a', uplo = 'l';
+        const long int one = 1, query = -1, ld = std::max(n, 1l);
+        const double zero = 0.0;
+        long int m = 0, info = 0;
+        double optimalWork = 0.0;
+        long int optimalIWork = 0;
+        isuppz_.resize(2*ld);
+        if (n > 0)
+          eigenValuesSymLapackCall(&jobz, &range, &uplo, &n, a_.data(), &ld,
+                                   &zero, &zero, &one, &n, &zero, &m,
+                                   w_.data(), nullptr, &ld, isuppz_.data(),
+                                   &optimalWork, &query, &optimalIWork, &query,
+                                   &info);
+        if (info != 0)
+          DUNE_THROW(InvalidStateException, "eigenValues: Workspace query failed with info = " << info << "!");
+        work_.resize(std::max(long(optimalWork), std::max(26*n, 1l)));
+        iwork_.resize(std::max(optimalIWork, std::max(10*n, 1l)));
+        querySize_ = n;
+      }
+
+      std::vector<double> a_, w_, z_, work_;
+      std::vector<long int> iwork_, isuppz_;
+      long int querySize_ = -1;
+    };
 
-        // call LAPACK routine (see fmatrixev_ext.cc)
-        eigenValuesNonsymLapackCall(&jobvl, &jobvr, &N, &matrixVector[0], &N,
-                                    &eigenR[0], &eigenI[0], 0, &N, 0, &N, &work[0],
-                                    &lwork, &info);
+    /** \brief Reusable eigenvalue solver for general dynamic matrices
+
+        Computes the eigenvalues, and optionally the right eigenvectors, of a
+        square matrix with LAPACK::dgeev.  The optimal workspace size is
+        queried once per matrix size, and all buffers are kept between
+        calls, so repeated computations on matrices of the same size do not
+        allocate memory.
+
+        The row-wise storage of a DynamicMatrix is passed to LAPACK as a
+        column-major matrix without reordering, i.e. LAPACK works on the
+        transpose \f$A^T\f$.  It has the same eigenvalues as \f$A\f$, and
+        the conjugated left eigenvectors of \f$A^T\f$ are the right
+        eigenvectors of \f$A\f$.
+     */
+    class NonSymmetricEigenSolver
+    {
+    public:
+      /** \brief calculates the eigenvalues
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[out] eigenValues eigenvalues, complex conjugate pairs
+                      appear consecutively with positive imaginary part first
+       */
+      template <typename K, class C>
+      void eigenValues(const DynamicMatrix<K>& matrix,
+                       DynamicVector<C>& eigenValues)
+      {
+        compute(matrix, false);
+        eigenValues.resize(wr_.size());
+        for (std::size_t i=0; i<wr_.size(); ++i)
+          eigenValues[i] = std::complex<double>(wr_[i], wi_[i]);
+      }
 
-        if( info != 0 )
+      /** \brief calculates the eigenvalues and right eigenvectors
+          \param[in]  matrix square matrix eigenvalues are calculated for
+          \param[out] eigenValues eigenvalues, complex conjugate pairs
+                      appear consecutively with positive imaginary part first
+          \param[out] eigenVectors matrix whose i-th row is the right
+                      eigenvector of eigenValues[i], normalized to
+                      euclidean norm 1
+       */
+      template <typename K, class C>
+      void eigenValuesVectors(const DynamicMatrix<K>& matrix,
+                              DynamicVector<C>& eigenValues,
+                              DynamicMatrix<C>& eigenVectors)
+      {
+        compute(matrix, true);
+        const std::size_t n = wr_.size();
+        eigenValues.resize(n);
+        if (eigenVectors.N() != n || eigenVectors.M() != n)
+          eigenVectors.resize(n, n);
+        for (std::size_t i=0; i<n; ++i)
         {
-          std::cerr << "For matrix " << matrix << " eigenvalue calculation failed! " << std::endl;
-          DUNE_THROW(InvalidStateException,"eigenValues: Eigenvalue calculation failed!");
+          eigenValues[i] = std::complex<double>(wr_[i], wi_[i]);
+          // row i of the row-wise view of vl is the i-th left eigenvector of A^T
+          const double* re = vl_.data() + i*n;
+          if (wi_[i] == 0.0)
+            for (std::size_t j=0; j<n; ++j)
+              eigenVectors[i][j] = std::complex<double>(re[j], 0.0);
+          else
+          {
+            const double* im = re + n;
+            for (std::size_t j=0; j<n; ++j)
+            {
+              eigenVectors[i][j] = std::complex<double>(re[j], -im[j]);
+              eigenVectors[i+1][j] = std::complex<double>(re[j], im[j]);
+            }
+            eigenValues[i+1] = std::complex<double>(wr_[i+1], wi_[i+1]);
+            ++i;
+          }
         }
+      }
 
-        eigenValues.resize(N);
-        for (int i=0; i<N; ++i)
-          eigenValues[i] = std::complex<double>(eigenR[i], eigenI[i]);
+    private:
+      template <typename K>
+      void compute(const DynamicMatrix<K>& matrix, bool vectors)
+      {
+        if (matrix.N() != matrix.M())
+          DUNE_THROW(InvalidStateException, "eigenValues: matrix is not square!");
+        const long int n = matrix.N();
+        const long int ld = std::max(n, 1l);
+        const char jobvl = vectors ? 'v' : 'n';
+        const char jobvr = 'n';
+
+        // the row-wise storage of matrix is its column-major transpose
+        a_.resize(n*n);
+        std::copy(matrix.data(), matrix.data() + n*n, a_.begin());
+        wr_.resize(n);
+        wi_.resize(n);
+        if (vectors)
+          vl_.resize(n*n);
+        if (n == 0)
+          return;
+
+        long int info = 0;
+        if (n != querySize_ || vectors != queryVectors_)
+        {
+          const long int query = -1;
+          double optimalWork = 0.0;
+          eigenValuesNonsymLapackCall(&jobvl, &jobvr, &n, a_.data(), &ld,
+                                      wr_.data(), wi_.data(), vl_.data(), &ld,
+                                      nullptr, &ld, &optimalWork, &query, &info);
+          if (info != 0)
+            DUNE_THROW(InvalidStateException, "eigenValues: Workspace query failed with info = " << info << "!");
+          work_.resize(std::max(long(optimalWork), (vectors ? 4 : 3)*n));
+          querySize_ = n;
+          queryVectors_ = vectors;
+        }
+
+        const long int lwork = work_.size();
+        eigenValuesNonsymLapackCall(&jobvl, &jobvr, &n, a_.data(), &ld,
+                                    wr_.data(), wi_.data(), vl_.data(), &ld,
+                                    nullptr, &ld, work_.data(), &lwork, &info);
+        if (info != 0)
+          DUNE_THROW(InvalidStateException, "eigenValues: Eigenvalue calculation failed with info = " << info << "!");
       }
+
+      std::vector<double> a_, wr_, wi_, vl_, work_;
+      long int querySize_ = -1;
+      bool queryVectors_ = false;
+    };
+
+    /** \brief calculates the eigenvalues of a non-symmetric dynamic matrix
+        \param[in]  matrix matrix eigenvalues are calculated for
+        \param[out] eigenValues DynamicVector that contains the eigenvalues
+
+        \note LAPACK::dgeev is used to calculate the eigen values.  To
+              compute eigenvalues of many matrices, reuse a
+              NonSymmetricEigenSolver instead, which keeps its workspace.
+     */
+    template <typename K, class C>
+    static void eigenValuesNonSym(const DynamicMatrix<K>& matrix,
+                                  DynamicVector<C>& eigenValues)
+    {
+      NonSymmetricEigenSolver().eigenValues(matrix, eigenValues);
     }
 
   }
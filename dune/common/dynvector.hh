@@ -46,6 +46,18 @@ namespace Dune {
     typedef typename FieldTraits< K >::real_type real_type;
   };
 
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // arithmetic of DynamicVector builds expressions, see DenseVectorExpression
+    template< class K, class Allocator >
+    struct DenseVectorUsesExpressions< DynamicVector< K, Allocator > >
+      : std::true_type
+    {};
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
   /** \brief Construct a vector with a dynamic size.
    *
    * \tparam K is the field type (use float, double, complex, etc)
@@ -111,8 +123,38 @@ namespace Dune {
         _data.push_back( x[ i ] );
     }
 
+    /** \brief Construct from a vector expression
+     *
+     * The expression is evaluated in a single loop, no temporary vector is
+     * created for its subexpressions.
+     */
+    template< class E >
+    explicit DynamicVector(const DenseVectorExpression< E > & e, const allocator_type &a = allocator_type() ) :
+      _data(a)
+    {
+      const size_type n = e.size();
+      _data.reserve(n);
+      for( size_type i =0; i<n ;++i)
+        _data.push_back( e[ i ] );
+    }
+
     using Base::operator=;
 
+    /** \brief Assignment from a vector expression
+     *
+     * The vector is resized to the size of the expression.  It may appear
+     * in the expression itself, since sizes then agree and entry i is
+     * only overwritten after it has been read.
+     */
+    template< class E >
+    DynamicVector &operator=(const DenseVectorExpression< E > &e)
+    {
+      if (e.size() != size())
+        _data.resize(e.size());
+      Base::operator=(e);
+      return *this;
+    }
+
     //! Copy assignment operator
     DynamicVector &operator=(const DynamicVector &other)
     {
@@ -156,6 +198,10 @@ namespace Dune {
       return _data[i];
     }
 
+    //! pointer to the contiguous storage of the entries
+    K *data () { return _data.data(); }
+    const K *data () const { return _data.data(); }
+
     const container_type &container () const { return _data; }
     container_type &container () { return _data; }
   };
@@ -122,14 +122,7 @@ namespace Dune
     FieldMatrix<K,l,cols> leftmultiplyany (const FieldMatrix<K,l,rows>& M) const
     {
       FieldMatrix<K,l,cols> C;
-
-      for (size_type i=0; i<l; i++) {
-        for (size_type j=0; j<cols; j++) {
-          C[i][j] = 0;
-          for (size_type k=0; k<rows; k++)
-            C[i][j] += M[i][k]*(*this)[k][j];
-        }
-      }
+      DenseMatrixHelp::multMatrix(M, *this, C);
       return C;
     }
 
@@ -141,15 +134,9 @@ namespace Dune
     {
       static_assert(r == c, "Cannot rightmultiply with non-square matrix");
       static_assert(r == cols, "Size mismatch");
-      FieldMatrix<K,rows,cols> C(*this);
-
-      for (size_type i=0; i<rows; i++)
-        for (size_type j=0; j<cols; j++) {
-          (*this)[i][j] = 0;
-          for (size_type k=0; k<cols; k++)
-            (*this)[i][j] += C[i][k]*M[k][j];
-        }
-      return *this;
+      FieldMatrix<K,rows,cols> C;
+      DenseMatrixHelp::multMatrix(*this, M, C);
+      return (*this = C);
     }
 
     //! Multiplies M from the right to this matrix, this matrix is not modified
@@ -157,14 +144,7 @@ namespace Dune
     FieldMatrix<K,rows,l> rightmultiplyany (const FieldMatrix<K,cols,l>& M) const
     {
       FieldMatrix<K,rows,l> C;
-
-      for (size_type i=0; i<rows; i++) {
-        for (size_type j=0; j<l; j++) {
-          C[i][j] = 0;
-          for (size_type k=0; k<cols; k++)
-            C[i][j] += (*this)[i][k]*M[k][j];
-        }
-      }
+      DenseMatrixHelp::multMatrix(*this, M, C);
       return C;
     }
 
@@ -0,0 +1,226 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_FMATRIXBATCH_HH
+#define DUNE_FMATRIXBATCH_HH
+
+/** \file
+ * \brief Operations on arrays of small FieldMatrix objects
+ *
+ * The functions in this file apply the same operation to a whole batch of
+ * independent matrices.  Internally, \f$W\f$ consecutive matrices of the
+ * batch are transposed into a single FieldMatrix whose entries are SIMD
+ * vectors with \f$W\f$ lanes (a structure-of-arrays layout), so that one
+ * SIMD instruction works on \f$W\f$ matrices at once.  The SIMD type is
+ * given as the template parameter \c V and defaults to
+ * <code>LoopSIMD<K,4></code>; any type supported by the Dune::Simd
+ * interface with scalar type \c K can be used.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/simd/loop.hh>
+#include <dune/common/simd/simd.hh>
+
+namespace Dune {
+
+  /**
+     @addtogroup DenseMatVec
+     @{
+   */
+
+  namespace FMatrixBatch {
+
+    //! SIMD type used by default to process a batch of matrices with entries of type K
+    template<class K>
+    using DefaultSimd = LoopSIMD<K, 4>;
+
+  } // end namespace FMatrixBatch
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // transpose up to lanes(V) matrices into the lanes of a, missing lanes
+    // are filled with the diagonal value pad
+    template<class V, class K, int N, int M>
+    void batchLoad (const FieldMatrix<K,N,M>* A, std::size_t count,
+                    FieldMatrix<V,N,M>& a, const K& pad)
+    {
+      static_assert(std::is_same<Simd::Scalar<V>, K>::value,
+                    "SIMD type must have the field type of the matrices as scalar type");
+      for (int i = 0; i < N; ++i)
+        for (int j = 0; j < M; ++j)
+          for (std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+            Simd::lane(l, a[i][j]) = l < count ? A[l][i][j] : (i == j ? pad : K(0));
+    }
+
+    template<class V, class K, int N>
+    void batchLoad (const FieldVector<K,N>* x, std::size_t count,
+                    FieldVector<V,N>& v)
+    {
+      for (int i = 0; i < N; ++i)
+        for (std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+          Simd::lane(l, v[i]) = l < count ? x[l][i] : K(0);
+    }
+
+    template<class V, class K, int N, int M>
+    void batchStore (const FieldMatrix<V,N,M>& a, std::size_t count,
+                     FieldMatrix<K,N,M>* A)
+    {
+      for (std::size_t l = 0; l < count; ++l)
+        for (int i = 0; i < N; ++i)
+          for (int j = 0; j < M; ++j)
+            A[l][i][j] = Simd::lane(l, a[i][j]);
+    }
+
+    template<class V, class K, int N>
+    void batchStore (const FieldVector<V,N>& v, std::size_t count,
+                     FieldVector<K,N>* x)
+    {
+      for (std::size_t l = 0; l < count; ++l)
+        for (int i = 0; i < N; ++i)
+          x[l][i] = Simd::lane(l, v[i]);
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  namespace FMatrixBatch {
+
+    /** \brief y[k] = A[k] x[k] for all k < count
+     *
+     * \param[in]  A      array of count matrices
+     * \param[in]  x      array of count vectors
+     * \param[out] y      array of count vectors, must not overlap x
+     * \param[in]  count  number of matrices in the batch
+     */
+    template<class V = void, class K, int N, int M>
+    void mv (const FieldMatrix<K,N,M>* A, const FieldVector<K,M>* x,
+             FieldVector<K,N>* y, std::size_t count)
+    {
+      typedef std::conditional_t<std::is_void<V>::value, DefaultSimd<K>, V> SimdVector;
+      constexpr std::size_t W = Simd::lanes<SimdVector>();
+      FieldMatrix<SimdVector,N,M> a;
+      FieldVector<SimdVector,M> xv;
+      FieldVector<SimdVector,N> yv;
+      for (std::size_t k = 0; k < count; k += W)
+      {
+        const std::size_t w = std::min(W, count-k);
+        Impl::batchLoad(A+k, w, a, K(0));
+        Impl::batchLoad(x+k, w, xv);
+        a.mv(xv, yv);
+        Impl::batchStore(yv, w, y+k);
+      }
+    }
+
+    /** \brief y[k] += A[k] x[k] for all k < count
+     *
+     * \param[in]     A      array of count matrices
+     * \param[in]     x      array of count vectors
+     * \param[in,out] y      array of count vectors, must not overlap x
+     * \param[in]     count  number of matrices in the batch
+     */
+    template<class V = void, class K, int N, int M>
+    void umv (const FieldMatrix<K,N,M>* A, const FieldVector<K,M>* x,
+              FieldVector<K,N>* y, std::size_t count)
+    {
+      typedef std::conditional_t<std::is_void<V>::value, DefaultSimd<K>, V> SimdVector;
+      constexpr std::size_t W = Simd::lanes<SimdVector>();
+      FieldMatrix<SimdVector,N,M> a;
+      FieldVector<SimdVector,M> xv;
+      FieldVector<SimdVector,N> yv;
+      for (std::size_t k = 0; k < count; k += W)
+      {
+        const std::size_t w = std::min(W, count-k);
+        Impl::batchLoad(A+k, w, a, K(0));
+        Impl::batchLoad(x+k, w, xv);
+        Impl::batchLoad(y+k, w, yv);
+        a.umv(xv, yv);
+        Impl::batchStore(yv, w, y+k);
+      }
+    }
+
+    /** \brief replace every matrix of the batch by its inverse
+     *
+     * \param[in,out] A      array of count matrices
+     * \param[in]     count  number of matrices in the batch
+     *
+     * \exception FMatrixError under the same conditions as
+     *            FieldMatrix::invert() for any matrix of the batch.  The
+     *            content of A is unspecified in that case.
+     */
+    template<class V = void, class K, int N>
+    void invert (FieldMatrix<K,N,N>* A, std::size_t count)
+    {
+      typedef std::conditional_t<std::is_void<V>::value, DefaultSimd<K>, V> SimdVector;
+      constexpr std::size_t W = Simd::lanes<SimdVector>();
+      FieldMatrix<SimdVector,N,N> a;
+      for (std::size_t k = 0; k < count; k += W)
+      {
+        const std::size_t w = std::min(W, count-k);
+        Impl::batchLoad(A+k, w, a, K(1));
+        a.invert();
+        Impl::batchStore(a, w, A+k);
+      }
+    }
+
+    /** \brief det[k] = determinant of A[k] for all k < count
+     *
+     * \param[in]  A      array of count matrices
+     * \param[out] det    array of count determinants
+     * \param[in]  count  number of matrices in the batch
+     */
+    template<class V = void, class K, int N>
+    void determinant (const FieldMatrix<K,N,N>* A, K* det, std::size_t count)
+    {
+      typedef std::conditional_t<std::is_void<V>::value, DefaultSimd<K>, V> SimdVector;
+      constexpr std::size_t W = Simd::lanes<SimdVector>();
+      FieldMatrix<SimdVector,N,N> a;
+      for (std::size_t k = 0; k < count; k += W)
+      {
+        const std::size_t w = std::min(W, count-k);
+        Impl::batchLoad(A+k, w, a, K(1));
+        const SimdVector d = a.determinant();
+        for (std::size_t l = 0; l < w; ++l)
+          det[k+l] = Simd::lane(l, d);
+      }
+    }
+
+    /** \brief solve A[k] x[k] = b[k] for all k < count
+     *
+     * \param[in]  A      array of count matrices
+     * \param[out] x      array of count solutions, must not overlap b
+     * \param[in]  b      array of count right hand sides
+     * \param[in]  count  number of matrices in the batch
+     *
+     * \exception FMatrixError under the same conditions as
+     *            FieldMatrix::solve() for any matrix of the batch.
+     */
+    template<class V = void, class K, int N>
+    void solve (const FieldMatrix<K,N,N>* A, FieldVector<K,N>* x,
+                const FieldVector<K,N>* b, std::size_t count)
+    {
+      typedef std::conditional_t<std::is_void<V>::value, DefaultSimd<K>, V> SimdVector;
+      constexpr std::size_t W = Simd::lanes<SimdVector>();
+      FieldMatrix<SimdVector,N,N> a;
+      FieldVector<SimdVector,N> xv, bv;
+      for (std::size_t k = 0; k < count; k += W)
+      {
+        const std::size_t w = std::min(W, count-k);
+        Impl::batchLoad(A+k, w, a, K(1));
+        Impl::batchLoad(b+k, w, bv);
+        a.solve(xv, bv);
+        Impl::batchStore(xv, w, x+k);
+      }
+    }
+
+  } // end namespace FMatrixBatch
+
+  /** @} end documentation */
+
+} // end namespace Dune
+
+#endif // DUNE_FMATRIXBATCH_HH
@@ -7,14 +7,17 @@
  * \brief Eigenvalue computations for the FieldMatrix class
  */
 
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <cassert>
+#include <limits>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 #include <dune/common/math.hh>
+#include <dune/common/simd/simd.hh>
 
 namespace Dune {
 
@@ -105,6 +108,7 @@ namespace Dune {
         eigenvalues[0] = matrix[0][0];
         eigenvalues[1] = matrix[1][1];
         eigenvalues[2] = matrix[2][2];
+        std::sort(eigenvalues.begin(), eigenvalues.end());
       }
       else
       {
@@ -140,55 +144,373 @@ namespace Dune {
       }
     }
 
-    /** \brief calculates the eigenvalues of a symmetric field matrix
-        \param[in]  matrix matrix eigenvalues are calculated for
-        \param[out] eigenvalues FieldVector that contains eigenvalues in
-                    ascending order
+  } // end namespace FMatrixHelp
 
-        \note LAPACK::dsyev is used to calculate the eigenvalues
-     */
-    template <int dim, typename K>
-    static void eigenValues(const FieldMatrix<K, dim, dim>& matrix,
-                            FieldVector<K, dim>& eigenvalues)
-    {
-      {
-        const long int N = dim ;
-        const char jobz = 'n'; // only calculate eigenvalues
-        const char uplo = 'u'; // use upper triangular matrix
+#ifndef DOXYGEN
+  namespace Impl {
 
-        // length of matrix vector
-        const long int w = N * N ;
+    // The helpers below avoid branching on the values of the entries, so
+    // that the field type K may also be a SIMD vector; every decision is
+    // taken lane-wise by Simd::cond().
 
-        // matrix to put into dsyev
-        double matrixVector[dim * dim];
+    // (c,s) such that [c s; -s c]^T [app apq; apq aqq] [c s; -s c] is
+    // diagonal, see Golub, van Loan: Matrix Computations, Alg. 8.4.1
+    template<class K>
+    void symSchur2(const K& app, const K& apq, const K& aqq, K& c, K& s)
+    {
+      using std::abs;
+      using std::sqrt;
+      const auto nonzero = (apq != K(0));
+      const K tau = (aqq - app) / (K(2) * Simd::cond(nonzero, apq, K(1)));
+      K t = Simd::cond(tau >= K(0), K(1), K(-1)) / (abs(tau) + sqrt(K(1) + tau*tau));
+      t = Simd::cond(nonzero, t, K(0));
+      c = K(1) / sqrt(K(1) + t*t);
+      s = t*c;
+    }
 
-        // copy matrix
-        int row = 0;
-        for(int i=0; i<dim; ++i)
+    // sort the eigenvalues in ascending order and permute the rows of
+    // eigenVectors alongside, unless computeVectors is false
+    template<bool computeVectors, int dim, class K>
+    void sortEigenValues(FieldVector<K,dim>& eigenValues,
+                         FieldMatrix<K,dim,dim>& eigenVectors)
+    {
+      for (int i = 0; i < dim; ++i)
+        for (int j = i+1; j < dim; ++j)
         {
-          for(int j=0; j<dim; ++j, ++row)
+          const auto mask = (eigenValues[j] < eigenValues[i]);
+          const K vi = eigenValues[i];
+          eigenValues[i] = Simd::cond(mask, eigenValues[j], vi);
+          eigenValues[j] = Simd::cond(mask, vi, eigenValues[j]);
+          if (computeVectors)
+            for (int k = 0; k < dim; ++k)
+            {
+              const K ei = eigenVectors[i][k];
+              eigenVectors[i][k] = Simd::cond(mask, eigenVectors[j][k], ei);
+              eigenVectors[j][k] = Simd::cond(mask, ei, eigenVectors[j][k]);
+            }
+        }
+    }
+
+    // cyclic Jacobi method, the rows of eigenVectors are the eigenvectors
+    template<bool computeVectors, int dim, class K>
+    void eigenValuesJacobi(const FieldMatrix<K,dim,dim>& matrix,
+                           FieldVector<K,dim>& eigenValues,
+                           FieldMatrix<K,dim,dim>& eigenVectors)
+    {
+      typedef Simd::Scalar<K> Real;
+      const int maxSweeps = 50;
+      const K tol = K(std::numeric_limits<Real>::epsilon() * std::numeric_limits<Real>::epsilon());
+
+      FieldMatrix<K,dim,dim> A = matrix;
+      FieldMatrix<K,dim,dim>& V = eigenVectors;
+      if (computeVectors)
+        for (int i = 0; i < dim; ++i)
+          for (int j = 0; j < dim; ++j)
+            V[i][j] = K(i == j ? 1 : 0);
+
+      K norm = K(0);
+      for (int i = 0; i < dim; ++i)
+        for (int j = 0; j < dim; ++j)
+          norm += A[i][j]*A[i][j];
+
+      for (int sweep = 0; sweep < maxSweeps; ++sweep)
+      {
+        K off = K(0);
+        for (int p = 0; p < dim; ++p)
+          for (int q = p+1; q < dim; ++q)
+            off += A[p][q]*A[p][q];
+        if (Simd::allTrue(off <= tol*norm))
+          break;
+
+        for (int p = 0; p < dim; ++p)
+          for (int q = p+1; q < dim; ++q)
           {
-            matrixVector[ row ] = matrix[ i ][ j ];
+            K c, s;
+            symSchur2(A[p][p], A[p][q], A[q][q], c, s);
+
+            // A = J^T A J
+            for (int k = 0; k < dim; ++k)
+            {
+              const K akp = A[k][p], akq = A[k][q];
+              A[k][p] = c*akp - s*akq;
+              A[k][q] = s*akp + c*akq;
+            }
+            for (int k = 0; k < dim; ++k)
+            {
+              const K apk = A[p][k], aqk = A[q][k];
+              A[p][k] = c*apk - s*aqk;
+              A[q][k] = s*apk + c*aqk;
+            }
+            A[p][q] = A[q][p] = K(0);
+
+            // V = V J, with V stored transposed
+            if (computeVectors)
+              for (int k = 0; k < dim; ++k)
+              {
+                const K vpk = V[p][k], vqk = V[q][k];
+                V[p][k] = c*vpk - s*vqk;
+                V[q][k] = s*vpk + c*vqk;
+              }
           }
-        }
+      }
 
-        // working memory
-        double workSpace[dim * dim];
+      for (int i = 0; i < dim; ++i)
+        eigenValues[i] = A[i][i];
+      sortEigenValues<computeVectors>(eigenValues, eigenVectors);
+    }
 
-        // return value information
-        long int info = 0;
+    template<class K>
+    FieldVector<K,3> cross(const FieldVector<K,3>& a, const FieldVector<K,3>& b)
+    {
+      return { a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0] };
+    }
 
-        // call LAPACK routine (see fmatrixev.cc)
-        eigenValuesLapackCall(&jobz, &uplo, &N, &matrixVector[0], &N,
-                              &eigenvalues[0], &workSpace[0], &w, &info);
+    template<class K>
+    FieldVector<K,3> condVector(const Simd::Mask<K>& mask,
+                                const FieldVector<K,3>& a, const FieldVector<K,3>& b)
+    {
+      return { Simd::cond(mask, a[0], b[0]), Simd::cond(mask, a[1], b[1]),
+               Simd::cond(mask, a[2], b[2]) };
+    }
 
-        if( info != 0 )
-        {
-          std::cerr << "For matrix " << matrix << " eigenvalue calculation failed! " << std::endl;
-          DUNE_THROW(InvalidStateException,"eigenValues: Eigenvalue calculation failed!");
-        }
+    // eigenvector of the symmetric matrix A for an eigenvalue of
+    // multiplicity one: the largest cross product of two rows of A - lambda I
+    template<class K>
+    FieldVector<K,3> eigenVector3(const FieldMatrix<K,3,3>& A, const K& lambda)
+    {
+      using std::sqrt;
+      FieldVector<K,3> r0 = A[0], r1 = A[1], r2 = A[2];
+      r0[0] -= lambda;
+      r1[1] -= lambda;
+      r2[2] -= lambda;
+
+      FieldVector<K,3> best = cross(r0, r1);
+      K dmax = best.two_norm2();
+      for (const FieldVector<K,3>& v : { cross(r0, r2), cross(r1, r2) })
+      {
+        const K d = v.two_norm2();
+        const auto mask = (d > dmax);
+        best = condVector(mask, v, best);
+        dmax = Simd::cond(mask, d, dmax);
       }
+      best /= sqrt(Simd::cond(dmax > K(0), dmax, K(1)));
+      return best;
     }
+
+    // eigenvector of A for lambda, perpendicular to the eigenvector w
+    template<class K>
+    FieldVector<K,3> eigenVector3(const FieldMatrix<K,3,3>& A, const FieldVector<K,3>& w,
+                                  const K& lambda)
+    {
+      using std::abs;
+      using std::max;
+      using std::sqrt;
+
+      // orthonormal basis u, v of the complement of w
+      const auto large0 = (abs(w[0]) > abs(w[1]));
+      const K n0 = w[0]*w[0] + w[2]*w[2];
+      const K n1 = w[1]*w[1] + w[2]*w[2];
+      const K invLength = K(1) / sqrt(Simd::cond(large0, n0, n1));
+      const FieldVector<K,3> u = condVector(large0,
+        FieldVector<K,3>{ -w[2]*invLength, K(0), w[0]*invLength },
+        FieldVector<K,3>{ K(0), w[2]*invLength, -w[1]*invLength });
+      const FieldVector<K,3> v = cross(w, u);
+
+      // A - lambda I restricted to span{u,v} is singular, pick its kernel
+      FieldVector<K,3> Au, Av;
+      A.mv(u, Au);
+      A.mv(v, Av);
+      const K m00 = u*Au - lambda;
+      const K m01 = u*Av;
+      const K m11 = v*Av - lambda;
+
+      const auto useRow0 = (abs(m00) >= abs(m11));
+      K x = Simd::cond(useRow0, m00, m01);
+      K y = Simd::cond(useRow0, m01, m11);
+      const K scale = max(abs(x), abs(y));
+      const auto nonzero = (scale > K(0));
+      const K safeScale = Simd::cond(nonzero, scale, K(1));
+      x /= safeScale;
+      y /= safeScale;
+      const K length = Simd::cond(nonzero, sqrt(x*x + y*y), K(1));
+      const K alpha = Simd::cond(nonzero, y / length, K(1));
+      const K beta = Simd::cond(nonzero, -x / length, K(0));
+
+      FieldVector<K,3> result;
+      for (int i = 0; i < 3; ++i)
+        result[i] = alpha*u[i] + beta*v[i];
+      return result;
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  namespace FMatrixHelp {
+
+    /** \brief calculates the eigenvalues and eigenvectors of a symmetric field matrix
+        \param[in]  matrix matrix eigenvalues are calculated for
+        \param[out] eigenValues FieldVector that contains eigenvalues in
+                    ascending order
+        \param[out] eigenVectors FieldMatrix whose i-th row is the normalized
+                    eigenvector of eigenValues[i]
+     */
+    template <typename K>
+    static void eigenValuesVectors(const FieldMatrix<K, 1, 1>& matrix,
+                                   FieldVector<K, 1>& eigenValues,
+                                   FieldMatrix<K, 1, 1>& eigenVectors)
+    {
+      eigenValues[0] = matrix[0][0];
+      eigenVectors[0][0] = K(1);
+    }
+
+    /** \brief calculates the eigenvalues and eigenvectors of a symmetric field matrix
+        \param[in]  matrix matrix eigenvalues are calculated for
+        \param[out] eigenValues FieldVector that contains eigenvalues in
+                    ascending order
+        \param[out] eigenVectors FieldMatrix whose i-th row is the normalized
+                    eigenvector of eigenValues[i]
+
+        A 2x2 matrix is diagonalized by a single Jacobi rotation.
+     */
+    template <typename K>
+    static void eigenValuesVectors(const FieldMatrix<K, 2, 2>& matrix,
+                                   FieldVector<K, 2>& eigenValues,
+                                   FieldMatrix<K, 2, 2>& eigenVectors)
+    {
+      const K a = matrix[0][0], b = matrix[0][1], d = matrix[1][1];
+      K c, s;
+      Impl::symSchur2(a, b, d, c, s);
+      eigenValues[0] = c*c*a - K(2)*c*s*b + s*s*d;
+      eigenValues[1] = s*s*a + K(2)*c*s*b + c*c*d;
+      eigenVectors[0][0] = c;
+      eigenVectors[0][1] = -s;
+      eigenVectors[1][0] = s;
+      eigenVectors[1][1] = c;
+      Impl::sortEigenValues<true>(eigenValues, eigenVectors);
+    }
+
+    /** \brief calculates the eigenvalues and eigenvectors of a symmetric 3x3 field matrix
+        \param[in]  matrix matrix eigenvalues are calculated for
+        \param[out] eigenValues FieldVector that contains eigenvalues in
+                    ascending order
+        \param[out] eigenVectors FieldMatrix whose i-th row is the normalized
+                    eigenvector of eigenValues[i]
+
+        \note If the input matrix is not symmetric the behavior of this method is undefined.
+
+        The eigenvalues are computed by the trigonometric formula also used
+        by eigenValues(), the eigenvectors by cross products as described in
+          Eberly, David (2014), A Robust Eigensolver for 3 × 3 Symmetric Matrices,
+          https://www.geometrictools.com/Documentation/RobustEigenSymmetric3x3.pdf
+        The matrix is scaled by its largest entry to avoid overflow.
+     */
+    template <typename K>
+    static void eigenValuesVectors(const FieldMatrix<K, 3, 3>& matrix,
+                                   FieldVector<K, 3>& eigenValues,
+                                   FieldMatrix<K, 3, 3>& eigenVectors)
+    {
+      using std::abs;
+      using std::acos;
+      using std::cos;
+      using std::max;
+      using std::min;
+      using std::sqrt;
+      typedef Simd::Scalar<K> Real;
+      const K pi = K(MathematicalConstants<Real>::pi());
+
+      K maxAbs = K(0);
+      for (int i = 0; i < 3; ++i)
+        for (int j = i; j < 3; ++j)
+          maxAbs = max(maxAbs, abs(matrix[i][j]));
+      const K invScale = K(1) / Simd::cond(maxAbs > K(0), maxAbs, K(1));
+
+      FieldMatrix<K,3,3> A;
+      for (int i = 0; i < 3; ++i)
+        for (int j = i; j < 3; ++j)
+          A[i][j] = A[j][i] = matrix[i][j]*invScale;
+
+      // a diagonal matrix only needs sorting
+      FieldVector<K,3> diagValues;
+      FieldMatrix<K,3,3> diagVectors;
+      for (int i = 0; i < 3; ++i)
+      {
+        diagValues[i] = A[i][i];
+        for (int j = 0; j < 3; ++j)
+          diagVectors[i][j] = K(i == j ? 1 : 0);
+      }
+      Impl::sortEigenValues<true>(diagValues, diagVectors);
+
+      const K offDiag = A[0][1]*A[0][1] + A[0][2]*A[0][2] + A[1][2]*A[1][2];
+      const auto diagonal = (offDiag == K(0));
+
+      // B = (A - q I)/p has eigenvalues 2 cos(phi + 2 pi k/3)
+      const K q = (A[0][0] + A[1][1] + A[2][2]) / K(3);
+      const K b00 = A[0][0] - q, b11 = A[1][1] - q, b22 = A[2][2] - q;
+      const K p = Simd::cond(diagonal, K(1),
+                             sqrt((b00*b00 + b11*b11 + b22*b22 + K(2)*offDiag) / K(6)));
+      const K c00 = b11*b22 - A[1][2]*A[1][2];
+      const K c01 = A[0][1]*b22 - A[1][2]*A[0][2];
+      const K c02 = A[0][1]*A[1][2] - b11*A[0][2];
+      K halfDet = (b00*c00 - A[0][1]*c01 + A[0][2]*c02) / (K(2)*p*p*p);
+      halfDet = min(max(halfDet, K(-1)), K(1));
+      const K phi = acos(halfDet) / K(3);
+
+      eigenValues[2] = q + K(2)*p*cos(phi);
+      eigenValues[0] = q + K(2)*p*cos(phi + K(2)*pi/K(3));
+      eigenValues[1] = K(3)*q - eigenValues[0] - eigenValues[2];
+      eigenValues[1] = min(max(eigenValues[1], eigenValues[0]), eigenValues[2]);
+
+      // start with the eigenvalue that is best separated from the others
+      const auto upper = (halfDet >= K(0));
+      const FieldVector<K,3> first
+        = Impl::eigenVector3(A, Simd::cond(upper, eigenValues[2], eigenValues[0]));
+      const FieldVector<K,3> second = Impl::eigenVector3(A, first, eigenValues[1]);
+      const FieldVector<K,3> third = Impl::cross(first, second);
+
+      const FieldVector<K,3> v0 = Impl::condVector(upper, third, first);
+      const FieldVector<K,3> v2 = Impl::condVector(upper, first, third);
+      for (int i = 0; i < 3; ++i)
+      {
+        eigenValues[i] = Simd::cond(diagonal, diagValues[i], eigenValues[i]) * maxAbs;
+        eigenVectors[0][i] = Simd::cond(diagonal, diagVectors[0][i], v0[i]);
+        eigenVectors[1][i] = Simd::cond(diagonal, diagVectors[1][i], second[i]);
+        eigenVectors[2][i] = Simd::cond(diagonal, diagVectors[2][i], v2[i]);
+      }
+    }
+
+    /** \brief calculates the eigenvalues and eigenvectors of a symmetric field matrix
+        \param[in]  matrix matrix eigenvalues are calculated for
+        \param[out] eigenValues FieldVector that contains eigenvalues in
+                    ascending order
+        \param[out] eigenVectors FieldMatrix whose i-th row is the normalized
+                    eigenvector of eigenValues[i]
+
+        \note The cyclic Jacobi method is used.  It does not allocate memory
+              and works for all field types, including SIMD vectors.
+     */
+    template <int dim, typename K>
+    static void eigenValuesVectors(const FieldMatrix<K, dim, dim>& matrix,
+                                   FieldVector<K, dim>& eigenValues,
+                                   FieldMatrix<K, dim, dim>& eigenVectors)
+    {
+      Impl::eigenValuesJacobi<true>(matrix, eigenValues, eigenVectors);
+    }
+
+    /** \brief calculates the eigenvalues of a symmetric field matrix
+        \param[in]  matrix matrix eigenvalues are calculated for
+        \param[out] eigenvalues FieldVector that contains eigenvalues in
+                    ascending order
+
+        \note The cyclic Jacobi method is used, see eigenValuesVectors().
+     */
+    template <int dim, typename K>
+    static void eigenValues(const FieldMatrix<K, dim, dim>& matrix,
+                            FieldVector<K, dim>& eigenvalues)
+    {
+      FieldMatrix<K, dim, dim> unused;
+      Impl::eigenValuesJacobi<false>(matrix, eigenvalues, unused);
+    }
+
     /** \brief calculates the eigenvalues of a symmetric field matrix
         \param[in]  matrix matrix eigenvalues are calculated for
         \param[out] eigenValues FieldVector that contains eigenvalues in
@@ -12,9 +12,11 @@
 #include <iostream>
 #include <complex>
 #include <algorithm>
+#include <utility>
 
 #include <dune/common/binaryfunctions.hh>
 #include <dune/common/exceptions.hh>
+#include <dune/common/parallel/future.hh>
 #include <dune/common/unused.hh>
 
 /*! \defgroup ParallelCommunication Parallel Communication
@@ -396,6 +398,96 @@ namespace Dune
       return;
     }
 
+    /**
+     * @brief Start computing something over all processes for each
+     * component of data, without waiting for the other processes.
+     *
+     * The result replaces the values of data. data is either a single
+     * value or a contiguous container like std::vector. If it is passed as
+     * an lvalue, it must not be accessed until the communication is
+     * completed and the future refers to it, otherwise it is moved into
+     * the future.
+     *
+     * The template parameter BinaryFunction is the type of
+     * the binary function to use for the computation
+     *
+     * @param data The data to compute on.
+     * @returns A future for the result, see MPIFuture.
+     */
+    template<typename BinaryFunction, typename T>
+    PseudoFuture<T> iallreduce(T&& data) const
+    {
+      return PseudoFuture<T>(std::forward<T>(data));
+    }
+
+    /**
+     * @brief Start computing something over all processes for each
+     * component of in, without waiting for the other processes.
+     *
+     * @param in The data to compute on.
+     * @param out The data to store the results in, at least as large as in.
+     * @returns A future for out.
+     */
+    template<typename BinaryFunction, typename TIn, typename TOut>
+    PseudoFuture<TOut> iallreduce(TIn&& in, TOut&& out) const
+    {
+      const char* error = Impl::copyCollectiveData(in, out,
+        "The output of iallreduce is too small!");
+      return PseudoFuture<TOut>(std::forward<TOut>(out), error);
+    }
+
+    /**
+     * @brief Start a barrier, the returned future is ready when all
+     * processes have started it.
+     */
+    PseudoFuture<void> ibarrier() const
+    {
+      return PseudoFuture<void>(true);
+    }
+
+    /**
+     * @brief Start distributing data from the process with rank root to
+     * all other processes.
+     * @returns A future for data.
+     */
+    template<typename T>
+    PseudoFuture<T> ibroadcast(T&& data, int root) const
+    {
+      DUNE_UNUSED_PARAMETER(root);
+      return PseudoFuture<T>(std::forward<T>(data));
+    }
+
+    /**
+     * @brief Start gathering in from all processes and distributing it to all.
+     *
+     * The values of in sent from the jth process are stored in the jth
+     * block of out, which must have the size of in times the number of
+     * processes.
+     * @returns A future for out.
+     */
+    template<typename TIn, typename TOut>
+    PseudoFuture<TOut> iallgather(TIn&& in, TOut&& out) const
+    {
+      const char* error = Impl::copyCollectiveData(in, out,
+        "The output of iallgather is too small!");
+      return PseudoFuture<TOut>(std::forward<TOut>(out), error);
+    }
+
+    /**
+     * @brief Start gathering in from all processes on the process with rank root.
+     *
+     * On root, out must have the size of in times the number of processes.
+     * @returns A future for out.
+     */
+    template<typename TIn, typename TOut>
+    PseudoFuture<TOut> igather(TIn&& in, TOut&& out, int root) const
+    {
+      DUNE_UNUSED_PARAMETER(root);
+      const char* error = Impl::copyCollectiveData(in, out,
+        "The output of igather is too small!");
+      return PseudoFuture<TOut>(std::forward<TOut>(out), error);
+    }
+
   };
 }
 
@@ -0,0 +1,464 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_COMMON_PARALLEL_COMMUNICATIONPROFILE_HH
+#define DUNE_COMMON_PARALLEL_COMMUNICATIONPROFILE_HH
+
+/*!
+   \file
+   \brief Opt-in counters of the messages, bytes and times of the
+   parallel communication.
+
+   \ingroup ParallelCommunication
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+/**
+ * @brief Whether the parallel communication is profiled.
+ *
+ * Define it to 1 on the command line of the compiler to record the
+ * CommunicationProfile. It has to have the same value in all translation
+ * units of a program.
+ */
+#ifndef DUNE_COMMUNICATION_PROFILING
+#define DUNE_COMMUNICATION_PROFILING 0
+#endif
+
+namespace Dune
+{
+
+  /**
+   * @brief Counters of the communication of this process.
+   *
+   * If DUNE_COMMUNICATION_PROFILING is defined to 1, BufferedCommunicator,
+   * VariableSizeCommunicator, RemoteIndices, IndicesSyncer and
+   * CollectiveCommunication<MPI_Comm> record their calls, the messages and
+   * bytes sent to and received from each neighbour, and the time spent
+   * packing data into messages, unpacking data from messages and waiting.
+   * The time of a call that is neither spent packing nor unpacking counts
+   * as waiting time. The collective communications record the size of the
+   * local contribution as one sent message without a neighbour.
+   * Otherwise the recording compiles to nothing and the profile stays empty.
+   *
+   * report() gathers the counters of all processes and writes the minimum,
+   * average and maximum over the processes, which shows the load imbalance
+   * of the communication, as text or as JSON.
+   *
+   * \code
+   * Dune::CommunicationProfile::instance().reset();
+   * // ... communicate
+   * Dune::CommunicationProfile::instance().report(std::cout, helper.getCollectiveCommunication());
+   * \endcode
+   *
+   * The profile is not thread safe.
+   *
+   * @ingroup ParallelCommunication
+   */
+  class CommunicationProfile
+  {
+  public:
+    //! Whether the communication is recorded.
+    static constexpr bool enabled = DUNE_COMMUNICATION_PROFILING;
+
+    //! The profiled classes.
+    enum Component {
+      bufferedCommunicator, variableSizeCommunicator, remoteIndices,
+      indicesSyncer, collectiveCommunication
+    };
+
+    //! The number of components.
+    static constexpr int components = 5;
+
+    //! The recorded quantities of a component, times are in seconds.
+    enum Quantity {
+      calls, sentMessages, sentBytes, receivedMessages, receivedBytes,
+      packTime, unpackTime, waitTime
+    };
+
+    //! The number of quantities.
+    static constexpr int quantities = 8;
+
+    //! The formats of report().
+    enum Format { text, json };
+
+    //! The messages and bytes exchanged with one neighbour.
+    struct Traffic
+    {
+      std::size_t sentMessages = 0;
+      std::size_t sentBytes = 0;
+      std::size_t receivedMessages = 0;
+      std::size_t receivedBytes = 0;
+    };
+
+    //! The profile of this process.
+    static CommunicationProfile& instance()
+    {
+      static CommunicationProfile profile;
+      return profile;
+    }
+
+    //! The name of a component.
+    static const char* name(Component component)
+    {
+      static const char* names[components] = {
+        "BufferedCommunicator", "VariableSizeCommunicator", "RemoteIndices",
+        "IndicesSyncer", "CollectiveCommunication"
+      };
+      return names[component];
+    }
+
+    //! The name of a quantity.
+    static const char* name(Quantity quantity)
+    {
+      static const char* names[quantities] = {
+        "calls", "sentMessages", "sentBytes", "receivedMessages", "receivedBytes",
+        "packTime", "unpackTime", "waitTime"
+      };
+      return names[quantity];
+    }
+
+    //! The value of a quantity of a component.
+    double value(Component component, Quantity quantity) const
+    {
+      return values_[component][quantity];
+    }
+
+    //! The traffic of a component with each neighbour.
+    const std::map<int,Traffic>& neighbours(Component component) const
+    {
+      return neighbours_[component];
+    }
+
+    //! Set all counters to zero.
+    void reset()
+    {
+      for(int c=0; c<components; ++c) {
+        std::fill(values_[c], values_[c]+quantities, 0.0);
+        neighbours_[c].clear();
+      }
+    }
+
+    //! Record a call of a component.
+    void call(Component component)
+    {
+      ++values_[component][calls];
+    }
+
+    /**
+     * @brief Record a message sent.
+     * @param component The component that sent the message.
+     * @param process The rank of the receiver, or a negative number if the
+     * message does not belong to a neighbour.
+     * @param bytes The size of the message.
+     */
+    void sent(Component component, int process, std::size_t bytes)
+    {
+      ++values_[component][sentMessages];
+      values_[component][sentBytes] += bytes;
+      if(process >= 0) {
+        Traffic& traffic = neighbours_[component][process];
+        ++traffic.sentMessages;
+        traffic.sentBytes += bytes;
+      }
+    }
+
+    //! Record a message received, see sent().
+    void received(Component component, int process, std::size_t bytes)
+    {
+      ++values_[component][receivedMessages];
+      values_[component][receivedBytes] += bytes;
+      if(process >= 0) {
+        Traffic& traffic = neighbours_[component][process];
+        ++traffic.receivedMessages;
+        traffic.receivedBytes += bytes;
+      }
+    }
+
+    //! Add a time in seconds to packTime, unpackTime or waitTime of a component.
+    void addTime(Component component, Quantity quantity, double seconds)
+    {
+      values_[component][quantity] += seconds;
+    }
+
+    /**
+     * @brief Write the profile of all processes of a communicator.
+     *
+     * For each component that was called on any process, the minimum,
+     * average and maximum over the processes of all quantities are written,
+     * together with the rank of a process with the maximum. The text format
+     * adds the neighbours with the most bytes sent, the JSON format the
+     * values of all processes and the traffic between all neighbours.
+     *
+     * This is a collective operation, only the process with rank 0 writes
+     * to the stream. The counters are read before any data is gathered.
+     *
+     * @param out The stream to write to.
+     * @param comm The collective communication of the processes.
+     * @param format Whether to write text or JSON.
+     */
+    template<class C>
+    void report(std::ostream& out, const C& comm, Format format = text) const
+    {
+      const int n = components*quantities;
+      const int procs = comm.size();
+      const int rank = comm.rank();
+
+      std::vector<double> local(n);
+      std::vector<double> links;
+      for(int c=0; c<components; ++c) {
+        std::copy(values_[c], values_[c]+quantities, local.begin()+c*quantities);
+        for(const auto& neighbour : neighbours_[c]) {
+          const Traffic& traffic = neighbour.second;
+          links.insert(links.end(), { double(c), double(rank), double(neighbour.first),
+                                      double(traffic.sentMessages), double(traffic.sentBytes),
+                                      double(traffic.receivedMessages), double(traffic.receivedBytes) });
+        }
+      }
+
+      std::vector<double> all(procs*n);
+      comm.gather(local.data(), all.data(), n, 0);
+
+      int noLinks = links.size();
+      std::vector<int> counts(procs), displacements(procs);
+      comm.gather(&noLinks, counts.data(), 1, 0);
+      std::partial_sum(counts.begin(), counts.end()-1, displacements.begin()+1);
+      std::vector<double> allLinks(displacements.back()+counts.back());
+      comm.gatherv(links.data(), noLinks, allLinks.data(), counts.data(), displacements.data(), 0);
+
+      if(rank != 0)
+        return;
+
+      std::ostringstream s;
+      if(format == json) {
+        s << std::setprecision(std::numeric_limits<double>::max_digits10);
+        writeJSON(s, procs, all, allLinks);
+      }else
+        writeText(s, procs, all, allLinks);
+      out << s.str();
+    }
+
+  private:
+    CommunicationProfile()
+    {
+      reset();
+    }
+
+    CommunicationProfile(const CommunicationProfile&) = delete;
+    CommunicationProfile& operator=(const CommunicationProfile&) = delete;
+
+    // The statistics of a quantity over the processes
+    struct Statistics
+    {
+      double min, avg, max;
+      int maxRank;
+    };
+
+    static Statistics statistics(int procs, const std::vector<double>& all, int c, int q)
+    {
+      Statistics result{ std::numeric_limits<double>::max(), 0.0,
+                         std::numeric_limits<double>::lowest(), 0 };
+      for(int p=0; p<procs; ++p) {
+        const double v = all[(p*components+c)*quantities+q];
+        result.min = std::min(result.min, v);
+        result.avg += v;
+        if(v > result.max) {
+          result.max = v;
+          result.maxRank = p;
+        }
+      }
+      result.avg /= procs;
+      return result;
+    }
+
+    static bool called(int procs, const std::vector<double>& all, int c)
+    {
+      return statistics(procs, all, c, calls).max > 0;
+    }
+
+    static void writeText(std::ostream& s, int procs, const std::vector<double>& all,
+                          const std::vector<double>& links)
+    {
+      const std::size_t maxLinks = 5;
+      s << "Communication profile of " << procs << " processes" << std::endl;
+      for(int c=0; c<components; ++c) {
+        if(!called(procs, all, c))
+          continue;
+        s << name(Component(c)) << std::endl
+          << "  " << std::left << std::setw(18) << "quantity" << std::right
+          << std::setw(14) << "min" << std::setw(14) << "avg" << std::setw(14) << "max"
+          << std::setw(8) << "rank" << std::setw(12) << "max/avg" << std::endl;
+        for(int q=0; q<quantities; ++q) {
+          const Statistics stat = statistics(procs, all, c, q);
+          s << "  " << std::left << std::setw(18) << name(Quantity(q)) << std::right
+            << std::setw(14) << stat.min << std::setw(14) << stat.avg << std::setw(14) << stat.max
+            << std::setw(8) << stat.maxRank << std::setw(12)
+            << (stat.avg > 0 ? stat.max/stat.avg : 1.0) << std::endl;
+        }
+
+        // the neighbours with the most bytes sent
+        std::vector<const double*> heaviest;
+        for(std::size_t l=0; l<links.size(); l+=7)
+          if(links[l] == c)
+            heaviest.push_back(&links[l]);
+        std::sort(heaviest.begin(), heaviest.end(),
+                  [](const double* a, const double* b) { return a[4] > b[4]; });
+        if(heaviest.size() > maxLinks)
+          heaviest.resize(maxLinks);
+        for(const double* link : heaviest)
+          s << "  " << link[1] << " -> " << link[2] << ": " << link[3] << " messages, "
+            << link[4] << " bytes" << std::endl;
+      }
+    }
+
+    static void writeJSON(std::ostream& s, int procs, const std::vector<double>& all,
+                          const std::vector<double>& links)
+    {
+      s << "{\n  \"processes\": " << procs << ",\n  \"components\": {";
+      bool first = true;
+      for(int c=0; c<components; ++c) {
+        if(!called(procs, all, c))
+          continue;
+        s << (first ? "" : ",") << "\n    \"" << name(Component(c)) << "\": {";
+        first = false;
+        for(int q=0; q<quantities; ++q) {
+          const Statistics stat = statistics(procs, all, c, q);
+          s << "\n      \"" << name(Quantity(q)) << "\": { \"min\": " << stat.min
+            << ", \"avg\": " << stat.avg << ", \"max\": " << stat.max
+            << ", \"maxRank\": " << stat.maxRank << ", \"values\": [";
+          for(int p=0; p<procs; ++p)
+            s << (p ? ", " : "") << all[(p*components+c)*quantities+q];
+          s << "] },";
+        }
+        s << "\n      \"neighbours\": [";
+        bool firstLink = true;
+        for(std::size_t l=0; l<links.size(); l+=7) {
+          if(links[l] != c)
+            continue;
+          s << (firstLink ? "" : ",") << "\n        { \"rank\": " << links[l+1]
+            << ", \"neighbour\": " << links[l+2] << ", \"sentMessages\": " << links[l+3]
+            << ", \"sentBytes\": " << links[l+4] << ", \"receivedMessages\": " << links[l+5]
+            << ", \"receivedBytes\": " << links[l+6] << " }";
+          firstLink = false;
+        }
+        s << (firstLink ? "]" : "\n      ]") << "\n    }";
+      }
+      s << (first ? "}" : "\n  }") << "\n}" << std::endl;
+    }
+
+    double values_[components][quantities];
+    std::map<int,Traffic> neighbours_[components];
+  };
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+#if DUNE_COMMUNICATION_PROFILING
+    inline double commProfileTime()
+    {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Records a call of a component while it is alive. The time that is
+    // not spent in a CommProfileTimer of the component is waiting time.
+    class CommProfileScope
+    {
+    public:
+      explicit CommProfileScope(CommunicationProfile::Component component, bool call = true)
+        : component_(component), start_(commProfileTime()), busy_(busy())
+      {
+        if(call)
+          CommunicationProfile::instance().call(component);
+      }
+
+      ~CommProfileScope()
+      {
+        const double elapsed = commProfileTime()-start_;
+        CommunicationProfile::instance().addTime(component_, CommunicationProfile::waitTime,
+                                                 elapsed-(busy()-busy_));
+      }
+
+    private:
+      double busy() const
+      {
+        const CommunicationProfile& profile = CommunicationProfile::instance();
+        return profile.value(component_, CommunicationProfile::packTime)
+               + profile.value(component_, CommunicationProfile::unpackTime);
+      }
+
+      CommunicationProfile::Component component_;
+      double start_;
+      double busy_;
+    };
+
+    // Adds the time it is alive to the pack or unpack time of a component
+    class CommProfileTimer
+    {
+    public:
+      CommProfileTimer(CommunicationProfile::Component component,
+                       CommunicationProfile::Quantity quantity)
+        : component_(component), quantity_(quantity), start_(commProfileTime())
+      {}
+
+      ~CommProfileTimer()
+      {
+        CommunicationProfile::instance().addTime(component_, quantity_, commProfileTime()-start_);
+      }
+
+    private:
+      CommunicationProfile::Component component_;
+      CommunicationProfile::Quantity quantity_;
+      double start_;
+    };
+
+    inline void commProfileSent(CommunicationProfile::Component component, int process, std::size_t bytes)
+    {
+      CommunicationProfile::instance().sent(component, process, bytes);
+    }
+
+    inline void commProfileReceived(CommunicationProfile::Component component, int process, std::size_t bytes)
+    {
+      CommunicationProfile::instance().received(component, process, bytes);
+    }
+#else
+    class CommProfileScope
+    {
+    public:
+      explicit CommProfileScope(CommunicationProfile::Component, bool = true)
+      {}
+
+      ~CommProfileScope()
+      {}
+    };
+
+    class CommProfileTimer
+    {
+    public:
+      CommProfileTimer(CommunicationProfile::Component, CommunicationProfile::Quantity)
+      {}
+
+      ~CommProfileTimer()
+      {}
+    };
+
+    inline void commProfileSent(CommunicationProfile::Component, int, std::size_t)
+    {}
+
+    inline void commProfileReceived(CommunicationProfile::Component, int, std::size_t)
+    {}
+#endif // DUNE_COMMUNICATION_PROFILING
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+} // end namespace Dune
+
+#endif // DUNE_COMMON_PARALLEL_COMMUNICATIONPROFILE_HH
@@ -5,19 +5,28 @@
 
 #if HAVE_MPI
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <iostream>
 #include <map>
+#include <new>
+#include <numeric>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <mpi.h>
 
 #include <dune/common/exceptions.hh>
+#include <dune/common/parallel/communicationprofile.hh>
 #include <dune/common/parallel/interface.hh>
+#include <dune/common/parallel/mpitraits.hh>
 #include <dune/common/parallel/remoteindices.hh>
 #include <dune/common/stdstreams.hh>
+#include <dune/common/typetraits.hh>
 #include <dune/common/unused.hh>
 
 namespace Dune
@@ -446,6 +455,114 @@ namespace Dune
 
   };
 
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // whether Data provides its entries contiguously by data()
+    template<class Data, class = void>
+    struct CommHasContiguousData : std::false_type {};
+
+    template<class Data>
+    struct CommHasContiguousData<Data, void_t<decltype(std::declval<const Data&>().data())> >
+      : std::is_same<decltype(std::declval<const Data&>().data()),
+                     const typename CommPolicy<Data>::IndexedType*>
+    {};
+
+    // whether BufferedCommunicator can send the entries of Data directly
+    // from and receive them directly into the data with MPI datatypes
+    template<class GatherScatter, class Data>
+    struct CommUseDatatypes
+      : std::integral_constant<bool,
+          std::is_same<GatherScatter, CopyGatherScatter<Data> >::value
+          && std::is_same<typename CommPolicy<Data>::IndexedTypeFlag, SizeOne>::value
+          && CommHasContiguousData<Data>::value>
+    {};
+
+    // The shared memory segment of a process if the BufferedCommunicator
+    // communicates through shared memory. It starts with the number of the
+    // last message published in each direction, the number of the last
+    // message consumed from each process of the node in each direction and
+    // the offsets of the messages to each process of the node, followed by
+    // the buffers.
+    class CommSharedSegment
+    {
+    public:
+      typedef std::atomic<unsigned long> Counter;
+
+      // whether the counters can be accessed by several processes, which
+      // requires them to be lock free
+      static bool available()
+      {
+        return Counter().is_lock_free();
+      }
+
+      CommSharedSegment()
+        : base_(nullptr), nodeSize_(0)
+      {}
+
+      CommSharedSegment(char* base, int nodeSize)
+        : base_(base), nodeSize_(nodeSize)
+      {}
+
+      // the size of the control block, a multiple of the size of a cache line
+      static std::size_t controlSize(int nodeSize)
+      {
+        const std::size_t size = (2+2*nodeSize)*sizeof(Counter) + 2*nodeSize*sizeof(std::size_t);
+        return (size+63)/64*64;
+      }
+
+      // construct the counters of the own segment
+      void initialize() const
+      {
+        for(int i=0; i<2+2*nodeSize_; ++i)
+          new(counters()+i) Counter(0);
+      }
+
+      Counter& published(int d) const
+      {
+        return counters()[d];
+      }
+
+      Counter& consumed(int d, int nodeRank) const
+      {
+        return counters()[2+d*nodeSize_+nodeRank];
+      }
+
+      std::size_t& offset(int d, int nodeRank) const
+      {
+        return reinterpret_cast<std::size_t*>(counters()+2+2*nodeSize_)[d*nodeSize_+nodeRank];
+      }
+
+      char* base() const
+      {
+        return base_;
+      }
+
+      char* buffers() const
+      {
+        return base_+controlSize(nodeSize_);
+      }
+
+    private:
+      Counter* counters() const
+      {
+        return reinterpret_cast<Counter*>(base_);
+      }
+
+      char* base_;
+      int nodeSize_;
+    };
+
+    // wait until a counter written by another process reaches value
+    inline void commWaitFor(const CommSharedSegment::Counter& counter, unsigned long value)
+    {
+      while(counter.load(std::memory_order_acquire) < value)
+        std::this_thread::yield();
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
   /**
    * @brief A communicator that uses buffers to gather and scatter
    * the data to be send or received.
@@ -454,6 +571,37 @@ namespace Dune
    * then that buffer is sent.
    * The data is received in another buffer and then copied to the actual
    * position.
+   *
+   * The messages are sent with persistent standard mode requests that
+   * are created by build(), so a communication does not allocate memory
+   * or set up requests and small messages are not delayed by a
+   * synchronization with the receiver.
+   *
+   * Besides the blocking methods forward() and backward() the
+   * communication can be split into two phases to overlap it with
+   * computations that do not depend on the communicated values:
+   * \code
+   * comm.forwardBegin<GatherScatter>(source);
+   * // work that does not read the entries of dest that are received
+   * comm.forwardEnd<GatherScatter>(dest);
+   * \endcode
+   * Only one communication may be in progress at a time.
+   *
+   * The blocking methods skip the buffers if the GatherScatter is
+   * CopyGatherScatter and the data stores its entries contiguously and
+   * provides them by a method data(), e.g. std::vector or DynamicVector.
+   * The entries are then sent directly from the source and received
+   * directly into the target with MPI datatypes. Communicating in place,
+   * i.e. with the same source and target, still uses the buffers if an
+   * entry is both sent and received. See setZeroCopy().
+   *
+   * With setNeighbourhoodCollectives(true) the messages are exchanged by a
+   * single neighbourhood collective on a distributed graph communicator
+   * of the neighbouring processes instead of by point to point messages.
+   *
+   * With setSharedMemory(true) the buffers are allocated in shared memory
+   * and the data of neighbours on the same node is scattered directly from
+   * their buffers instead of being sent by MPI.
    */
   class BufferedCommunicator
   {
@@ -602,13 +750,164 @@ namespace Dune
     template<class GatherScatter, class Data>
     void backward(Data& data);
 
+    /**
+     * @brief Start a send from source to target.
+     *
+     * Gathers the values of source into the send buffer and posts the
+     * nonblocking sends and receives. The communication has to be
+     * completed by a call to forwardEnd() with the same GatherScatter
+     * before another communication is started with this communicator.
+     * As the values are gathered immediately, source may be changed
+     * before forwardEnd() is called.
+     *
+     * @param source The values will be copied from here to the send buffers.
+     * @see forward() for the requirements on GatherScatter.
+     * @throw InvalidStateException if a communication is already in progress.
+     */
+    template<class GatherScatter, class Data>
+    void forwardBegin(const Data& source);
+
+    /**
+     * @brief Complete a send started by forwardBegin().
+     *
+     * Waits for the messages and copies the received values to dest.
+     *
+     * @param dest The received values will be copied to here.
+     * @throw InvalidStateException if no forward communication is in progress.
+     */
+    template<class GatherScatter, class Data>
+    void forwardEnd(Data& dest);
+
+    /**
+     * @brief Start a communication in the reverse direction, i.e. send
+     * from target to source.
+     *
+     * The counterpart of forwardBegin() for backward().
+     *
+     * @param dest The values will be copied from here to the send buffers.
+     * @throw InvalidStateException if a communication is already in progress.
+     */
+    template<class GatherScatter, class Data>
+    void backwardBegin(const Data& dest);
+
+    /**
+     * @brief Complete a communication started by backwardBegin().
+     *
+     * @param source The received values will be copied to here.
+     * @throw InvalidStateException if no backward communication is in progress.
+     */
+    template<class GatherScatter, class Data>
+    void backwardEnd(Data& source);
+
+    /**
+     * @brief Whether a communication was started and not yet completed.
+     */
+    bool pending() const
+    {
+      return pending_ != noCommunication;
+    }
+
+    /**
+     * @brief Enable or disable the communication without buffers.
+     *
+     * If enabled, which is the default, forward() and backward() send and
+     * receive contiguous data directly with MPI datatypes when the
+     * GatherScatter only copies the values. Depending on the MPI
+     * implementation the buffered communication can be faster for small
+     * messages.
+     */
+    void setZeroCopy(bool enable)
+    {
+      zeroCopy_ = enable;
+    }
+
+    /**
+     * @brief Whether contiguous data is communicated without buffers if possible.
+     * @see setZeroCopy()
+     */
+    bool zeroCopy() const
+    {
+      return zeroCopy_;
+    }
+
+    /**
+     * @brief Enable or disable the communication by neighbourhood collectives.
+     *
+     * If enabled, build() creates a communicator with the topology of the
+     * interface by MPI_Dist_graph_create_adjacent and the messages are
+     * exchanged by MPI_Neighbor_alltoallv, which is persistent if the MPI
+     * library implements MPI 4. This allows the MPI library to optimize
+     * the exchange for the topology. build() and free() are then
+     * collective over the communicator of the interface, and all
+     * communication uses the buffers, see setZeroCopy().
+     *
+     * The setting takes effect on the next call of build().
+     */
+    void setNeighbourhoodCollectives(bool enable)
+    {
+      neighbourhoodCollectives_ = enable;
+    }
+
+    /**
+     * @brief Whether the messages are exchanged by neighbourhood collectives.
+     * @see setNeighbourhoodCollectives()
+     */
+    bool neighbourhoodCollectives() const
+    {
+      return neighbourhoodCollectives_;
+    }
+
+    /**
+     * @brief Enable or disable the communication through shared memory.
+     *
+     * If enabled, build() determines the processes on the same node by
+     * MPI_Comm_split_type and allocates the buffers in a window created by
+     * MPI_Win_allocate_shared. The data for a neighbour on the same node is
+     * gathered into the buffer as usual, and the neighbour scatters it
+     * directly from there. The processes synchronize by counters in the
+     * shared memory instead of messages. The data of neighbours on other
+     * nodes is still sent by MPI. build() and free() are then collective
+     * over the communicator of the interface, and all communication uses
+     * the buffers, see setZeroCopy(). The setting has no effect if the
+     * messages are exchanged by neighbourhood collectives, or if
+     * std::atomic<unsigned long> is not lock free on the platform.
+     *
+     * @warning free() and the destructor then wait for the other processes
+     * on the node. If one of them destroys the communicator while
+     * unwinding from an exception, the others wait forever.
+     *
+     * The setting takes effect on the next call of build().
+     */
+    void setSharedMemory(bool enable)
+    {
+      sharedMemory_ = enable;
+    }
+
+    /**
+     * @brief Whether neighbours on the same node communicate through shared memory.
+     * @see setSharedMemory()
+     */
+    bool sharedMemory() const
+    {
+      return sharedMemory_;
+    }
+
     /**
      * @brief Free the allocated memory (i.e. buffers and message information.
+     *
+     * A communication still in progress is completed first, without
+     * copying the received values anywhere.
+     *
+     * If the buffers are in shared memory, see setSharedMemory(), this is
+     * collective over the processes of the node.
      */
     void free();
 
     /**
      * @brief Destructor.
+     *
+     * Calls free(), which is collective over the processes of the node if
+     * the buffers are in shared memory.
      */
     ~BufferedCommunicator();
 
@@ -889,12 +1188,272 @@ namespace Dune
 
     MPI_Comm communicator_;
 
+    /**
+     * @brief The state of the split phase communication.
+     */
+    enum PendingCommunication {
+      noCommunication, forwardCommunication, backwardCommunication
+    };
+
+    /**
+     * @brief The communication started and not yet completed.
+     */
+    PendingCommunication pending_;
+
+    /**
+     * @brief The persistent send requests.
+     *
+     * Index 1 is used for forward, index 0 for backward communication.
+     * Messages without data do not get a request.
+     */
+    std::vector<MPI_Request> sendRequests_[2];
+
+    /**
+     * @brief The persistent receive requests.
+     *
+     * Index 1 is used for forward, index 0 for backward communication.
+     */
+    std::vector<MPI_Request> recvRequests_[2];
+
+    /**
+     * @brief The ranks the messages of recvRequests_ are received from.
+     */
+    std::vector<int> recvProcesses_[2];
+
+    /**
+     * @brief The ranks the messages of sendRequests_ are sent to.
+     */
+    std::vector<int> sendProcesses_[2];
+
+    /**
+     * @brief Whether contiguous data is communicated without buffers if possible.
+     */
+    bool zeroCopy_;
+
+    /**
+     * @brief The MPI datatypes addressing the entries sent from contiguous data.
+     *
+     * Index 1 is used for forward, index 0 for backward communication.
+     * The types are in the order of sendProcesses_ and are created by
+     * the first communication without buffers.
+     */
+    std::vector<MPI_Datatype> sendTypes_[2];
+
+    /**
+     * @brief The MPI datatypes addressing the entries received into contiguous data.
+     *
+     * The types are in the order of recvProcesses_.
+     */
+    std::vector<MPI_Datatype> recvTypes_[2];
+
+    /**
+     * @brief The type of the entries the datatypes were created for.
+     */
+    MPI_Datatype datatypesEntry_;
+
+    /**
+     * @brief Whether an entry is both sent and received in a communication.
+     */
+    bool sharedEntries_[2];
+
+    /**
+     * @brief The requests of a communication without buffers.
+     */
+    std::vector<MPI_Request> datatypeRequests_;
+
+    /**
+     * @brief Whether build() sets up the communication by neighbourhood collectives.
+     */
+    bool neighbourhoodCollectives_;
+
+    /**
+     * @brief The distributed graph communicator of the neighbouring processes.
+     *
+     * MPI_COMM_NULL if the messages are exchanged point to point.
+     */
+    MPI_Comm neighbourhoodCommunicator_;
+
+    /**
+     * @brief The type of the values in the buffers.
+     */
+    MPI_Datatype neighbourhoodType_;
+
+    /**
+     * @brief The number of values sent to each neighbour.
+     *
+     * Index 1 is used for forward, index 0 for backward communication.
+     */
+    std::vector<int> sendCounts_[2];
+
+    /**
+     * @brief The offsets of the values sent to each neighbour in the send buffer.
+     */
+    std::vector<int> sendDisplacements_[2];
+
+    /**
+     * @brief The number of values received from each neighbour.
+     */
+    std::vector<int> recvCounts_[2];
+
+    /**
+     * @brief The offsets of the values received from each neighbour in the receive buffer.
+     */
+    std::vector<int> recvDisplacements_[2];
+
+    /**
+     * @brief The requests of the neighbourhood collectives.
+     */
+    MPI_Request neighbourhoodRequests_[2];
+
+    /**
+     * @brief Whether build() sets up the communication through shared memory.
+     */
+    bool sharedMemory_;
+
+    /**
+     * @brief The communicator of the processes on the same node.
+     *
+     * MPI_COMM_NULL if the buffers are not in shared memory.
+     */
+    MPI_Comm nodeCommunicator_;
+
+    /**
+     * @brief The shared memory window of the buffers.
+     *
+     * MPI_WIN_NULL if the buffers are not in shared memory.
+     */
+    MPI_Win window_;
+
+    /**
+     * @brief The shared memory segment of this process.
+     */
+    Impl::CommSharedSegment segment_;
+
+    /**
+     * @brief The rank of this process in the node communicator.
+     */
+    int nodeRank_;
+
+    /**
+     * @brief The number of communications started in each direction.
+     */
+    unsigned long sequence_[2];
+
+    /**
+     * @brief A neighbour on the same node.
+     */
+    struct SharedNeighbour
+    {
+      /** @brief The rank in the communicator of the interface. */
+      int process;
+      /** @brief The rank in the node communicator. */
+      int nodeRank;
+      /** @brief The shared memory segment of the neighbour. */
+      Impl::CommSharedSegment segment;
+      /** @brief Whether data is sent to the neighbour in each direction. */
+      bool send[2];
+      /** @brief The data received from the neighbour in each direction, or null. */
+      const char* recv[2];
+    };
+
+    /**
+     * @brief The neighbours on the same node, which get no requests.
+     */
+    std::vector<SharedNeighbour> sharedNeighbours_;
+
     /**
      * @brief Send and receive Data.
      */
     template<class GatherScatter, bool FORWARD, class Data>
     void sendRecv(const Data& source, Data& target);
 
+    /**
+     * @brief Send and receive Data using the buffers.
+     */
+    template<class GatherScatter, bool FORWARD, class Data>
+    void sendRecv(const Data& source, Data& target, std::false_type);
+
+    /**
+     * @brief Send and receive contiguous Data without buffers if possible.
+     */
+    template<class GatherScatter, bool FORWARD, class Data>
+    void sendRecv(const Data& source, Data& target, std::true_type);
+
+    /**
+     * @brief Send and receive the entries of contiguous data with MPI datatypes.
+     */
+    template<bool FORWARD, class Type>
+    void datatypeSendRecv(const Type* source, Type* target);
+
+    /**
+     * @brief Create the MPI datatypes for entries of type Type.
+     */
+    template<class Type>
+    void createDatatypes();
+
+    /**
+     * @brief Free the MPI datatypes.
+     */
+    void freeDatatypes();
+
+    /**
+     * @brief Gather the data and post the sends and receives.
+     */
+    template<class GatherScatter, bool FORWARD, class Data>
+    void sendRecvBegin(const Data& source);
+
+    /**
+     * @brief Wait for the messages and scatter the data.
+     */
+    template<class GatherScatter, bool FORWARD, class Data>
+    void sendRecvEnd(Data& target);
+
+    /**
+     * @brief Wait for the communication in progress without scattering.
+     */
+    void cancelPending();
+
+    /**
+     * @brief Create the persistent requests for the messages.
+     *
+     * Has to be called after the buffers are allocated.
+     */
+    template<class Data>
+    void createRequests();
+
+    /**
+     * @brief Create the communicator and the counts for the neighbourhood collectives.
+     */
+    template<class Data>
+    void createNeighbourhoodCollectives();
+
+    /**
+     * @brief Free the persistent requests.
+     */
+    void freeRequests();
+
+    /**
+     * @brief Allocate the buffers, in shared memory if enabled.
+     */
+    template<class Data>
+    void allocateBuffers();
+
+    /**
+     * @brief Allocate the buffers in a shared memory window and find the neighbours on the node.
+     */
+    template<class Type>
+    void createSharedBuffers();
+
+    /**
+     * @brief Free the buffers.
+     */
+    void freeBuffers();
+
+    /**
+     * @brief Record the messages sent or received in the CommunicationProfile.
+     */
+    void profileMessages(bool forward, bool send) const;
+
   };
 
 #ifndef DOXYGEN
@@ -1136,7 +1695,13 @@ namespace Dune
   }
 
   inline BufferedCommunicator::BufferedCommunicator()
+    : pending_(noCommunication), zeroCopy_(true), datatypesEntry_(MPI_DATATYPE_NULL),
+      neighbourhoodCollectives_(false), neighbourhoodCommunicator_(MPI_COMM_NULL),
+      neighbourhoodType_(MPI_DATATYPE_NULL), sharedMemory_(false),
+      nodeCommunicator_(MPI_COMM_NULL), window_(MPI_WIN_NULL), nodeRank_(0)
   {
+    neighbourhoodRequests_[0]=neighbourhoodRequests_[1]=MPI_REQUEST_NULL;
+    sequence_[0]=sequence_[1]=0;
     buffers_[0]=0;
     buffers_[1]=0;
     bufferSize_[0]=0;
@@ -1177,8 +1742,9 @@ namespace Dune
     bufferSize_[0] *= sizeof(typename CommPolicy<Data>::IndexedType);
     bufferSize_[1] *= sizeof(typename CommPolicy<Data>::IndexedType);
 
-    buffers_[0] = new char[bufferSize_[0]];
-    buffers_[1] = new char[bufferSize_[1]];
+    allocateBuffers<Data>();
+
+    createRequests<Data>();
   }
 
   template<class Data, class Interface>
@@ -1212,21 +1778,348 @@ namespace Dune
     bufferSize_[0] *= sizeof(typename CommPolicy<Data>::IndexedType);
     bufferSize_[1] *= sizeof(typename CommPolicy<Data>::IndexedType);
     // allocate the buffers
+    allocateBuffers<Data>();
+
+    createRequests<Data>();
+  }
+
+  inline void BufferedCommunicator::cancelPending()
+  {
+    if(pending_ == noCommunication)
+      return;
+    const int d = pending_ == forwardCommunication ? 1 : 0;
+    int finalized=0;
+    MPI_Finalized(&finalized);
+    if(!finalized) {
+      MPI_Waitall(recvRequests_[d].size(), recvRequests_[d].data(), MPI_STATUSES_IGNORE);
+      MPI_Waitall(sendRequests_[d].size(), sendRequests_[d].data(), MPI_STATUSES_IGNORE);
+      MPI_Wait(&neighbourhoodRequests_[d], MPI_STATUS_IGNORE);
+    }
+    pending_ = noCommunication;
+  }
+
+  template<class Data>
+  void BufferedCommunicator::createRequests()
+  {
+    freeRequests();
+
+    typedef typename CommPolicy<Data>::IndexedType Type;
+
+    typedef InformationMap::const_iterator const_iterator;
+    const const_iterator end = messageInformation_.end();
+
+    if(neighbourhoodCollectives_) {
+      createNeighbourhoodCollectives<Data>();
+      return;
+    }
+
+    for(int d=0; d<2; ++d) {
+      // forward communication (d==1) sends from buffer 0 to buffer 1
+      const bool forward = d==1;
+      Type* sendBuffer = reinterpret_cast<Type*>(buffers_[forward ? 0 : 1]);
+      Type* recvBuffer = reinterpret_cast<Type*>(buffers_[forward ? 1 : 0]);
+
+      for(const_iterator info = messageInformation_.begin(); info != end; ++info) {
+        // neighbours on the same node read from the buffers directly
+        if(std::any_of(sharedNeighbours_.begin(), sharedNeighbours_.end(),
+                       [&](const SharedNeighbour& neighbour) { return neighbour.process == info->first; }))
+          continue;
+        const MessageInformation& recvInfo = forward ? info->second.second : info->second.first;
+        const MessageInformation& sendInfo = forward ? info->second.first : info->second.second;
+        // the messages are typed to match the ones sent and received
+        // without buffers
+        if(recvInfo.size_) {
+          recvRequests_[d].push_back(MPI_REQUEST_NULL);
+          recvProcesses_[d].push_back(info->first);
+          MPI_Recv_init(recvBuffer+recvInfo.start_, recvInfo.size_/sizeof(Type), MPITraits<Type>::getType(),
+                        info->first, commTag_, communicator_, &recvRequests_[d].back());
+        }
+        if(sendInfo.size_) {
+          sendRequests_[d].push_back(MPI_REQUEST_NULL);
+          sendProcesses_[d].push_back(info->first);
+          MPI_Send_init(sendBuffer+sendInfo.start_, sendInfo.size_/sizeof(Type), MPITraits<Type>::getType(),
+                        info->first, commTag_, communicator_, &sendRequests_[d].back());
+        }
+      }
+    }
+  }
+
+  inline void BufferedCommunicator::freeRequests()
+  {
+    int finalized=0;
+    MPI_Finalized(&finalized);
+    for(int d=0; d<2; ++d) {
+      if(!finalized) {
+        for(MPI_Request& request : recvRequests_[d])
+          MPI_Request_free(&request);
+        for(MPI_Request& request : sendRequests_[d])
+          MPI_Request_free(&request);
+      }
+      recvRequests_[d].clear();
+      sendRequests_[d].clear();
+      recvProcesses_[d].clear();
+      sendProcesses_[d].clear();
+#if MPI_VERSION >= 4
+      if(!finalized && neighbourhoodRequests_[d] != MPI_REQUEST_NULL)
+        MPI_Request_free(&neighbourhoodRequests_[d]);
+#endif
+      neighbourhoodRequests_[d] = MPI_REQUEST_NULL;
+      sendCounts_[d].clear();
+      sendDisplacements_[d].clear();
+      recvCounts_[d].clear();
+      recvDisplacements_[d].clear();
+    }
+    if(!finalized && neighbourhoodCommunicator_ != MPI_COMM_NULL)
+      MPI_Comm_free(&neighbourhoodCommunicator_);
+    neighbourhoodCommunicator_ = MPI_COMM_NULL;
+  }
+
+  template<class Data>
+  void BufferedCommunicator::createNeighbourhoodCollectives()
+  {
+    typedef typename CommPolicy<Data>::IndexedType Type;
+    neighbourhoodType_ = MPITraits<Type>::getType();
+
+    // The graph is symmetric, every process is both source and
+    // destination, and the counts for the unused direction are zero.
+    std::vector<int> neighbours;
+    for(const auto& info : messageInformation_)
+      neighbours.push_back(info.first);
+    MPI_Dist_graph_create_adjacent(communicator_, neighbours.size(), neighbours.data(), MPI_UNWEIGHTED,
+                                   neighbours.size(), neighbours.data(), MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL, 0, &neighbourhoodCommunicator_);
+
+    for(int d=0; d<2; ++d) {
+      // forward communication (d==1) sends from buffer 0 to buffer 1
+      const bool forward = d==1;
+      for(const auto& info : messageInformation_) {
+        const MessageInformation& recvInfo = forward ? info.second.second : info.second.first;
+        const MessageInformation& sendInfo = forward ? info.second.first : info.second.second;
+        sendCounts_[d].push_back(sendInfo.size_/sizeof(Type));
+        sendDisplacements_[d].push_back(sendInfo.start_);
+        recvCounts_[d].push_back(recvInfo.size_/sizeof(Type));
+        recvDisplacements_[d].push_back(recvInfo.start_);
+      }
+#if MPI_VERSION >= 4
+      MPI_Neighbor_alltoallv_init(buffers_[forward ? 0 : 1], sendCounts_[d].data(), sendDisplacements_[d].data(),
+                                  neighbourhoodType_, buffers_[forward ? 1 : 0], recvCounts_[d].data(),
+                                  recvDisplacements_[d].data(), neighbourhoodType_, neighbourhoodCommunicator_,
+                                  MPI_INFO_NULL, &neighbourhoodRequests_[d]);
+#endif
+    }
+  }
+
+  template<class Data>
+  void BufferedCommunicator::allocateBuffers()
+  {
+    if(sharedMemory_ && !neighbourhoodCollectives_ && Impl::CommSharedSegment::available()) {
+      createSharedBuffers<typename CommPolicy<Data>::IndexedType>();
+      return;
+    }
     buffers_[0] = new char[bufferSize_[0]];
     buffers_[1] = new char[bufferSize_[1]];
   }
 
-  inline void BufferedCommunicator::free()
+  template<class Type>
+  void BufferedCommunicator::createSharedBuffers()
   {
-    messageInformation_.clear();
-    if(buffers_[0])
-      delete[] buffers_[0];
+    MPI_Comm_split_type(communicator_, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodeCommunicator_);
+    int nodeSize;
+    MPI_Comm_size(nodeCommunicator_, &nodeSize);
+    MPI_Comm_rank(nodeCommunicator_, &nodeRank_);
+
+    // the ranks of the processes of the node in the communicator of the interface
+    std::vector<int> nodeRanks(nodeSize), ranks(nodeSize);
+    std::iota(nodeRanks.begin(), nodeRanks.end(), 0);
+    MPI_Group nodeGroup, group;
+    MPI_Comm_group(nodeCommunicator_, &nodeGroup);
+    MPI_Comm_group(communicator_, &group);
+    MPI_Group_translate_ranks(nodeGroup, nodeSize, nodeRanks.data(), group, ranks.data());
+    MPI_Group_free(&nodeGroup);
+    MPI_Group_free(&group);
+
+    // every segment starts at a cache line
+    const std::size_t size = Impl::CommSharedSegment::controlSize(nodeSize) + bufferSize_[0] + bufferSize_[1];
+    MPI_Info info;
+    MPI_Info_create(&info);
+    MPI_Info_set(info, const_cast<char*>("alloc_shared_noncontig"), const_cast<char*>("true"));
+    char* base;
+    MPI_Win_allocate_shared((size+63)/64*64, 1, info, nodeCommunicator_, &base, &window_);
+    MPI_Info_free(&info);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+
+    segment_ = Impl::CommSharedSegment(base, nodeSize);
+    segment_.initialize();
+    buffers_[0] = segment_.buffers();
+    buffers_[1] = buffers_[0]+bufferSize_[0];
+
+    // forward communication (d==1) sends from buffer 0, backward from buffer 1
+    for(int n=0; n<nodeSize; ++n) {
+      InformationMap::const_iterator message = messageInformation_.find(ranks[n]);
+      if(message == messageInformation_.end())
+        continue;
+      segment_.offset(1, n) = buffers_[0] - base + message->second.first.start_*sizeof(Type);
+      segment_.offset(0, n) = buffers_[1] - base + message->second.second.start_*sizeof(Type);
+    }
+
+    // wait until the control blocks of all processes of the node are set up
+    MPI_Win_sync(window_);
+    MPI_Barrier(nodeCommunicator_);
+    MPI_Win_sync(window_);
+
+    for(int n=0; n<nodeSize; ++n) {
+      InformationMap::const_iterator message = messageInformation_.find(ranks[n]);
+      if(message == messageInformation_.end())
+        continue;
+      MPI_Aint segmentSize;
+      int unit;
+      char* neighbourBase;
+      MPI_Win_shared_query(window_, n, &segmentSize, &unit, &neighbourBase);
+
+      SharedNeighbour neighbour;
+      neighbour.process = ranks[n];
+      neighbour.nodeRank = n;
+      neighbour.segment = Impl::CommSharedSegment(neighbourBase, nodeSize);
+      for(int d=0; d<2; ++d) {
+        const bool forward = d==1;
+        const MessageInformation& recvInfo = forward ? message->second.second : message->second.first;
+        const MessageInformation& sendInfo = forward ? message->second.first : message->second.second;
+        neighbour.send[d] = sendInfo.size_ > 0;
+        neighbour.recv[d] = recvInfo.size_ ? neighbourBase + neighbour.segment.offset(d, nodeRank_) : nullptr;
+      }
+      sharedNeighbours_.push_back(neighbour);
+    }
+    sequence_[0]=sequence_[1]=0;
+  }
+
+  inline void BufferedCommunicator::freeBuffers()
+  {
+    if(window_ == MPI_WIN_NULL) {
+      if(buffers_[0])
+        delete[] buffers_[0];
 
-    if(buffers_[1])
-      delete[] buffers_[1];
+      if(buffers_[1])
+        delete[] buffers_[1];
+    }
+    else{
+      int finalized=0;
+      MPI_Finalized(&finalized);
+      if(!finalized) {
+        // the neighbours on the node may still read from the buffers
+        MPI_Barrier(nodeCommunicator_);
+        MPI_Win_unlock_all(window_);
+        MPI_Win_free(&window_);
+        MPI_Comm_free(&nodeCommunicator_);
+      }
+      window_ = MPI_WIN_NULL;
+      nodeCommunicator_ = MPI_COMM_NULL;
+      sharedNeighbours_.clear();
+    }
     buffers_[0]=buffers_[1]=0;
   }
 
+  inline void BufferedCommunicator::profileMessages(bool forward, bool send) const
+  {
+#if DUNE_COMMUNICATION_PROFILING
+    for(const auto& message : messageInformation_) {
+      const MessageInformation& info = forward == send ? message.second.first : message.second.second;
+      if(!info.size_)
+        continue;
+      if(send)
+        Impl::commProfileSent(CommunicationProfile::bufferedCommunicator, message.first, info.size_);
+      else
+        Impl::commProfileReceived(CommunicationProfile::bufferedCommunicator, message.first, info.size_);
+    }
+#else
+    DUNE_UNUSED_PARAMETER(forward);
+    DUNE_UNUSED_PARAMETER(send);
+#endif
+  }
+
+  template<class Type>
+  void BufferedCommunicator::createDatatypes()
+  {
+    const MPI_Datatype entry = MPITraits<Type>::getType();
+    if(datatypesEntry_ == entry)
+      return;
+    freeDatatypes();
+
+    std::vector<int> lengths;
+    std::vector<MPI_Aint> displacements;
+    auto create = [&](const InterfaceInformation& info, std::vector<MPI_Datatype>& types)
+    {
+      lengths.assign(info.size(), 1);
+      displacements.resize(info.size());
+      for(std::size_t i=0; i<info.size(); ++i)
+        displacements[i] = info[i]*sizeof(Type);
+      types.push_back(MPI_DATATYPE_NULL);
+      MPI_Type_create_hindexed(info.size(), lengths.data(), displacements.data(), entry, &types.back());
+      MPI_Type_commit(&types.back());
+    };
+
+    for(int d=0; d<2; ++d) {
+      const bool forward = d==1;
+      for(int proc : sendProcesses_[d]) {
+        const auto& interfacePair = interfaces_.find(proc)->second;
+        create(forward ? interfacePair.first : interfacePair.second, sendTypes_[d]);
+      }
+      for(int proc : recvProcesses_[d]) {
+        const auto& interfacePair = interfaces_.find(proc)->second;
+        create(forward ? interfacePair.second : interfacePair.first, recvTypes_[d]);
+      }
+
+      std::vector<std::size_t> sent, received;
+      for(const auto& interfacePair : interfaces_) {
+        const InterfaceInformation& send = forward ? interfacePair.second.first : interfacePair.second.second;
+        const InterfaceInformation& recv = forward ? interfacePair.second.second : interfacePair.second.first;
+        for(std::size_t i=0; i<send.size(); ++i)
+          sent.push_back(send[i]);
+        for(std::size_t i=0; i<recv.size(); ++i)
+          received.push_back(recv[i]);
+      }
+      std::sort(sent.begin(), sent.end());
+      std::sort(received.begin(), received.end());
+      sharedEntries_[d] = false;
+      for(auto s = sent.begin(), r = received.begin(); s != sent.end() && r != received.end(); ) {
+        if(*s == *r) {
+          sharedEntries_[d] = true;
+          break;
+        }
+        if(*s < *r)
+          ++s;
+        else
+          ++r;
+      }
+    }
+    datatypesEntry_ = entry;
+  }
+
+  inline void BufferedCommunicator::freeDatatypes()
+  {
+    int finalized=0;
+    MPI_Finalized(&finalized);
+    for(int d=0; d<2; ++d) {
+      if(!finalized) {
+        for(MPI_Datatype& type : sendTypes_[d])
+          MPI_Type_free(&type);
+        for(MPI_Datatype& type : recvTypes_[d])
+          MPI_Type_free(&type);
+      }
+      sendTypes_[d].clear();
+      recvTypes_[d].clear();
+    }
+    datatypesEntry_ = MPI_DATATYPE_NULL;
+  }
+
+  inline void BufferedCommunicator::free()
+  {
+    cancelPending();
+    freeRequests();
+    freeDatatypes();
+    messageInformation_.clear();
+    freeBuffers();
+  }
+
   inline BufferedCommunicator::~BufferedCommunicator()
   {
     free();
@@ -1389,153 +2282,223 @@ namespace Dune
   }
 
 
+  template<class GatherScatter, class Data>
+  void BufferedCommunicator::forwardBegin(const Data& source)
+  {
+    this->template sendRecvBegin<GatherScatter,true>(source);
+  }
+
+
+  template<class GatherScatter, class Data>
+  void BufferedCommunicator::forwardEnd(Data& dest)
+  {
+    this->template sendRecvEnd<GatherScatter,true>(dest);
+  }
+
+
+  template<class GatherScatter, class Data>
+  void BufferedCommunicator::backwardBegin(const Data& dest)
+  {
+    this->template sendRecvBegin<GatherScatter,false>(dest);
+  }
+
+
+  template<class GatherScatter, class Data>
+  void BufferedCommunicator::backwardEnd(Data& source)
+  {
+    this->template sendRecvEnd<GatherScatter,false>(source);
+  }
+
+
   template<class GatherScatter, bool FORWARD, class Data>
   void BufferedCommunicator::sendRecv(const Data& source, Data& dest)
   {
-    int rank, lrank;
+    this->template sendRecv<GatherScatter,FORWARD>(source, dest, Impl::CommUseDatatypes<GatherScatter,Data>());
+  }
 
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
-    MPI_Comm_rank(MPI_COMM_WORLD,&lrank);
 
+  template<class GatherScatter, bool FORWARD, class Data>
+  void BufferedCommunicator::sendRecv(const Data& source, Data& dest, std::false_type)
+  {
+    this->template sendRecvBegin<GatherScatter,FORWARD>(source);
+    this->template sendRecvEnd<GatherScatter,FORWARD>(dest);
+  }
+
+
+  template<class GatherScatter, bool FORWARD, class Data>
+  void BufferedCommunicator::sendRecv(const Data& source, Data& dest, std::true_type)
+  {
     typedef typename CommPolicy<Data>::IndexedType Type;
-    Type *sendBuffer, *recvBuffer;
-    size_t sendBufferSize;
-#ifndef NDEBUG
-    size_t recvBufferSize;
-#endif
+    if(zeroCopy_ && neighbourhoodCommunicator_ == MPI_COMM_NULL && window_ == MPI_WIN_NULL) {
+      this->template createDatatypes<Type>();
+      // entries that are sent and received have to be gathered before
+      // they are overwritten
+      if(!sharedEntries_[FORWARD ? 1 : 0] || source.data() != dest.data()) {
+        this->template datatypeSendRecv<FORWARD>(source.data(), dest.data());
+        return;
+      }
+    }
+    this->template sendRecv<GatherScatter,FORWARD>(source, dest, std::false_type());
+  }
 
-    if(FORWARD) {
-      sendBuffer = reinterpret_cast<Type*>(buffers_[0]);
-      sendBufferSize = bufferSize_[0];
-      recvBuffer = reinterpret_cast<Type*>(buffers_[1]);
-#ifndef NDEBUG
-      recvBufferSize = bufferSize_[1];
-#endif
-    }else{
-      sendBuffer = reinterpret_cast<Type*>(buffers_[1]);
-      sendBufferSize = bufferSize_[1];
-      recvBuffer = reinterpret_cast<Type*>(buffers_[0]);
-#ifndef NDEBUG
-      recvBufferSize = bufferSize_[0];
-#endif
+
+  template<bool FORWARD, class Type>
+  void BufferedCommunicator::datatypeSendRecv(const Type* source, Type* dest)
+  {
+    if(pending_ != noCommunication)
+      DUNE_THROW(InvalidStateException, "The previous communication has not been completed!");
+
+    Impl::CommProfileScope profile(CommunicationProfile::bufferedCommunicator);
+    profileMessages(FORWARD, true);
+    profileMessages(FORWARD, false);
+
+    const int d = FORWARD ? 1 : 0;
+    const std::size_t noRecv = recvProcesses_[d].size();
+    const std::size_t noSend = sendProcesses_[d].size();
+    datatypeRequests_.resize(noRecv+noSend);
+
+    // Post the receives first, then the sends
+    for(std::size_t i=0; i<noRecv; ++i)
+      MPI_Irecv(dest, 1, recvTypes_[d][i], recvProcesses_[d][i], commTag_,
+                communicator_, &datatypeRequests_[i]);
+    for(std::size_t i=0; i<noSend; ++i)
+      MPI_Isend(const_cast<Type*>(source), 1, sendTypes_[d][i], sendProcesses_[d][i], commTag_,
+                communicator_, &datatypeRequests_[noRecv+i]);
+
+    if(MPI_SUCCESS!=MPI_Waitall(datatypeRequests_.size(), datatypeRequests_.data(), MPI_STATUSES_IGNORE)) {
+      int rank;
+      MPI_Comm_rank(communicator_, &rank);
+      std::cerr<<rank<<": MPI_Error occurred while communicating with datatypes"<<std::endl;
     }
+  }
+
+
+  template<class GatherScatter, bool FORWARD, class Data>
+  void BufferedCommunicator::sendRecvBegin(const Data& source)
+  {
+    if(pending_ != noCommunication)
+      DUNE_THROW(InvalidStateException, "The previous communication has not been completed!");
+
+    Impl::CommProfileScope profile(CommunicationProfile::bufferedCommunicator);
+    profileMessages(FORWARD, true);
+
+    typedef typename CommPolicy<Data>::IndexedType Type;
     typedef typename CommPolicy<Data>::IndexedTypeFlag Flag;
+    const int d = FORWARD ? 1 : 0;
+    Type* sendBuffer = reinterpret_cast<Type*>(buffers_[FORWARD ? 0 : 1]);
+    size_t sendBufferSize = bufferSize_[FORWARD ? 0 : 1];
 
-    MessageGatherer<Data,GatherScatter,FORWARD,Flag>() (interfaces_, source, sendBuffer, sendBufferSize);
+    // the neighbours on the node have to have read the previous message
+    // before it is overwritten
+    for(const SharedNeighbour& neighbour : sharedNeighbours_)
+      if(neighbour.send[d])
+        Impl::commWaitFor(neighbour.segment.consumed(d, nodeRank_), sequence_[d]);
 
-    MPI_Request* sendRequests = new MPI_Request[messageInformation_.size()];
-    MPI_Request* recvRequests = new MPI_Request[messageInformation_.size()];
-    /* Number of recvRequests that are not MPI_REQUEST_NULL */
-    size_t numberOfRealRecvRequests = 0;
+    {
+      Impl::CommProfileTimer timer(CommunicationProfile::bufferedCommunicator, CommunicationProfile::packTime);
+      MessageGatherer<Data,GatherScatter,FORWARD,Flag>() (interfaces_, source, sendBuffer, sendBufferSize);
+    }
 
-    // Setup receive first
-    typedef typename InformationMap::const_iterator const_iterator;
+    if(window_ != MPI_WIN_NULL) {
+      ++sequence_[d];
+      MPI_Win_sync(window_);
+      segment_.published(d).store(sequence_[d], std::memory_order_release);
+    }
 
-    const const_iterator end = messageInformation_.end();
-    size_t i=0;
-    int* processMap = new int[messageInformation_.size()];
-
-    for(const_iterator info = messageInformation_.begin(); info != end; ++info, ++i) {
-      processMap[i]=info->first;
-      if(FORWARD) {
-        assert(info->second.second.start_*sizeof(typename CommPolicy<Data>::IndexedType)+info->second.second.size_ <= recvBufferSize );
-        Dune::dvverb<<rank<<": receiving "<<info->second.second.size_<<" from "<<info->first<<std::endl;
-        if(info->second.second.size_) {
-          MPI_Irecv(recvBuffer+info->second.second.start_, info->second.second.size_,
-                    MPI_BYTE, info->first, commTag_, communicator_,
-                    recvRequests+i);
-          numberOfRealRecvRequests += 1;
-        } else {
-          // Nothing to receive -> set request to inactive
-          recvRequests[i]=MPI_REQUEST_NULL;
-        }
-      }else{
-        assert(info->second.first.start_*sizeof(typename CommPolicy<Data>::IndexedType)+info->second.first.size_ <= recvBufferSize );
-        Dune::dvverb<<rank<<": receiving "<<info->second.first.size_<<" to "<<info->first<<std::endl;
-        if(info->second.first.size_) {
-          MPI_Irecv(recvBuffer+info->second.first.start_, info->second.first.size_,
-                    MPI_BYTE, info->first, commTag_, communicator_,
-                    recvRequests+i);
-          numberOfRealRecvRequests += 1;
-        } else {
-          // Nothing to receive -> set request to inactive
-          recvRequests[i]=MPI_REQUEST_NULL;
-        }
-      }
+    if(neighbourhoodCommunicator_ != MPI_COMM_NULL) {
+#if MPI_VERSION >= 4
+      MPI_Start(&neighbourhoodRequests_[d]);
+#else
+      MPI_Ineighbor_alltoallv(buffers_[FORWARD ? 0 : 1], sendCounts_[d].data(), sendDisplacements_[d].data(),
+                              neighbourhoodType_, buffers_[FORWARD ? 1 : 0], recvCounts_[d].data(),
+                              recvDisplacements_[d].data(), neighbourhoodType_, neighbourhoodCommunicator_,
+                              &neighbourhoodRequests_[d]);
+#endif
     }
 
-    // now the send requests
-    i=0;
-    for(const_iterator info = messageInformation_.begin(); info != end; ++info, ++i)
-      if(FORWARD) {
-        assert(info->second.second.start_*sizeof(typename CommPolicy<Data>::IndexedType)+info->second.second.size_ <= recvBufferSize );
-        Dune::dvverb<<rank<<": sending "<<info->second.first.size_<<" to "<<info->first<<std::endl;
-        assert(info->second.first.start_*sizeof(typename CommPolicy<Data>::IndexedType)+info->second.first.size_ <= sendBufferSize );
-        if(info->second.first.size_)
-          MPI_Issend(sendBuffer+info->second.first.start_, info->second.first.size_,
-                     MPI_BYTE, info->first, commTag_, communicator_,
-                     sendRequests+i);
-        else
-          // Nothing to send -> set request to inactive
-          sendRequests[i]=MPI_REQUEST_NULL;
-      }else{
-        assert(info->second.second.start_*sizeof(typename CommPolicy<Data>::IndexedType)+info->second.second.size_ <= sendBufferSize );
-        Dune::dvverb<<rank<<": sending "<<info->second.second.size_<<" to "<<info->first<<std::endl;
-        if(info->second.second.size_)
-          MPI_Issend(sendBuffer+info->second.second.start_, info->second.second.size_,
-                     MPI_BYTE, info->first, commTag_, communicator_,
-                     sendRequests+i);
-        else
-          // Nothing to send -> set request to inactive
-          sendRequests[i]=MPI_REQUEST_NULL;
+    // Start the receives first, then the sends
+    if(!recvRequests_[d].empty())
+      MPI_Startall(recvRequests_[d].size(), recvRequests_[d].data());
+    if(!sendRequests_[d].empty())
+      MPI_Startall(sendRequests_[d].size(), sendRequests_[d].data());
+
+    pending_ = FORWARD ? forwardCommunication : backwardCommunication;
+  }
+
+
+  template<class GatherScatter, bool FORWARD, class Data>
+  void BufferedCommunicator::sendRecvEnd(Data& dest)
+  {
+    if(pending_ != (FORWARD ? forwardCommunication : backwardCommunication))
+      DUNE_THROW(InvalidStateException, "No " << (FORWARD ? "forward" : "backward")
+                 << " communication has been started!");
+
+    Impl::CommProfileScope profile(CommunicationProfile::bufferedCommunicator, false);
+    profileMessages(FORWARD, false);
+
+    int rank;
+    MPI_Comm_rank(communicator_, &rank);
+
+    typedef typename CommPolicy<Data>::IndexedType Type;
+    typedef typename CommPolicy<Data>::IndexedTypeFlag Flag;
+    const int d = FORWARD ? 1 : 0;
+    Type* recvBuffer = reinterpret_cast<Type*>(buffers_[FORWARD ? 1 : 0]);
+
+    if(neighbourhoodCommunicator_ != MPI_COMM_NULL) {
+      if(MPI_SUCCESS!=MPI_Wait(&neighbourhoodRequests_[d], MPI_STATUS_IGNORE))
+        std::cerr<<rank<<": MPI_Error occurred in the neighbourhood collective"<<std::endl;
+      typename InformationMap::const_iterator info = messageInformation_.begin();
+      Impl::CommProfileTimer timer(CommunicationProfile::bufferedCommunicator, CommunicationProfile::unpackTime);
+      for(std::size_t i=0; i<recvCounts_[d].size(); ++i, ++info)
+        if(recvCounts_[d][i])
+          MessageScatterer<Data,GatherScatter,FORWARD,Flag>() (interfaces_, dest, recvBuffer+recvDisplacements_[d][i], info->first);
+      pending_ = noCommunication;
+      return;
+    }
+
+    // Scatter the data of the neighbours on the node from their buffers
+    for(const SharedNeighbour& neighbour : sharedNeighbours_)
+      if(neighbour.recv[d]) {
+        Impl::commWaitFor(neighbour.segment.published(d), sequence_[d]);
+        MPI_Win_sync(window_);
+        Impl::CommProfileTimer timer(CommunicationProfile::bufferedCommunicator, CommunicationProfile::unpackTime);
+        MessageScatterer<Data,GatherScatter,FORWARD,Flag>() (interfaces_, dest,
+                                                              reinterpret_cast<Type*>(const_cast<char*>(neighbour.recv[d])),
+                                                              neighbour.process);
+        segment_.consumed(d, neighbour.nodeRank).store(sequence_[d], std::memory_order_release);
       }
 
     // Wait for completion of receive and immediately start scatter
-    i=0;
-    //int success = 1;
     int finished = MPI_UNDEFINED;
-    MPI_Status status; //[messageInformation_.size()];
-    //MPI_Waitall(messageInformation_.size(), recvRequests, status);
+    MPI_Status status;
 
-    for(i=0; i< numberOfRealRecvRequests; i++) {
+    for(size_t i=0; i< recvRequests_[d].size(); i++) {
       status.MPI_ERROR=MPI_SUCCESS;
-      MPI_Waitany(messageInformation_.size(), recvRequests, &finished, &status);
+      MPI_Waitany(recvRequests_[d].size(), recvRequests_[d].data(), &finished, &status);
       assert(finished != MPI_UNDEFINED);
 
+      const int proc = recvProcesses_[d][finished];
       if(status.MPI_ERROR==MPI_SUCCESS) {
-        int& proc = processMap[finished];
         typename InformationMap::const_iterator infoIter = messageInformation_.find(proc);
         assert(infoIter != messageInformation_.end());
 
-        MessageInformation info = (FORWARD) ? infoIter->second.second : infoIter->second.first;
-        assert(info.start_+info.size_ <= recvBufferSize);
+        const MessageInformation& info = (FORWARD) ? infoIter->second.second : infoIter->second.first;
+        assert(info.start_*sizeof(Type)+info.size_ <= bufferSize_[FORWARD ? 1 : 0]);
 
+        Impl::CommProfileTimer timer(CommunicationProfile::bufferedCommunicator, CommunicationProfile::unpackTime);
         MessageScatterer<Data,GatherScatter,FORWARD,Flag>() (interfaces_, dest, recvBuffer+info.start_, proc);
       }else{
-        std::cerr<<rank<<": MPI_Error occurred while receiving message from "<<processMap[finished]<<std::endl;
-        //success=0;
+        std::cerr<<rank<<": MPI_Error occurred while receiving message from "<<proc<<std::endl;
       }
     }
 
-    MPI_Status recvStatus;
-
     // Wait for completion of sends
-    for(i=0; i< messageInformation_.size(); i++)
-      if(MPI_SUCCESS!=MPI_Wait(sendRequests+i, &recvStatus)) {
-        std::cerr<<rank<<": MPI_Error occurred while sending message to "<<processMap[finished]<<std::endl;
-        //success=0;
+    for(size_t i=0; i< sendRequests_[d].size(); i++)
+      if(MPI_SUCCESS!=MPI_Wait(&sendRequests_[d][i], MPI_STATUS_IGNORE)) {
+        std::cerr<<rank<<": MPI_Error occurred while sending message to "<<sendProcesses_[d][i]<<std::endl;
       }
-    /*
-       int globalSuccess;
-       MPI_Allreduce(&success, &globalSuccess, 1, MPI_INT, MPI_MIN, interface_->communicator());
-
-       if(!globalSuccess)
-       DUNE_THROW(CommunicationError, "A communication error occurred!");
-     */
-    delete[] processMap;
-    delete[] sendRequests;
-    delete[] recvRequests;
 
+    pending_ = noCommunication;
   }
 
 #endif  // DOXYGEN
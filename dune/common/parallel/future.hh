@@ -0,0 +1,242 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_COMMON_PARALLEL_FUTURE_HH
+#define DUNE_COMMON_PARALLEL_FUTURE_HH
+
+/*!
+   \file
+   \brief Futures returned by the nonblocking collective communication
+   of the sequential CollectiveCommunication.
+
+   \ingroup ParallelCommunication
+ */
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/typetraits.hh>
+
+namespace Dune
+{
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // The data a nonblocking communication works on. If the data was
+    // passed as an lvalue, T is a reference and the data is referred to,
+    // otherwise it is moved into the future.
+    template<class T>
+    struct FutureData
+    {
+      template<class U>
+      explicit FutureData(U&& data)
+        : value(std::forward<U>(data))
+      {}
+
+      T take()
+      {
+        return std::forward<T>(value);
+      }
+
+      T value;
+    };
+
+    template<>
+    struct FutureData<void>
+    {
+      void take()
+      {}
+    };
+
+    // Access to the values of the data passed to the nonblocking
+    // communication: a single value, or the entries of a contiguous
+    // container like std::vector or DynamicVector.
+    template<class T, class = void>
+    struct CollectiveData
+    {
+      typedef T value_type;
+
+      static value_type* data(T& t)
+      {
+        return &t;
+      }
+
+      static const value_type* data(const T& t)
+      {
+        return &t;
+      }
+
+      static int size(const T&)
+      {
+        return 1;
+      }
+    };
+
+    template<class T>
+    struct CollectiveData<T, void_t<decltype(std::declval<T&>().data()),
+                                    decltype(std::declval<const T&>().size())> >
+    {
+      typedef typename T::value_type value_type;
+
+      static value_type* data(T& t)
+      {
+        return t.data();
+      }
+
+      static const value_type* data(const T& t)
+      {
+        return t.data();
+      }
+
+      static int size(const T& t)
+      {
+        return t.size();
+      }
+    };
+
+    template<class T>
+    using CollectiveDataOf = CollectiveData<typename std::decay<T>::type>;
+
+    // copy the values of in to out, as the sequential collectives do,
+    // returns the error message if out is too small and nullptr otherwise
+    template<class TIn, class TOut>
+    const char* copyCollectiveData(const TIn& in, TOut& out, const char* error)
+    {
+      const int n = CollectiveDataOf<TIn>::size(in);
+      if(CollectiveDataOf<TOut>::size(out) < n)
+        return error;
+      std::copy_n(CollectiveDataOf<TIn>::data(in), n, CollectiveDataOf<TOut>::data(out));
+      return nullptr;
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
+  /**
+   * @brief The future returned by the nonblocking collective
+   * communication of the sequential CollectiveCommunication.
+   *
+   * It has the same interface as MPIFuture, but is ready on construction.
+   * Like MPIFuture, it reports an output that is too small by throwing
+   * RangeError from wait() and get(), not when the communication starts.
+   *
+   * @tparam T The type of the result. If it is a reference, the
+   * communication worked in place on data of the caller.
+   * @ingroup ParallelCommunication
+   */
+  template<class T>
+  class PseudoFuture
+  {
+  public:
+    //! Construct an invalid future.
+    PseudoFuture() = default;
+
+    /**
+     * @brief Construct a ready future with the result data.
+     *
+     * @param data The result data.
+     * @param error If not nullptr, the message of the RangeError thrown by
+     * wait() and get().
+     */
+    template<class U>
+    explicit PseudoFuture(U&& data, const char* error = nullptr)
+      : data_(new Impl::FutureData<T>(std::forward<U>(data))), error_(error)
+    {}
+
+    //! Whether the future has a result that was not yet retrieved.
+    bool valid() const
+    {
+      return data_ != nullptr;
+    }
+
+    //! Whether the communication is completed, always true.
+    bool ready() const
+    {
+      return true;
+    }
+
+    /**
+     * @brief Wait until the communication is completed.
+     *
+     * @throw RangeError if the output was too small, the future is no
+     * longer valid afterwards.
+     */
+    void wait()
+    {
+      if(!valid())
+        DUNE_THROW(InvalidStateException, "The future is not valid!");
+      if(error_)
+      {
+        const char* error = error_;
+        error_ = nullptr;
+        data_.reset();
+        DUNE_THROW(RangeError, error);
+      }
+    }
+
+    /**
+     * @brief Retrieve the result.
+     *
+     * Afterwards the future is no longer valid.
+     */
+    T get()
+    {
+      wait();
+      std::unique_ptr<Impl::FutureData<T> > data = std::move(data_);
+      return data->take();
+    }
+
+  private:
+    std::unique_ptr<Impl::FutureData<T> > data_;
+    const char* error_ = nullptr;
+  };
+
+  /**
+   * @brief The future of a sequential communication without result.
+   * @ingroup ParallelCommunication
+   */
+  template<>
+  class PseudoFuture<void>
+  {
+  public:
+    //! Construct a future, which is ready if valid is true.
+    explicit PseudoFuture(bool valid = false)
+      : valid_(valid)
+    {}
+
+    //! @copydoc PseudoFuture::valid()
+    bool valid() const
+    {
+      return valid_;
+    }
+
+    //! @copydoc PseudoFuture::ready()
+    bool ready() const
+    {
+      return true;
+    }
+
+    //! @copydoc PseudoFuture::wait()
+    void wait()
+    {
+      if(!valid())
+        DUNE_THROW(InvalidStateException, "The future is not valid!");
+    }
+
+    //! Wait until the communication is completed and invalidate the future.
+    void get()
+    {
+      wait();
+      valid_ = false;
+    }
+
+  private:
+    bool valid_;
+  };
+
+} // end namespace Dune
+
+#endif // DUNE_COMMON_PARALLEL_FUTURE_HH
@@ -4,8 +4,17 @@
 #define DUNE_INDEXSET_HH
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <dune/common/arraylist.hh>
 #include <dune/common/exceptions.hh>
+#include <dune/common/genericiterator.hh>
+#include <dune/common/typetraits.hh>
 #include <dune/common/unused.hh>
 #include <iostream>
 
@@ -203,6 +212,260 @@ namespace Dune
    */
   class InvalidIndexSetState : public InvalidStateException {};
 
+  /**
+   * @brief Storage policy of ParallelIndexSet that keeps the index pairs in
+   * an ArrayList of arrays with N pairs each.
+   *
+   * This is the default policy.
+   */
+  struct ArrayListIndexStorage {};
+
+  /**
+   * @brief Storage policy of ParallelIndexSet that keeps the index pairs in
+   * one contiguous array.
+   *
+   * Iterating over the pairs and looking them up does not have to find the
+   * array of a pair first, and endResize() moves the added pairs instead of
+   * copying them. In contrast to the ArrayList the array has to be
+   * reallocated while indices are added, and copies of the index set do not
+   * share the pairs. The template parameter N of the index set is ignored.
+   */
+  struct ContiguousIndexStorage {};
+
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // one contiguous array of index pairs, providing the part of the
+    // interface of ArrayList used by ParallelIndexSet
+    template<class T>
+    class ContiguousIndexArray
+    {
+    public:
+      typedef GenericIterator<ContiguousIndexArray<T>, T> iterator;
+      typedef GenericIterator<const ContiguousIndexArray<T>, const T> const_iterator;
+
+      ContiguousIndexArray() = default;
+
+      explicit ContiguousIndexArray(std::vector<T>&& pairs)
+        : pairs_(std::move(pairs))
+      {}
+
+      iterator begin()
+      {
+        return iterator(*this, 0);
+      }
+
+      iterator end()
+      {
+        return iterator(*this, pairs_.size());
+      }
+
+      const_iterator begin() const
+      {
+        return const_iterator(*this, 0);
+      }
+
+      const_iterator end() const
+      {
+        return const_iterator(*this, pairs_.size());
+      }
+
+      T& operator[](std::size_t i)
+      {
+        return pairs_[i];
+      }
+
+      const T& operator[](std::size_t i) const
+      {
+        return pairs_[i];
+      }
+
+      std::size_t size() const
+      {
+        return pairs_.size();
+      }
+
+      void push_back(const T& pair)
+      {
+        pairs_.push_back(pair);
+      }
+
+      void clear()
+      {
+        pairs_ = std::vector<T>();
+      }
+
+      // move the pairs out of the array and leave it empty
+      std::vector<T> release()
+      {
+        std::vector<T> pairs;
+        pairs.swap(pairs_);
+        return pairs;
+      }
+
+    private:
+      std::vector<T> pairs_;
+    };
+
+    template<class T, int N, class S>
+    struct IndexSetStorage;
+
+    template<class T, int N>
+    struct IndexSetStorage<T,N,ArrayListIndexStorage>
+    {
+      typedef ArrayList<T,N> type;
+    };
+
+    template<class T, int N>
+    struct IndexSetStorage<T,N,ContiguousIndexStorage>
+    {
+      typedef ContiguousIndexArray<T> type;
+    };
+
+    // move the pairs of a storage into one contiguous vector
+    template<class T, int N, class A>
+    std::vector<T> releaseIndexPairs(ArrayList<T,N,A>& storage)
+    {
+      std::vector<T> pairs(storage.begin(), storage.end());
+      storage.clear();
+      return pairs;
+    }
+
+    template<class T>
+    std::vector<T> releaseIndexPairs(ContiguousIndexArray<T>& storage)
+    {
+      return storage.release();
+    }
+
+    // replace the pairs of a storage
+    template<class T, int N, class A>
+    void assignIndexPairs(ArrayList<T,N,A>& storage, std::vector<T>&& pairs)
+    {
+      // free the old chunks before allocating the new ones
+      storage.clear();
+      for(const T& pair : pairs)
+        storage.push_back(pair);
+      pairs = std::vector<T>();
+    }
+
+    template<class T>
+    void assignIndexPairs(ContiguousIndexArray<T>& storage, std::vector<T>&& pairs)
+    {
+      storage = ContiguousIndexArray<T>(std::move(pairs));
+    }
+
+    // whether std::hash can be used for the global index type
+    template<class TG, class = void>
+    struct IsIndexSetHashable : std::false_type {};
+
+    template<class TG>
+    struct IsIndexSetHashable<TG, void_t<decltype(std::hash<TG>()(std::declval<const TG&>()))> >
+      : std::true_type {};
+
+    /*
+     * Open addressing hash table with linear probing that maps global
+     * indices to the position of their pair in the sorted array of an
+     * index set.  The global index is stored next to the position, so a
+     * successful lookup usually touches a single cache line.  Integral
+     * global indices are hashed by Fibonacci hashing, which spreads
+     * consecutive indices evenly over the table, all other types by
+     * std::hash.
+     */
+    template<class TG>
+    class IndexSetHashTable
+    {
+    public:
+      static constexpr bool supported
+        = std::is_integral<TG>::value || IsIndexSetHashable<TG>::value;
+
+      static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+      // fill the table with the global indices of a sorted container of
+      // index pairs, the first pair wins for repeated global indices
+      template<class C>
+      void build(const C& pairs)
+      {
+        const std::size_t size = pairs.size();
+        std::size_t capacity = 2;
+        shift_ = 63;
+        // keep the load factor below 3/4
+        while(4*size > 3*capacity) {
+          capacity *= 2;
+          --shift_;
+        }
+        mask_ = capacity-1;
+        table_.assign(capacity, Entry{TG(), npos});
+
+        std::size_t position = 0;
+        for(auto pair = pairs.begin(); pair != pairs.end(); ++pair, ++position) {
+          std::size_t i = bucket(pair->global());
+          while(table_[i].position != npos && !(table_[i].global == pair->global()))
+            i = (i+1) & mask_;
+          if(table_[i].position == npos)
+            table_[i] = Entry{pair->global(), position};
+        }
+      }
+
+      void clear()
+      {
+        table_ = std::vector<Entry>();
+      }
+
+      // position of the pair with the global index or npos
+      std::size_t find(const TG& global) const
+      {
+        if(table_.empty())
+          return npos;
+        for(std::size_t i = bucket(global); ; i = (i+1) & mask_) {
+          const Entry& entry = table_[i];
+          if(entry.position == npos || entry.global == global)
+            return entry.position;
+        }
+      }
+
+    private:
+      struct Entry
+      {
+        TG global;
+        std::size_t position;
+      };
+
+      static std::uint64_t key(const TG& global, std::true_type)
+      {
+        return static_cast<std::uint64_t>(global);
+      }
+
+      static std::uint64_t key(const TG& global, std::false_type)
+      {
+        return hashKey(global, IsIndexSetHashable<TG>());
+      }
+
+      static std::uint64_t hashKey(const TG& global, std::true_type)
+      {
+        return std::hash<TG>()(global);
+      }
+
+      // never called, ParallelIndexSet refuses to enable the lookup
+      static std::uint64_t hashKey(const TG&, std::false_type)
+      {
+        return 0;
+      }
+
+      std::size_t bucket(const TG& global) const
+      {
+        // 2^64 divided by the golden ratio
+        const std::uint64_t h = key(global, std::is_integral<TG>()) * UINT64_C(0x9E3779B97F4A7C15);
+        return static_cast<std::size_t>(h >> shift_);
+      }
+
+      std::vector<Entry> table_;
+      std::size_t mask_ = 0;
+      unsigned shift_ = 63;
+    };
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
   // Forward declaration
   template<class I> class GlobalLookupIndexSet;
 
@@ -212,10 +475,10 @@ namespace Dune
    * The mapping is between a globally unique id and local index. The local index is consecutive
    * and non persistent while the global id might not be consecutive but definitely is persistent.
    */
-  template<typename TG, typename TL, int N=100>
+  template<typename TG, typename TL, int N=100, typename S=ArrayListIndexStorage>
   class ParallelIndexSet
   {
-    friend class GlobalLookupIndexSet<ParallelIndexSet<TG,TL,N> >;
+    friend class GlobalLookupIndexSet<ParallelIndexSet<TG,TL,N,S> >;
 
   public:
     /**
@@ -252,15 +515,25 @@ namespace Dune
       arraySize= (N>0) ? N : 1
     };
 
+    /**
+     * @brief The storage policy of the pairs.
+     * @see ArrayListIndexStorage, ContiguousIndexStorage
+     */
+    typedef S StoragePolicy;
+
+  private:
+    typedef typename Impl::IndexSetStorage<IndexPair,N,S>::type Storage;
+
+  public:
     /** @brief The iterator over the pairs. */
     class iterator :
-      public ArrayList<IndexPair,N>::iterator
+      public Storage::iterator
     {
-      typedef typename ArrayList<IndexPair,N>::iterator
+      typedef typename Storage::iterator
       Father;
-      friend class ParallelIndexSet<GlobalIndex,LocalIndex,N>;
+      friend class ParallelIndexSet<GlobalIndex,LocalIndex,N,S>;
     public:
-      iterator(ParallelIndexSet<TG,TL,N>& indexSet, const Father& father)
+      iterator(ParallelIndexSet<TG,TL,N,S>& indexSet, const Father& father)
         : Father(father), indexSet_(&indexSet)
       {}
 
@@ -295,7 +568,7 @@ namespace Dune
       }
 
       /** @brief The index set we are an iterator of. */
-      ParallelIndexSet<TG,TL,N>* indexSet_;
+      ParallelIndexSet<TG,TL,N,S>* indexSet_;
 
     };
 
@@ -303,7 +576,7 @@ namespace Dune
 
     /** @brief The constant iterator over the pairs. */
     typedef typename
-    ArrayList<IndexPair,N>::const_iterator
+    Storage::const_iterator
     const_iterator;
 
     /**
@@ -370,11 +643,36 @@ namespace Dune
      */
     void endResize();
 
+    /**
+     * @brief Enable or disable the hash table for the lookup of global indices.
+     *
+     * By default operator[] and at() perform a binary search. With the hash
+     * lookup enabled, endResize() additionally builds an open addressing
+     * hash table that maps each global index to its pair. A lookup of a
+     * known global index then has constant expected complexity. The price is
+     * the time needed to fill the table in endResize() and between 4/3 and
+     * 8/3 table entries, each a global index and a std::size_t, per pair.
+     *
+     * Enabling the lookup builds the table for the current indices. Global
+     * indices that are not in the set are still handled by the binary search,
+     * i.e. at() throws a RangeError for them.
+     * @param enable Whether to use the hash table.
+     * @exception NotImplemented If the global index is neither integral nor
+     * supported by std::hash.
+     */
+    void setHashLookup(bool enable);
+
+    /**
+     * @brief Whether the global indices are looked up in a hash table.
+     * @see setHashLookup()
+     */
+    inline bool hashLookup() const;
+
     /**
      * @brief Find the index pair with a specific global id.
      *
      * This starts a binary search for the entry and therefore has complexity
-     * log(N).
+     * log(N), unless the hash lookup is enabled.
      * @param global The globally unique id of the pair.
      * @return The pair of indices for the id.
      * @warning If the global index is not in the set a wrong or even a
@@ -387,7 +685,7 @@ namespace Dune
      * @brief Find the index pair with a specific global id.
      *
      * This starts a binary search for the entry and therefore has complexity
-     * log(N).
+     * log(N), unless the hash lookup is enabled.
      * @param global The globally unique id of the pair.
      * @return The pair of indices for the id.
      * @exception RangeError Thrown if the global id is not known.
@@ -399,7 +697,7 @@ namespace Dune
      * @brief Find the index pair with a specific global id.
      *
      * This starts a binary search for the entry and therefore has complexity
-     * log(N).
+     * log(N), unless the hash lookup is enabled.
      * @param global The globally unique id of the pair.
      * @return The pair of indices for the id.
      * @warning If the global index is not in the set a wrong or even a
@@ -412,7 +710,7 @@ namespace Dune
      * @brief Find the index pair with a specific global id.
      *
      * This starts a binary search for the entry and therefore has complexity
-     * log(N).
+     * log(N), unless the hash lookup is enabled.
      * @param global The globally unique id of the pair.
      * @return The pair of indices for the id.
      * @exception RangeError Thrown if the global id is not known.
@@ -471,20 +769,24 @@ namespace Dune
 
   private:
     /** @brief The index pairs. */
-    ArrayList<IndexPair,N> localIndices_;
+    Storage localIndices_;
     /** @brief The new indices for the RESIZE state. */
-    ArrayList<IndexPair,N> newIndices_;
+    Storage newIndices_;
     /** @brief The state of the index set. */
     ParallelIndexSetState state_;
     /** @brief Number to keep track of the number of resizes. */
     int seqNo_;
     /** @brief Whether entries were deleted in resize mode. */
     bool deletedEntries_;
+    /** @brief Whether the global indices are looked up in hashTable_. */
+    bool hashLookup_;
+    /** @brief The positions of the pairs hashed by their global index. */
+    Impl::IndexSetHashTable<TG> hashTable_;
     /**
-     * @brief Merges the _localIndices and newIndices arrays and creates a new
-     * localIndices array.
+     * @brief Merges the _localIndices array and the sorted new indices and
+     * creates a new localIndices array.
      */
-    inline void merge();
+    inline void merge(std::vector<IndexPair>&& added);
   };
 
 
@@ -493,8 +795,8 @@ namespace Dune
    * @param os The outputstream to print to.
    * @param indexSet The index set to print.
    */
-  template<class TG, class TL, int N>
-  std::ostream& operator<<(std::ostream& os, const ParallelIndexSet<TG,TL,N>& indexSet);
+  template<class TG, class TL, int N, class S>
+  std::ostream& operator<<(std::ostream& os, const ParallelIndexSet<TG,TL,N,S>& indexSet);
 
   /**
    * @brief Decorates an index set with the possibility to find a global index
@@ -551,7 +853,8 @@ namespace Dune
      * @brief Find the index pair with a specific global id.
      *
      * This starts a binary search for the entry and therefore has complexity
-     * log(N). This method is forwarded to the underlying index set.
+     * log(N), unless the hash lookup of the underlying index set is enabled.
+     * This method is forwarded to the underlying index set.
      * @param global The globally unique id of the pair.
      * @return The pair of indices for the id.
      * @exception RangeError Thrown if the global id is not known.
@@ -630,6 +933,120 @@ namespace Dune
     }
   };
 
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // An unsigned key of an integral global index with the same order.
+    template<class TG>
+    std::uint64_t radixKey(const TG& global)
+    {
+      typedef typename std::make_unsigned<TG>::type U;
+      const U sign = std::is_signed<TG>::value ? U(U(1) << (8*sizeof(TG)-1)) : U(0);
+      return static_cast<U>(static_cast<U>(global) ^ sign);
+    }
+
+    // the number of bits needed to represent x
+    inline unsigned radixBitWidth(std::uint64_t x)
+    {
+      unsigned bits = 0;
+      for(; x != 0; x >>= 1)
+        ++bits;
+      return bits;
+    }
+
+    // Least significant digit radix sort of pairs with integral global
+    // indices.  Instead of the pairs, 64 bit words holding the offset of
+    // the global index from the smallest one in the upper and the position
+    // of the pair in the lower bits are sorted by their upper bits, which
+    // moves a third of the memory per sweep and needs fewer sweeps for
+    // clustered global indices.  The pairs are gathered in sorted order at
+    // the end.
+    template<class TG, class TL>
+    void sortIndexPairs(std::vector<IndexPair<TG,TL> >& pairs, std::true_type)
+    {
+      const std::size_t size = pairs.size();
+      std::uint64_t minKey = std::numeric_limits<std::uint64_t>::max(), maxKey = 0;
+      for(const auto& pair : pairs) {
+        const std::uint64_t key = radixKey(pair.global());
+        minKey = std::min(minKey, key);
+        maxKey = std::max(maxKey, key);
+      }
+
+      const unsigned keyBits = radixBitWidth(maxKey-minKey);
+      const unsigned positionBits = radixBitWidth(size-1);
+      if(keyBits+positionBits > 63) {
+        std::sort(pairs.begin(), pairs.end(), IndexSetSortFunctor<TG,TL>());
+        return;
+      }
+
+      std::vector<std::uint64_t> words(size), buffer(size);
+      for(std::size_t i=0; i<size; ++i)
+        words[i] = ((radixKey(pairs[i].global())-minKey) << positionBits) | i;
+
+      constexpr unsigned digitBits = 11;
+      constexpr std::size_t radix = std::size_t(1) << digitBits;
+      std::vector<std::size_t> offset(radix);
+      for(unsigned shift = positionBits; shift < positionBits+keyBits; shift += digitBits) {
+        std::fill(offset.begin(), offset.end(), 0);
+        for(std::uint64_t word : words)
+          ++offset[(word >> shift) & (radix-1)];
+        // the position of the first word of each value of the digit
+        std::size_t sum = 0;
+        for(std::size_t& o : offset) {
+          const std::size_t count = o;
+          o = sum;
+          sum += count;
+        }
+        for(std::uint64_t word : words)
+          buffer[offset[(word >> shift) & (radix-1)]++] = word;
+        words.swap(buffer);
+      }
+      buffer = std::vector<std::uint64_t>();
+
+      const std::uint64_t positionMask = (std::uint64_t(1) << positionBits) - 1;
+      std::vector<IndexPair<TG,TL> > sorted;
+      sorted.reserve(size);
+      for(std::uint64_t word : words)
+        sorted.push_back(pairs[word & positionMask]);
+      pairs.swap(sorted);
+
+      // the sort is stable, pairs with the same global index still have to
+      // be ordered by their local index
+      IndexSetSortFunctor<TG,TL> less;
+      for(auto begin = pairs.begin(); begin != pairs.end(); ) {
+        auto end = begin+1;
+        while(end != pairs.end() && end->global() == begin->global())
+          ++end;
+        if(end-begin > 1)
+          std::sort(begin, end, less);
+        begin = end;
+      }
+    }
+
+    template<class TG, class TL>
+    void sortIndexPairs(std::vector<IndexPair<TG,TL> >& pairs, std::false_type)
+    {
+      std::sort(pairs.begin(), pairs.end(), IndexSetSortFunctor<TG,TL>());
+    }
+
+    // sort the pairs as IndexSetSortFunctor does, small sets and global
+    // indices that are not integral by std::sort
+    template<class TG, class TL>
+    void sortIndexPairs(std::vector<IndexPair<TG,TL> >& pairs)
+    {
+      // indices are often added in order
+      if(std::is_sorted(pairs.begin(), pairs.end(), IndexSetSortFunctor<TG,TL>()))
+        return;
+      if(pairs.size() < 1024)
+        sortIndexPairs(pairs, std::false_type());
+      else
+        sortIndexPairs(pairs, std::integral_constant<bool, std::is_integral<TG>::value
+                                                     && !std::is_same<TG,bool>::value>());
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
 
 
   template<class TG, class TL>
@@ -639,10 +1056,10 @@ namespace Dune
     return os;
   }
 
-  template<class TG, class TL, int N>
-  inline std::ostream& operator<<(std::ostream& os, const ParallelIndexSet<TG,TL,N>& indexSet)
+  template<class TG, class TL, int N, class S>
+  inline std::ostream& operator<<(std::ostream& os, const ParallelIndexSet<TG,TL,N,S>& indexSet)
   {
-    typedef typename ParallelIndexSet<TG,TL,N>::const_iterator Iterator;
+    typedef typename ParallelIndexSet<TG,TL,N,S>::const_iterator Iterator;
     Iterator end = indexSet.end();
     os<<"{";
     for(Iterator index = indexSet.begin(); index != end; ++index)
@@ -758,13 +1175,13 @@ namespace Dune
     local_=local;
   }
 
-  template<class TG, class TL, int N>
-  ParallelIndexSet<TG,TL,N>::ParallelIndexSet()
-    : state_(GROUND), seqNo_(0)
+  template<class TG, class TL, int N, class S>
+  ParallelIndexSet<TG,TL,N,S>::ParallelIndexSet()
+    : state_(GROUND), seqNo_(0), hashLookup_(false)
   {}
 
-  template<class TG, class TL, int N>
-  void ParallelIndexSet<TG,TL,N>::beginResize()
+  template<class TG, class TL, int N, class S>
+  void ParallelIndexSet<TG,TL,N,S>::beginResize()
   {
 
     // Checks in unproductive code
@@ -779,8 +1196,8 @@ namespace Dune
     deletedEntries_ = false;
   }
 
-  template<class TG, class TL, int N>
-  inline void ParallelIndexSet<TG,TL,N>::add(const GlobalIndex& global)
+  template<class TG, class TL, int N, class S>
+  inline void ParallelIndexSet<TG,TL,N,S>::add(const GlobalIndex& global)
   {
     // Checks in unproductive code
 #ifndef NDEBUG
@@ -791,8 +1208,8 @@ namespace Dune
     newIndices_.push_back(IndexPair(global));
   }
 
-  template<class TG, class TL, int N>
-  inline void ParallelIndexSet<TG,TL,N>::add(const TG& global, const TL& local)
+  template<class TG, class TL, int N, class S>
+  inline void ParallelIndexSet<TG,TL,N,S>::add(const TG& global, const TL& local)
   {
     // Checks in unproductive code
 #ifndef NDEBUG
@@ -803,8 +1220,8 @@ namespace Dune
     newIndices_.push_back(IndexPair(global,local));
   }
 
-  template<class TG, class TL, int N>
-  inline void ParallelIndexSet<TG,TL,N>::markAsDeleted(const iterator& global)
+  template<class TG, class TL, int N, class S>
+  inline void ParallelIndexSet<TG,TL,N,S>::markAsDeleted(const iterator& global)
   {
     // Checks in unproductive code
 #ifndef NDEBUG
@@ -817,8 +1234,8 @@ namespace Dune
     global.markAsDeleted();
   }
 
-  template<class TG, class TL, int N>
-  void ParallelIndexSet<TG,TL,N>::endResize() {
+  template<class TG, class TL, int N, class S>
+  void ParallelIndexSet<TG,TL,N,S>::endResize() {
     // Checks in unproductive code
 #ifndef NDEBUG
     if(state_ != RESIZE)
@@ -826,75 +1243,90 @@ namespace Dune
                  <<"in RESIZE state!");
 #endif
 
-    std::sort(newIndices_.begin(), newIndices_.end(), IndexSetSortFunctor<TG,TL>());
-    merge();
+    std::vector<IndexPair> added = Impl::releaseIndexPairs(newIndices_);
+    Impl::sortIndexPairs(added);
+    merge(std::move(added));
+    if(hashLookup_)
+      hashTable_.build(localIndices_);
     seqNo_++;
     state_ = GROUND;
   }
 
+  template<class TG, class TL, int N, class S>
+  void ParallelIndexSet<TG,TL,N,S>::setHashLookup(bool enable)
+  {
+    if(enable && !Impl::IndexSetHashTable<TG>::supported)
+      DUNE_THROW(NotImplemented, "The hash lookup needs an integral global index "
+                 <<"or a specialization of std::hash!");
+
+    hashLookup_ = enable;
+    if(hashLookup_)
+      hashTable_.build(localIndices_);
+    else
+      hashTable_.clear();
+  }
+
+  template<class TG, class TL, int N, class S>
+  inline bool ParallelIndexSet<TG,TL,N,S>::hashLookup() const
+  {
+    return hashLookup_;
+  }
+
 
-  template<class TG, class TL, int N>
-  inline void ParallelIndexSet<TG,TL,N>::merge(){
+  template<class TG, class TL, int N, class S>
+  inline void ParallelIndexSet<TG,TL,N,S>::merge(std::vector<IndexPair>&& added){
     if(localIndices_.size()==0)
     {
-      localIndices_=newIndices_;
-      newIndices_.clear();
+      Impl::assignIndexPairs(localIndices_, std::move(added));
     }
-    else if(newIndices_.size()>0 || deletedEntries_)
+    else if(added.size()>0 || deletedEntries_)
     {
-      ArrayList<IndexPair,N> tempPairs;
-      typedef typename ArrayList<IndexPair,N>::iterator iterator;
-      typedef typename ArrayList<IndexPair,N>::const_iterator const_iterator;
+      std::vector<IndexPair> tempPairs;
+      tempPairs.reserve(localIndices_.size()+added.size());
 
-      iterator old=localIndices_.begin();
-      iterator added=newIndices_.begin();
+      const_iterator old=localIndices_.begin();
       const const_iterator endold=localIndices_.end();
-      const const_iterator endadded=newIndices_.end();
+      typename std::vector<IndexPair>::const_iterator addedPair=added.cbegin();
 
-      while(old != endold && added!= endadded)
+      while(old != endold && addedPair != added.end())
       {
         if(old->local().state()==DELETED) {
-          old.eraseToHere();
+          ++old;
         }
-        else
+        else if(old->global() < addedPair->global() ||
+                (old->global() == addedPair->global()
+                 && LocalIndexComparator<TL>::compare(old->local(),addedPair->local())))
         {
-          if(old->global() < added->global() ||
-             (old->global() == added->global()
-              && LocalIndexComparator<TL>::compare(old->local(),added->local())))
-          {
-            tempPairs.push_back(*old);
-            old.eraseToHere();
-            continue;
-          }else
-          {
-            tempPairs.push_back(*added);
-            added.eraseToHere();
-          }
+          tempPairs.push_back(*old);
+          ++old;
+        }else
+        {
+          tempPairs.push_back(*addedPair);
+          ++addedPair;
         }
       }
 
-      while(old != endold)
-      {
-        if(old->local().state()!=DELETED) {
+      for(; old != endold; ++old)
+        if(old->local().state()!=DELETED)
           tempPairs.push_back(*old);
-        }
-        old.eraseToHere();
-      }
 
-      while(added!= endadded)
-      {
-        tempPairs.push_back(*added);
-        added.eraseToHere();
-      }
-      localIndices_ = tempPairs;
+      tempPairs.insert(tempPairs.end(), addedPair, added.cend());
+      added = std::vector<IndexPair>();
+      Impl::assignIndexPairs(localIndices_, std::move(tempPairs));
     }
   }
 
 
-  template<class TG, class TL, int N>
+  template<class TG, class TL, int N, class S>
   inline const IndexPair<TG,TL>&
-  ParallelIndexSet<TG,TL,N>::at(const TG& global) const
+  ParallelIndexSet<TG,TL,N,S>::at(const TG& global) const
   {
+    if(hashLookup_) {
+      const std::size_t position = hashTable_.find(global);
+      if(position != Impl::IndexSetHashTable<TG>::npos)
+        return localIndices_[position];
+    }
+
     // perform a binary search
     int low=0, high=localIndices_.size()-1, probe=-1;
 
@@ -916,10 +1348,16 @@ namespace Dune
       return localIndices_[low];
   }
 
-  template<class TG, class TL, int N>
+  template<class TG, class TL, int N, class S>
   inline const IndexPair<TG,TL>&
-  ParallelIndexSet<TG,TL,N>::operator[](const TG& global) const
+  ParallelIndexSet<TG,TL,N,S>::operator[](const TG& global) const
   {
+    if(hashLookup_) {
+      const std::size_t position = hashTable_.find(global);
+      if(position != Impl::IndexSetHashTable<TG>::npos)
+        return localIndices_[position];
+    }
+
     // perform a binary search
     int low=0, high=localIndices_.size()-1, probe=-1;
 
@@ -934,9 +1372,15 @@ namespace Dune
 
     return localIndices_[low];
   }
-  template<class TG, class TL, int N>
-  inline IndexPair<TG,TL>& ParallelIndexSet<TG,TL,N>::at(const TG& global)
+  template<class TG, class TL, int N, class S>
+  inline IndexPair<TG,TL>& ParallelIndexSet<TG,TL,N,S>::at(const TG& global)
   {
+    if(hashLookup_) {
+      const std::size_t position = hashTable_.find(global);
+      if(position != Impl::IndexSetHashTable<TG>::npos)
+        return localIndices_[position];
+    }
+
     // perform a binary search
     int low=0, high=localIndices_.size()-1, probe=-1;
 
@@ -958,9 +1402,15 @@ namespace Dune
       return localIndices_[low];
   }
 
-  template<class TG, class TL, int N>
-  inline IndexPair<TG,TL>& ParallelIndexSet<TG,TL,N>::operator[](const TG& global)
+  template<class TG, class TL, int N, class S>
+  inline IndexPair<TG,TL>& ParallelIndexSet<TG,TL,N,S>::operator[](const TG& global)
   {
+    if(hashLookup_) {
+      const std::size_t position = hashTable_.find(global);
+      if(position != Impl::IndexSetHashTable<TG>::npos)
+        return localIndices_[position];
+    }
+
     // perform a binary search
     int low=0, high=localIndices_.size()-1, probe=-1;
 
@@ -975,45 +1425,45 @@ namespace Dune
 
     return localIndices_[low];
   }
-  template<class TG, class TL, int N>
-  inline typename ParallelIndexSet<TG,TL,N>::iterator
-  ParallelIndexSet<TG,TL,N>::begin()
+  template<class TG, class TL, int N, class S>
+  inline typename ParallelIndexSet<TG,TL,N,S>::iterator
+  ParallelIndexSet<TG,TL,N,S>::begin()
   {
     return iterator(*this, localIndices_.begin());
   }
 
 
-  template<class TG, class TL, int N>
-  inline typename ParallelIndexSet<TG,TL,N>::iterator
-  ParallelIndexSet<TG,TL,N>::end()
+  template<class TG, class TL, int N, class S>
+  inline typename ParallelIndexSet<TG,TL,N,S>::iterator
+  ParallelIndexSet<TG,TL,N,S>::end()
   {
     return iterator(*this,localIndices_.end());
   }
 
-  template<class TG, class TL, int N>
-  inline typename ParallelIndexSet<TG,TL,N>::const_iterator
-  ParallelIndexSet<TG,TL,N>::begin() const
+  template<class TG, class TL, int N, class S>
+  inline typename ParallelIndexSet<TG,TL,N,S>::const_iterator
+  ParallelIndexSet<TG,TL,N,S>::begin() const
   {
     return localIndices_.begin();
   }
 
 
-  template<class TG, class TL, int N>
-  inline typename ParallelIndexSet<TG,TL,N>::const_iterator
-  ParallelIndexSet<TG,TL,N>::end() const
+  template<class TG, class TL, int N, class S>
+  inline typename ParallelIndexSet<TG,TL,N,S>::const_iterator
+  ParallelIndexSet<TG,TL,N,S>::end() const
   {
     return localIndices_.end();
   }
 
-  template<class TG, class TL, int N>
-  void ParallelIndexSet<TG,TL,N>::renumberLocal(){
+  template<class TG, class TL, int N, class S>
+  void ParallelIndexSet<TG,TL,N,S>::renumberLocal(){
 #ifndef NDEBUG
     if(state_==RESIZE)
       DUNE_THROW(InvalidIndexSetState, "IndexSet has to be in "
                  <<"GROUND state for renumberLocal()");
 #endif
 
-    typedef typename ArrayList<IndexPair,N>::iterator iterator;
+    typedef typename Storage::iterator iterator;
     const const_iterator end_ = end();
     uint32_t index=0;
 
@@ -1021,14 +1471,14 @@ namespace Dune
       pair->local()=index;
   }
 
-  template<class TG, class TL, int N>
-  inline int ParallelIndexSet<TG,TL,N>::seqNo() const
+  template<class TG, class TL, int N, class S>
+  inline int ParallelIndexSet<TG,TL,N,S>::seqNo() const
   {
     return seqNo_;
   }
 
-  template<class TG, class TL, int N>
-  inline size_t ParallelIndexSet<TG,TL,N>::size() const
+  template<class TG, class TL, int N, class S>
+  inline size_t ParallelIndexSet<TG,TL,N,S>::size() const
   {
     return localIndices_.size();
   }
@@ -1103,19 +1553,19 @@ namespace Dune
     return indexSet_.seqNo();
   }
 
-  template<typename TG, typename TL, int N, typename TG1, typename TL1, int N1>
-  bool operator==(const ParallelIndexSet<TG,TL,N>& idxset,
-                  const ParallelIndexSet<TG1,TL1,N1>& idxset1)
+  template<typename TG, typename TL, int N, typename S, typename TG1, typename TL1, int N1, typename S1>
+  bool operator==(const ParallelIndexSet<TG,TL,N,S>& idxset,
+                  const ParallelIndexSet<TG1,TL1,N1,S1>& idxset1)
   {
     if(idxset.size()!=idxset1.size())
       return false;
-    typedef typename ParallelIndexSet<TG,TL,N>::const_iterator Iter;
-    typedef typename ParallelIndexSet<TG1,TL1,N1>::const_iterator Iter1;
+    typedef typename ParallelIndexSet<TG,TL,N,S>::const_iterator Iter;
+    typedef typename ParallelIndexSet<TG1,TL1,N1,S1>::const_iterator Iter1;
     Iter iter=idxset.begin();
     for(Iter1 iter1=idxset1.begin(); iter1 != idxset1.end(); ++iter, ++iter1) {
       if(iter1->global()!=iter->global())
         return false;
-      typedef typename ParallelIndexSet<TG,TL,N>::LocalIndex PI;
+      typedef typename ParallelIndexSet<TG,TL,N,S>::LocalIndex PI;
       const PI& pi=iter->local(), pi1=iter1->local();
 
       if(pi!=pi1)
@@ -1124,9 +1574,9 @@ namespace Dune
     return true;
   }
 
-  template<typename TG, typename TL, int N, typename TG1, typename TL1, int N1>
-  bool operator!=(const ParallelIndexSet<TG,TL,N>& idxset,
-                  const ParallelIndexSet<TG1,TL1,N1>& idxset1)
+  template<typename TG, typename TL, int N, typename S, typename TG1, typename TL1, int N1, typename S1>
+  bool operator!=(const ParallelIndexSet<TG,TL,N,S>& idxset,
+                  const ParallelIndexSet<TG1,TL1,N1,S1>& idxset1)
   {
     return !(idxset==idxset1);
   }
@@ -5,16 +5,20 @@
 
 #include "indexset.hh"
 #include "remoteindices.hh"
+#include <dune/common/parallel/communicationprofile.hh>
 #include <dune/common/stdstreams.hh>
 #include <dune/common/sllist.hh>
 #include <dune/common/unused.hh>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <algorithm>
 #include <functional>
 #include <map>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #if HAVE_MPI
 namespace Dune
@@ -30,6 +34,59 @@ namespace Dune
    * @author Markus Blatt
    */
 
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // The arrays of a message of the IndicesSyncer. A message starts with
+    // the number of published indices and the number of pairs (process
+    // and attribute) followed by the global indices, the numbers of pairs
+    // per index, the processes of the pairs, the attributes of the indices
+    // and the attributes of the pairs. C is char for writing a message and
+    // const char for reading it.
+    template<class GlobalIndex, class C>
+    struct IndicesSyncerMessage
+    {
+      IndicesSyncerMessage(C* message, int publish, int pairs)
+        : globals(message+2*sizeof(int)),
+          pairCounts(globals+publish*sizeof(GlobalIndex)),
+          processes(pairCounts+publish*sizeof(int)),
+          attributes(processes+pairs*sizeof(int)),
+          pairAttributes(attributes+publish)
+      {}
+
+      static std::size_t size(int publish, int pairs)
+      {
+        return 2*sizeof(int) + publish*(sizeof(GlobalIndex)+sizeof(int)+sizeof(char))
+               + pairs*(sizeof(int)+sizeof(char));
+      }
+
+      C* globals;
+      C* pairCounts;
+      C* processes;
+      C* attributes;
+      C* pairAttributes;
+    };
+
+    // the entries are copied, as the arrays are not aligned
+    template<class V>
+    void writeMessageEntry(char*& position, const V& value)
+    {
+      std::memcpy(position, &value, sizeof(V));
+      position += sizeof(V);
+    }
+
+    template<class V>
+    V readMessageEntry(const char*& position)
+    {
+      V value;
+      std::memcpy(&value, position, sizeof(V));
+      position += sizeof(V);
+      return value;
+    }
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
   /**
    * @brief Class for recomputing missing indices of a distributed index set.
    *
@@ -101,17 +158,36 @@ namespace Dune
     /** @brief The remote indices. */
     RemoteIndices& remoteIndices_;
 
-    /** @brief The send buffers for the neighbour processes. */
-    char** sendBuffers_;
+    /** @brief The tag of the messages. */
+    const static int commTag_=345;
+
+    /**
+     * @brief The send buffers for the neighbour processes.
+     *
+     * The buffers are kept for the next call of sync().
+     */
+    std::vector<std::vector<char> > sendBuffers_;
+
+    /** @brief The positions in the send buffers while packing. */
+    std::vector<Impl::IndicesSyncerMessage<GlobalIndex,char> > messages_;
+
+    /** @brief The receive buffer, also kept for the next call of sync(). */
+    std::vector<char> receiveBuffer_;
 
-    /** @brief The receive buffer. */
-    char* receiveBuffer_;
+    /** @brief The neighbours before the sync. */
+    std::vector<int> neighbours_;
 
-    /** @brief The size of the send buffers. */
-    std::size_t* sendBufferSizes_;
+    /** @brief The neighbours we did not receive the message of yet. */
+    std::vector<int> pendingNeighbours_;
 
-    /** @brief The size of the receive buffer in bytes. */
-    int receiveBufferSize_; // int because of MPI
+    /** @brief The requests of the sends to the neighbours. */
+    std::vector<MPI_Request> requests_;
+
+    /** @brief The statuses of the sends to the neighbours. */
+    std::vector<MPI_Status> statuses_;
+
+    /** @brief The processes and attributes of a received index on other processes. */
+    std::vector<std::pair<int,Attribute> > sourceAttributes_;
 
     /**
      * @brief Information about the messages to send to a neighbouring process.
@@ -347,20 +423,19 @@ namespace Dune
     void calculateMessageSizes();
 
     /**
-     * @brief Pack and send the message for another process.
-     * @param destination The rank of the process we send to.
-     * @param buffer The allocated buffer to use.
-     * @param bufferSize The size of the buffer.
-     * @param req The MPI_Request to setup the nonblocking send.
+     * @brief Pack the messages for all neighbours and send them.
+     *
+     * The messages are packed in one pass over the index set.
      */
-    void packAndSend(int destination, char* buffer, std::size_t bufferSize, MPI_Request& req);
+    void packAndSend();
 
     /**
-     * @brief Recv and unpack the message from another process and add the indices.
+     * @brief Unpack the message from another process and add the indices.
+     * @param source The rank of the process that sent the message.
      * @param numberer Functor providing local indices for added global indices.
      */
     template<typename T1>
-    void recvAndUnpack(T1& numberer);
+    void unpack(int source, T1& numberer);
 
     /**
      * @brief Register the MPI datatype for the MessageInformation.
@@ -369,6 +444,10 @@ namespace Dune
 
     /**
      * @brief Insert an entry into the  remote index list if not yet present.
+     *
+     * The search starts at the current position of the iterators of the
+     * process. Thus the entries have to be inserted in ascending order
+     * of the global indices between two resets of the iterators.
      */
     void insertIntoRemoteIndexList(int process,
                                    const std::pair<GlobalIndex,Attribute>& global,
@@ -695,9 +774,7 @@ namespace Dune
 
     const MessageIterator end = infoSend_.end();
 
-    // registerMessageDatatype();
-
-    // Now determine the buffersizes needed for each neighbour using MPI_Pack_size
+    // Now determine the exact sizes of the messages to each neighbour
     MessageInformation dummy;
 
     MessageIterator messageIter= infoSend_.begin();
@@ -707,44 +784,20 @@ namespace Dune
     int neighbour=0;
 
     for(RemoteIterator remote = remoteIndices_.begin(); remote != rend; ++remote, ++neighbour) {
-      MessageInformation* message;
-      MessageInformation recv;
+      const MessageInformation* message;
 
       if(messageIter != end && messageIter->first==remote->first) {
         // We want to send message information to that process
-        message = const_cast<MessageInformation*>(&(messageIter->second));
+        message = &(messageIter->second);
         ++messageIter;
       }else
         // We do not want to send information but the other process might.
         message = &dummy;
 
-      sendBufferSizes_[neighbour]=0;
-      int tsize;
-      // The number of indices published
-      MPI_Pack_size(1, MPI_INT,remoteIndices_.communicator(), &tsize);
-      sendBufferSizes_[neighbour] += tsize;
-
-      for(int i=0; i < message->publish; ++i) {
-        // The global index
-        MPI_Pack_size(1, MPITraits<GlobalIndex>::getType(), remoteIndices_.communicator(), &tsize);
-        sendBufferSizes_[neighbour] += tsize;
-        // The attribute in the local index
-        MPI_Pack_size(1, MPI_CHAR, remoteIndices_.communicator(), &tsize);
-        sendBufferSizes_[neighbour] += tsize;
-        // The number of corresponding remote indices
-        MPI_Pack_size(1, MPI_INT, remoteIndices_.communicator(), &tsize);
-        sendBufferSizes_[neighbour] += tsize;
-      }
-      for(int i=0; i < message->pairs; ++i) {
-        // The process of the remote index
-        MPI_Pack_size(1, MPI_INT, remoteIndices_.communicator(), &tsize);
-        sendBufferSizes_[neighbour] += tsize;
-        // The attribute of the remote index
-        MPI_Pack_size(1, MPI_CHAR, remoteIndices_.communicator(), &tsize);
-        sendBufferSizes_[neighbour] += tsize;
-      }
+      // Resizing keeps the capacity of the buffers of earlier calls of sync()
+      sendBuffers_[neighbour].resize(Impl::IndicesSyncerMessage<GlobalIndex,char>::size(message->publish, message->pairs));
 
-      Dune::dverb<<rank_<<": Buffer (neighbour="<<remote->first<<") size is "<< sendBufferSizes_[neighbour]<<" for publish="<<message->publish<<" pairs="<<message->pairs<<std::endl;
+      Dune::dverb<<rank_<<": Buffer (neighbour="<<remote->first<<") size is "<< sendBuffers_[neighbour].size()<<" for publish="<<message->publish<<" pairs="<<message->pairs<<std::endl;
     }
 
   }
@@ -760,6 +813,7 @@ namespace Dune
   template<typename T1>
   void IndicesSyncer<T>::sync(T1& numberer)
   {
+    Impl::CommProfileScope profile(CommunicationProfile::indicesSyncer);
 
     // The pointers to the local indices in the remote indices
     // will become invalid due to the resorting of the index set.
@@ -774,15 +828,13 @@ namespace Dune
     // Number of neighbours might change during the syncing.
     // save the old neighbours
     std::size_t noOldNeighbours = remoteIndices_.neighbours();
-    int* oldNeighbours = new int[noOldNeighbours];
-    sendBufferSizes_ = new std::size_t[noOldNeighbours];
-    std::size_t neighbourI = 0;
+    neighbours_.clear();
 
-    for(RemoteIterator remote = remoteIndices_.begin(); remote != end; ++remote, ++neighbourI) {
+    for(RemoteIterator remote = remoteIndices_.begin(); remote != end; ++remote) {
       typedef typename RemoteIndices::RemoteIndexList::const_iterator
       RemoteIndexIterator;
 
-      oldNeighbours[neighbourI] = remote->first;
+      neighbours_.push_back(remote->first);
 
       // Make sure we only have one remote index list.
       assert(remote->second.first==remote->second.second);
@@ -807,71 +859,71 @@ namespace Dune
     }
 
     // Exchange indices with each neighbour
+    infoSend_.clear();
+    sendBuffers_.resize(noOldNeighbours);
     calculateMessageSizes();
 
-    // Allocate the buffers
-    receiveBufferSize_=1;
-    sendBuffers_ = new char*[noOldNeighbours];
-
-    for(std::size_t i=0; i<noOldNeighbours; ++i) {
-      sendBuffers_[i] = new char[sendBufferSizes_[i]];
-      receiveBufferSize_ = std::max(receiveBufferSize_, static_cast<int>(sendBufferSizes_[i]));
-    }
-
-    receiveBuffer_=new char[receiveBufferSize_];
-
     indexSet_.beginResize();
 
     Dune::dverb<<rank_<<": Neighbours: ";
 
     for(std::size_t i = 0; i<noOldNeighbours; ++i)
-      Dune::dverb<<oldNeighbours[i]<<" ";
+      Dune::dverb<<neighbours_[i]<<" ";
 
     Dune::dverb<<std::endl;
 
-    MPI_Request* requests = new MPI_Request[noOldNeighbours];
-    MPI_Status* statuses = new MPI_Status[noOldNeighbours];
-
     // Pack Message data and start the sends
-    for(std::size_t i = 0; i<noOldNeighbours; ++i)
-      packAndSend(oldNeighbours[i], sendBuffers_[i], sendBufferSizes_[i], requests[i]);
+    {
+      Impl::CommProfileTimer timer(CommunicationProfile::indicesSyncer, CommunicationProfile::packTime);
+      packAndSend();
+    }
 
-    // Probe for incoming messages, receive and unpack them
-    for(std::size_t i = 0; i<noOldNeighbours; ++i)
-      recvAndUnpack(numberer);
-    //       }else{
-    //  recvAndUnpack(oldNeighbours[i], numberer);
-    //  packAndSend(oldNeighbours[i]);
-    //       }
-    //     }
+    // Receive and unpack the messages of the old neighbours in the order
+    // they arrive
+    pendingNeighbours_ = neighbours_;
+    while(!pendingNeighbours_.empty()) {
+      for(std::size_t i=0; i<pendingNeighbours_.size(); ) {
+        int flag;
+        MPI_Message message;
+        MPI_Status status;
+        MPI_Improbe(pendingNeighbours_[i], commTag_, remoteIndices_.communicator(),
+                    &flag, &message, &status);
+        if(!flag) {
+          ++i;
+          continue;
+        }
+
+        // The size of the message is exact, the buffer only grows
+        int count;
+        MPI_Get_count(&status, MPI_BYTE, &count);
+        Dune::dvverb<<rank_<<": Receiving message from "<< pendingNeighbours_[i]<<" with "<<count<<" bytes"<<std::endl;
+        receiveBuffer_.resize(count);
+        MPI_Mrecv(receiveBuffer_.data(), count, MPI_BYTE, &message, MPI_STATUS_IGNORE);
+        Impl::commProfileReceived(CommunicationProfile::indicesSyncer, pendingNeighbours_[i], count);
+
+        {
+          Impl::CommProfileTimer timer(CommunicationProfile::indicesSyncer, CommunicationProfile::unpackTime);
+          unpack(pendingNeighbours_[i], numberer);
+        }
 
-    delete[] receiveBuffer_;
+        pendingNeighbours_[i] = pendingNeighbours_.back();
+        pendingNeighbours_.pop_back();
+      }
+    }
 
-    // Wait for the completion of the sends
     // Wait for completion of sends
-    if(MPI_SUCCESS!=MPI_Waitall(noOldNeighbours, requests, statuses)) {
+    if(MPI_SUCCESS!=MPI_Waitall(noOldNeighbours, requests_.data(), statuses_.data())) {
       std::cerr<<": MPI_Error occurred while sending message"<<std::endl;
       for(std::size_t i=0; i< noOldNeighbours; i++)
-        if(MPI_SUCCESS!=statuses[i].MPI_ERROR)
-          std::cerr<<"Destination "<<statuses[i].MPI_SOURCE<<" error code: "<<statuses[i].MPI_ERROR<<std::endl;
+        if(MPI_SUCCESS!=statuses_[i].MPI_ERROR)
+          std::cerr<<"Destination "<<neighbours_[i]<<" error code: "<<statuses_[i].MPI_ERROR<<std::endl;
     }
 
-    delete[] statuses;
-    delete[] requests;
-
-    for(std::size_t i=0; i<noOldNeighbours; ++i)
-      delete[] sendBuffers_[i];
-
-    delete[] sendBuffers_;
-    delete[] sendBufferSizes_;
-
     // No need for the iterator tuples any more
     iteratorsMap_.clear();
 
     indexSet_.endResize();
 
-    delete[] oldNeighbours;
-
     repairLocalIndexPointers(globalMap_, remoteIndices_, indexSet_);
 
     oldMap_.clear();
@@ -882,26 +934,38 @@ namespace Dune
   }
 
   template<typename T>
-  void IndicesSyncer<T>::packAndSend(int destination, char* buffer, std::size_t bufferSize, MPI_Request& request)
+  void IndicesSyncer<T>::packAndSend()
   {
     typedef typename ParallelIndexSet::const_iterator IndexIterator;
-
-    IndexIterator iEnd       = indexSet_.end();
-    int bpos       = 0;
-    int published  = 0;
-    int pairs      = 0;
+    typedef typename IteratorsMap::iterator Iterator;
+    typedef Impl::IndicesSyncerMessage<GlobalIndex,char> Message;
 
     assert(checkReset());
 
-    // Pack the number of indices we publish
-    MPI_Pack(&(infoSend_[destination].publish), 1, MPI_INT, buffer, bufferSize, &bpos,
-             remoteIndices_.communicator());
+    // The positions in the messages of the neighbours, which are
+    // in the same order as the iterator tuples
+    messages_.clear();
 
-    for(IndexIterator index = indexSet_.begin(); index != iEnd; ++index) {
-      // Search for corresponding remote indices in all iterator tuples
-      typedef typename IteratorsMap::iterator Iterator;
-      Iterator iteratorsEnd = iteratorsMap_.end();
+    for(std::size_t i=0; i<neighbours_.size(); ++i) {
+      const MessageInformation& info = infoSend_[neighbours_[i]];
+      char* header = sendBuffers_[i].data();
+      Impl::writeMessageEntry(header, info.publish);
+      Impl::writeMessageEntry(header, info.pairs);
+      messages_.push_back(Message(sendBuffers_[i].data(), info.publish, info.pairs));
+    }
+
+    const Iterator iteratorsEnd = iteratorsMap_.end();
 
+    // Whether the remote index at the position of the iterators was already
+    // present before calling sync and belongs to the global index
+    auto isOldRemoteIndex = [](const Iterators& iterators, const GlobalIndex& global) {
+                              return iterators.isNotAtEnd() && iterators.isOld()
+                                     && iterators.globalIndexPair().first == global;
+                            };
+
+    IndexIterator iEnd = indexSet_.end();
+
+    for(IndexIterator index = indexSet_.begin(); index != iEnd; ++index) {
       // advance all iterators to a position with global index >= index->global()
       for(Iterator iterators = iteratorsMap_.begin(); iteratorsEnd != iterators; ++iterators) {
         while(iterators->second.isNotAtEnd() &&
@@ -910,77 +974,58 @@ namespace Dune
         assert(!iterators->second.isNotAtEnd() || iterators->second.globalIndexPair().first >= index->global());
       }
 
-      // Add all remote indices positioned at global which were already present before calling sync
-      // to the message.
       // Count how many remote indices we will send
       int indices = 0;
-      bool knownRemote = false; // Is the remote process supposed to know this index?
 
       for(Iterator iterators = iteratorsMap_.begin(); iteratorsEnd != iterators; ++iterators)
-      {
-        std::pair<GlobalIndex,Attribute> p;
-        if (iterators->second.isNotAtEnd())
-        {
-          p = iterators->second.globalIndexPair();
-        }
-
-        if(iterators->second.isNotAtEnd() && iterators->second.isOld()
-           && iterators->second.globalIndexPair().first == index->global()) {
+        if(isOldRemoteIndex(iterators->second, index->global()))
           indices++;
-          if(destination == iterators->first)
-            knownRemote = true;
-        }
-      }
 
-      if(!knownRemote)
+      if(indices==0)
         // We do not need to send any indices
         continue;
 
-      Dune::dverb<<rank_<<": sending "<<indices<<" for index "<<index->global()<<" to "<<destination<<std::endl;
+      // Add the index and all its remote indices to the messages of the
+      // processes that are supposed to know it.
+      std::size_t neighbour = 0;
+      for(Iterator destination = iteratorsMap_.begin(); iteratorsEnd != destination;
+          ++destination, ++neighbour) {
+        if(!isOldRemoteIndex(destination->second, index->global()))
+          continue;
+
+        Dune::dverb<<rank_<<": sending "<<indices<<" for index "<<index->global()<<" to "<<destination->first<<std::endl;
+
+        Message& message = messages_[neighbour];
+        Impl::writeMessageEntry(message.globals, index->global());
+        Impl::writeMessageEntry(message.attributes, static_cast<char>(index->local().attribute()));
+        Impl::writeMessageEntry(message.pairCounts, indices);
+
+        for(Iterator iterators = iteratorsMap_.begin(); iteratorsEnd != iterators; ++iterators)
+          if(isOldRemoteIndex(iterators->second, index->global())) {
+            Impl::writeMessageEntry(message.processes, iterators->first);
+            Impl::writeMessageEntry(message.pairAttributes,
+                                    static_cast<char>(iterators->second.remoteIndex().attribute()));
+          }
+      }
+    }
 
+    resetIteratorsMap();
 
-      // Pack the global index, the attribute and the number
-      MPI_Pack(const_cast<GlobalIndex*>(&(index->global())), 1, MPITraits<GlobalIndex>::getType(), buffer, bufferSize, &bpos,
-               remoteIndices_.communicator());
+    requests_.resize(neighbours_.size());
+    statuses_.resize(neighbours_.size());
 
-      char attr = index->local().attribute();
-      MPI_Pack(&attr, 1, MPI_CHAR, buffer, bufferSize, &bpos,
-               remoteIndices_.communicator());
+    for(std::size_t i=0; i<neighbours_.size(); ++i) {
+      // Make sure we send all expected entries
+      assert(messages_[i].pairAttributes == sendBuffers_[i].data()+sendBuffers_[i].size());
+      assert(messages_[i].globals == Message(sendBuffers_[i].data(), infoSend_[neighbours_[i]].publish,
+                                            infoSend_[neighbours_[i]].pairs).pairCounts);
 
-      // Pack the number of remote indices we send.
-      MPI_Pack(&indices, 1, MPI_INT, buffer, bufferSize, &bpos,
-               remoteIndices_.communicator());
+      Dune::dverb << rank_<<": Sending message of "<<sendBuffers_[i].size()<<" bytes to "<<neighbours_[i]<<std::endl;
 
-      // Pack the information about the remote indices
-      for(Iterator iterators = iteratorsMap_.begin(); iteratorsEnd != iterators; ++iterators)
-        if(iterators->second.isNotAtEnd() && iterators->second.isOld()
-           && iterators->second.globalIndexPair().first == index->global()) {
-          int process = iterators->first;
-
-          ++pairs;
-          assert(pairs <= infoSend_[destination].pairs);
-          MPI_Pack(&process, 1, MPI_INT, buffer, bufferSize, &bpos,
-                   remoteIndices_.communicator());
-          char attr2 = iterators->second.remoteIndex().attribute();
-
-          MPI_Pack(&attr2, 1, MPI_CHAR, buffer, bufferSize, &bpos,
-                   remoteIndices_.communicator());
-          --indices;
-        }
-      assert(indices==0);
-      ++published;
-      Dune::dvverb<<" (publish="<<published<<", pairs="<<pairs<<")"<<std::endl;
-      assert(published <= infoSend_[destination].publish);
+      Impl::commProfileSent(CommunicationProfile::indicesSyncer, neighbours_[i], sendBuffers_[i].size());
+      MPI_Issend(sendBuffers_[i].data(), sendBuffers_[i].size(), MPI_BYTE, neighbours_[i], commTag_,
+                 remoteIndices_.communicator(), &requests_[i]);
     }
-
-    // Make sure we send all expected entries
-    assert(published == infoSend_[destination].publish);
-    assert(pairs == infoSend_[destination].pairs);
-    resetIteratorsMap();
-
-    Dune::dverb << rank_<<": Sending message of "<<bpos<<" bytes to "<<destination<<std::endl;
-
-    MPI_Issend(buffer, bpos, MPI_PACKED, destination, 345, remoteIndices_.communicator(),&request);
   }
 
   template<typename T>
@@ -991,8 +1036,6 @@ namespace Dune
     Dune::dverb<<"Inserting from "<<process<<" "<<globalPair.first<<", "<<
     globalPair.second<<" "<<attribute<<std::endl;
 
-    resetIteratorsMap();
-
     // There might be cases where there no remote indices for that process yet
     typename IteratorsMap::iterator found = iteratorsMap_.find(process);
 
@@ -1025,8 +1068,8 @@ namespace Dune
     for(Iterators tmpIterators = iterators;
         !tmpIterators.isAtEnd() && tmpIterators.globalIndexPair() == globalPair;
         ++tmpIterators)
-      //entry already exists with the same attribute
-      if(tmpIterators.globalIndexPair().second == attribute) {
+      //entry already exists with the same remote attribute
+      if(tmpIterators.remoteIndex().attribute() == Attribute(attribute)) {
         indexIsThere=true;
         break;
       }
@@ -1039,58 +1082,44 @@ namespace Dune
 
   template<typename T>
   template<typename T1>
-  void IndicesSyncer<T>::recvAndUnpack(T1& numberer)
+  void IndicesSyncer<T>::unpack(int source, T1& numberer)
   {
     typedef typename ParallelIndexSet::const_iterator IndexIterator;
+    typedef Impl::IndicesSyncerMessage<GlobalIndex,const char> Message;
 
     IndexIterator iEnd   = indexSet_.end();
     IndexIterator index  = indexSet_.begin();
-    int bpos   = 0;
-    int publish;
 
     assert(checkReset());
 
-    MPI_Status status;
-
-    // We have to determine the message size and source before the receive
-    MPI_Probe(MPI_ANY_SOURCE, 345, remoteIndices_.communicator(), &status);
-
-    int source=status.MPI_SOURCE;
-    int count;
-    MPI_Get_count(&status, MPI_PACKED, &count);
-
-    Dune::dvverb<<rank_<<": Receiving message from "<< source<<" with "<<count<<" bytes"<<std::endl;
-
-    if(count>receiveBufferSize_) {
-      receiveBufferSize_=count;
-      delete[] receiveBuffer_;
-      receiveBuffer_ = new char[receiveBufferSize_];
-    }
-
-    MPI_Recv(receiveBuffer_, count, MPI_PACKED, source, 345, remoteIndices_.communicator(), &status);
-
     // How many global entries were published?
-    MPI_Unpack(receiveBuffer_,  count, &bpos, &publish, 1, MPI_INT, remoteIndices_.communicator());
+    const char* header = receiveBuffer_.data();
+    int publish = Impl::readMessageEntry<int>(header);
+    int allPairs = Impl::readMessageEntry<int>(header);
+    Message message(receiveBuffer_.data(), publish, allPairs);
+    assert(Message::size(publish, allPairs) == receiveBuffer_.size());
+
+    // The global indices are sent in ascending order. Thus the
+    // iterators of the remote index lists only have to be reset if a
+    // global index is sent more than once.
+    GlobalIndex lastGlobal = GlobalIndex();
 
     // Now unpack the remote indices and add them.
-    while(publish>0) {
+    for(int i=0; i<publish; ++i) {
 
       // Unpack information about the local index on the source process
-      GlobalIndex global;           // global index of the current entry
-      char sourceAttribute; // Attribute on the source process
-      int pairs;
+      GlobalIndex global = Impl::readMessageEntry<GlobalIndex>(message.globals);
+      char sourceAttribute = Impl::readMessageEntry<char>(message.attributes);
+      int pairs = Impl::readMessageEntry<int>(message.pairCounts);
 
-      MPI_Unpack(receiveBuffer_,  count, &bpos, &global, 1, MPITraits<GlobalIndex>::getType(),
-                 remoteIndices_.communicator());
-      MPI_Unpack(receiveBuffer_,  count, &bpos, &sourceAttribute, 1, MPI_CHAR,
-                 remoteIndices_.communicator());
-      MPI_Unpack(receiveBuffer_,  count, &bpos, &pairs, 1, MPI_INT,
-                 remoteIndices_.communicator());
+      if(i>0 && global == lastGlobal)
+        resetIteratorsMap();
+      lastGlobal = global;
 
       // Insert the entry on the remote process to our
       // remote index list
-      SLList<std::pair<int,Attribute> > sourceAttributeList;
-      sourceAttributeList.push_back(std::make_pair(source,Attribute(sourceAttribute)));
+      sourceAttributes_.clear();
+      sourceAttributes_.push_back(std::make_pair(source,Attribute(sourceAttribute)));
 #ifndef NDEBUG
       bool foundSelf = false;
 #endif
@@ -1098,14 +1127,9 @@ namespace Dune
 
       // Unpack the remote indices
       for(; pairs>0; --pairs) {
-        // Unpack the process id that knows the index
-        int process;
-        char attribute;
-        MPI_Unpack(receiveBuffer_,  count, &bpos, &process, 1, MPI_INT,
-                   remoteIndices_.communicator());
-        // Unpack the attribute
-        MPI_Unpack(receiveBuffer_,  count, &bpos, &attribute, 1, MPI_CHAR,
-                   remoteIndices_.communicator());
+        // Unpack the process id that knows the index and the attribute
+        int process = Impl::readMessageEntry<int>(message.processes);
+        char attribute = Impl::readMessageEntry<char>(message.pairAttributes);
 
         if(process==rank_) {
 #ifndef NDEBUG
@@ -1145,17 +1169,14 @@ namespace Dune
           }
 
         }else{
-          sourceAttributeList.push_back(std::make_pair(process,Attribute(attribute)));
+          sourceAttributes_.push_back(std::make_pair(process,Attribute(attribute)));
         }
       }
       assert(foundSelf);
       // Insert remote indices
-      typedef typename SLList<std::pair<int,Attribute> >::const_iterator Iter;
-      for(Iter i=sourceAttributeList.begin(), end=sourceAttributeList.end();
-          i!=end; ++i)
-        insertIntoRemoteIndexList(i->first, std::make_pair(global, myAttribute),
-                                  i->second);
-      --publish;
+      for(const auto& remote : sourceAttributes_)
+        insertIntoRemoteIndexList(remote.first, std::make_pair(global, myAttribute),
+                                  remote.second);
     }
 
     resetIteratorsMap();
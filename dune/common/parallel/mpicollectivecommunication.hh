@@ -22,6 +22,9 @@
 #include <dune/common/binaryfunctions.hh>
 #include <dune/common/exceptions.hh>
 #include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/parallel/communicationprofile.hh>
+#include <dune/common/parallel/future.hh>
+#include <dune/common/parallel/mpifuture.hh>
 #include <dune/common/parallel/mpitraits.hh>
 
 namespace Dune
@@ -239,6 +242,7 @@ namespace Dune
     //! @copydoc CollectiveCommunication::barrier
     int barrier () const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
       return MPI_Barrier(communicator);
     }
 
@@ -246,6 +250,8 @@ namespace Dune
     template<typename T>
     int broadcast (T* inout, int len, int root) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, len*sizeof(T));
       return MPI_Bcast(inout,len,MPITraits<T>::getType(),root,communicator);
     }
 
@@ -254,6 +260,8 @@ namespace Dune
     template<typename T>
     int gather (const T* in, T* out, int len, int root) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, len*sizeof(T));
       return MPI_Gather(const_cast<T*>(in),len,MPITraits<T>::getType(),
                         out,len,MPITraits<T>::getType(),
                         root,communicator);
@@ -263,6 +271,8 @@ namespace Dune
     template<typename T>
     int gatherv (const T* in, int sendlen, T* out, int* recvlen, int* displ, int root) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, sendlen*sizeof(T));
       return MPI_Gatherv(const_cast<T*>(in),sendlen,MPITraits<T>::getType(),
                          out,recvlen,displ,MPITraits<T>::getType(),
                          root,communicator);
@@ -273,6 +283,8 @@ namespace Dune
     template<typename T>
     int scatter (const T* send, T* recv, int len, int root) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, len*sizeof(T));
       return MPI_Scatter(const_cast<T*>(send),len,MPITraits<T>::getType(),
                          recv,len,MPITraits<T>::getType(),
                          root,communicator);
@@ -282,6 +294,8 @@ namespace Dune
     template<typename T>
     int scatterv (const T* send, int* sendlen, int* displ, T* recv, int recvlen, int root) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, recvlen*sizeof(T));
       return MPI_Scatterv(const_cast<T*>(send),sendlen,displ,MPITraits<T>::getType(),
                           recv,recvlen,MPITraits<T>::getType(),
                           root,communicator);
@@ -297,6 +311,8 @@ namespace Dune
     template<typename T, typename T1>
     int allgather(const T* sbuf, int count, T1* rbuf) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, count*sizeof(T));
       return MPI_Allgather(const_cast<T*>(sbuf), count, MPITraits<T>::getType(),
                            rbuf, count, MPITraits<T1>::getType(),
                            communicator);
@@ -306,6 +322,8 @@ namespace Dune
     template<typename T>
     int allgatherv (const T* in, int sendlen, T* out, int* recvlen, int* displ) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, sendlen*sizeof(T));
       return MPI_Allgatherv(const_cast<T*>(in),sendlen,MPITraits<T>::getType(),
                             out,recvlen,displ,MPITraits<T>::getType(),
                             communicator);
@@ -326,10 +344,123 @@ namespace Dune
     template<typename BinaryFunction, typename Type>
     int allreduce(const Type* in, Type* out, int len) const
     {
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, len*sizeof(Type));
       return MPI_Allreduce(const_cast<Type*>(in), out, len, MPITraits<Type>::getType(),
                            (Generic_MPI_Op<Type, BinaryFunction>::get()),communicator);
     }
 
+    //! @copydoc CollectiveCommunication::iallreduce(T&&) const
+    template<typename BinaryFunction, typename T>
+    MPIFuture<T> iallreduce(T&& data) const
+    {
+      typedef Impl::CollectiveDataOf<T> Data;
+      typedef typename Data::value_type Type;
+      MPIFuture<T> future(new Impl::FutureData<T>(std::forward<T>(data)));
+      auto& value = future.result().value;
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, Data::size(value)*sizeof(Type));
+      MPI_Iallreduce(MPI_IN_PLACE, Data::data(value), Data::size(value), MPITraits<Type>::getType(),
+                     (Generic_MPI_Op<Type, BinaryFunction>::get()), communicator, &future.request());
+      return future;
+    }
+
+    //! @copydoc CollectiveCommunication::iallreduce(TIn&&,TOut&&) const
+    template<typename BinaryFunction, typename TIn, typename TOut>
+    MPIFuture<TOut,TIn> iallreduce(TIn&& in, TOut&& out) const
+    {
+      typedef Impl::CollectiveDataOf<TIn> InData;
+      typedef Impl::CollectiveDataOf<TOut> OutData;
+      typedef typename InData::value_type Type;
+      MPIFuture<TOut,TIn> future(new Impl::FutureData<TOut>(std::forward<TOut>(out)),
+                                 new Impl::FutureData<TIn>(std::forward<TIn>(in)));
+      const auto& send = future.send().value;
+      auto& recv = future.result().value;
+      auto* recvData = OutData::data(recv);
+      if(OutData::size(recv) < InData::size(send))
+        recvData = future.template errorBuffer<typename OutData::value_type>(
+          InData::size(send), "The output of iallreduce is too small!");
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, InData::size(send)*sizeof(Type));
+      MPI_Iallreduce(const_cast<Type*>(InData::data(send)), recvData, InData::size(send),
+                     MPITraits<Type>::getType(), (Generic_MPI_Op<Type, BinaryFunction>::get()),
+                     communicator, &future.request());
+      return future;
+    }
+
+    //! @copydoc CollectiveCommunication::ibarrier
+    MPIFuture<void> ibarrier() const
+    {
+      MPIFuture<void> future(new Impl::FutureData<void>());
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      MPI_Ibarrier(communicator, &future.request());
+      return future;
+    }
+
+    //! @copydoc CollectiveCommunication::ibroadcast
+    template<typename T>
+    MPIFuture<T> ibroadcast(T&& data, int root) const
+    {
+      typedef Impl::CollectiveDataOf<T> Data;
+      MPIFuture<T> future(new Impl::FutureData<T>(std::forward<T>(data)));
+      auto& value = future.result().value;
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, Data::size(value)*sizeof(typename Data::value_type));
+      MPI_Ibcast(Data::data(value), Data::size(value),
+                 MPITraits<typename Data::value_type>::getType(), root, communicator,
+                 &future.request());
+      return future;
+    }
+
+    //! @copydoc CollectiveCommunication::iallgather
+    template<typename TIn, typename TOut>
+    MPIFuture<TOut,TIn> iallgather(TIn&& in, TOut&& out) const
+    {
+      typedef Impl::CollectiveDataOf<TIn> InData;
+      typedef Impl::CollectiveDataOf<TOut> OutData;
+      typedef typename InData::value_type Type;
+      MPIFuture<TOut,TIn> future(new Impl::FutureData<TOut>(std::forward<TOut>(out)),
+                                 new Impl::FutureData<TIn>(std::forward<TIn>(in)));
+      const auto& send = future.send().value;
+      auto& recv = future.result().value;
+      const int len = InData::size(send);
+      auto* recvData = OutData::data(recv);
+      if(OutData::size(recv) < procs*len)
+        recvData = future.template errorBuffer<typename OutData::value_type>(
+          procs*len, "The output of iallgather is too small!");
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, len*sizeof(Type));
+      MPI_Iallgather(const_cast<Type*>(InData::data(send)), len, MPITraits<Type>::getType(),
+                     recvData, len, MPITraits<typename OutData::value_type>::getType(),
+                     communicator, &future.request());
+      return future;
+    }
+
+    //! @copydoc CollectiveCommunication::igather
+    template<typename TIn, typename TOut>
+    MPIFuture<TOut,TIn> igather(TIn&& in, TOut&& out, int root) const
+    {
+      typedef Impl::CollectiveDataOf<TIn> InData;
+      typedef Impl::CollectiveDataOf<TOut> OutData;
+      typedef typename InData::value_type Type;
+      MPIFuture<TOut,TIn> future(new Impl::FutureData<TOut>(std::forward<TOut>(out)),
+                                 new Impl::FutureData<TIn>(std::forward<TIn>(in)));
+      const auto& send = future.send().value;
+      auto& recv = future.result().value;
+      const int len = InData::size(send);
+      // the other processes would wait forever if root did not take part
+      auto* recvData = OutData::data(recv);
+      if(me == root && OutData::size(recv) < procs*len)
+        recvData = future.template errorBuffer<typename OutData::value_type>(
+          procs*len, "The output of igather is too small!");
+      Impl::CommProfileScope profile(CommunicationProfile::collectiveCommunication);
+      Impl::commProfileSent(CommunicationProfile::collectiveCommunication, -1, len*sizeof(Type));
+      MPI_Igather(const_cast<Type*>(InData::data(send)), len, MPITraits<Type>::getType(),
+                  recvData, len, MPITraits<typename OutData::value_type>::getType(),
+                  root, communicator, &future.request());
+      return future;
+    }
+
   private:
     MPI_Comm communicator;
     int me;
@@ -0,0 +1,199 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_COMMON_PARALLEL_MPIFUTURE_HH
+#define DUNE_COMMON_PARALLEL_MPIFUTURE_HH
+
+/*!
+   \file
+   \brief Futures returned by the nonblocking collective communication
+   of CollectiveCommunication<MPI_Comm>.
+
+   \ingroup ParallelCommunication
+ */
+
+#if HAVE_MPI
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/parallel/future.hh>
+
+namespace Dune
+{
+
+  /**
+   * @brief The future of a nonblocking collective communication with MPI.
+   *
+   * The future keeps the data the communication works on alive until the
+   * communication is completed. Data that was passed as an rvalue is
+   * moved into the future, data passed as an lvalue is referred to and
+   * must not be accessed before the communication is completed. The
+   * destructor waits for a communication that is still in progress.
+   *
+   * If the output of a process is too small, the process still takes part
+   * in the communication, so that it completes on all processes. Its
+   * future then throws RangeError from wait() and get().
+   *
+   * \code
+   * auto future = comm.iallreduce<std::plus<double> >(localDot);
+   * // ... compute something independent of the global dot product
+   * double dot = future.get();
+   * \endcode
+   *
+   * @tparam R The type of the result, a reference if the result is stored
+   * in data of the caller, void if there is no result.
+   * @tparam S The type of the data sent, void if the result is sent and
+   * received in place.
+   * @ingroup ParallelCommunication
+   */
+  template<class R, class S = void>
+  class MPIFuture
+  {
+    friend class CollectiveCommunication<MPI_Comm>;
+
+  public:
+    //! Construct an invalid future.
+    MPIFuture()
+      : request_(MPI_REQUEST_NULL)
+    {}
+
+    MPIFuture(MPIFuture&& other)
+      : result_(std::move(other.result_)), send_(std::move(other.send_)),
+        scratch_(std::move(other.scratch_)), error_(other.error_),
+        request_(other.request_)
+    {
+      other.error_ = nullptr;
+      other.request_ = MPI_REQUEST_NULL;
+    }
+
+    MPIFuture& operator=(MPIFuture&& other)
+    {
+      complete();
+      result_ = std::move(other.result_);
+      send_ = std::move(other.send_);
+      scratch_ = std::move(other.scratch_);
+      error_ = other.error_;
+      request_ = other.request_;
+      other.error_ = nullptr;
+      other.request_ = MPI_REQUEST_NULL;
+      return *this;
+    }
+
+    ~MPIFuture()
+    {
+      complete();
+    }
+
+    //! Whether the future has a result that was not yet retrieved.
+    bool valid() const
+    {
+      return result_ != nullptr;
+    }
+
+    //! Whether the communication is completed.
+    bool ready() const
+    {
+      if(!valid())
+        DUNE_THROW(InvalidStateException, "The future is not valid!");
+      int flag;
+      MPI_Test(&request_, &flag, MPI_STATUS_IGNORE);
+      return flag;
+    }
+
+    /**
+     * @brief Wait until the communication is completed.
+     *
+     * @throw RangeError if the output was too small, the future is no
+     * longer valid afterwards.
+     */
+    void wait()
+    {
+      if(!valid())
+        DUNE_THROW(InvalidStateException, "The future is not valid!");
+      MPI_Wait(&request_, MPI_STATUS_IGNORE);
+      if(error_)
+      {
+        const char* error = error_;
+        error_ = nullptr;
+        scratch_.clear();
+        send_.reset();
+        result_.reset();
+        DUNE_THROW(RangeError, error);
+      }
+    }
+
+    /**
+     * @brief Wait until the communication is completed and retrieve the result.
+     *
+     * Afterwards the future is no longer valid.
+     */
+    R get()
+    {
+      wait();
+      send_.reset();
+      std::unique_ptr<Impl::FutureData<R> > result = std::move(result_);
+      return result->take();
+    }
+
+  private:
+    // take ownership of the data of a communication that is started
+    // with request()
+    explicit MPIFuture(Impl::FutureData<R>* result, Impl::FutureData<S>* send = nullptr)
+      : result_(result), send_(send), request_(MPI_REQUEST_NULL)
+    {}
+
+    // the data is allocated separately so that its address does not
+    // change when the future is moved
+    Impl::FutureData<R>& result()
+    {
+      return *result_;
+    }
+
+    Impl::FutureData<S>& send()
+    {
+      return *send_;
+    }
+
+    MPI_Request& request()
+    {
+      return request_;
+    }
+
+    // a buffer for n items to receive into instead of an output that is
+    // too small, the error is reported when the communication is completed
+    template<class T>
+    T* errorBuffer(std::size_t n, const char* error)
+    {
+      scratch_.resize(n*sizeof(T));
+      error_ = error;
+      return reinterpret_cast<T*>(scratch_.data());
+    }
+
+    void complete()
+    {
+      if(request_ == MPI_REQUEST_NULL)
+        return;
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if(!finalized)
+        MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    }
+
+    std::unique_ptr<Impl::FutureData<R> > result_;
+    std::unique_ptr<Impl::FutureData<S> > send_;
+    std::vector<char> scratch_;
+    const char* error_ = nullptr;
+    mutable MPI_Request request_;
+  };
+
+} // end namespace Dune
+
+#endif // HAVE_MPI
+
+#endif // DUNE_COMMON_PARALLEL_MPIFUTURE_HH
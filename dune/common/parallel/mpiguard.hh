@@ -11,6 +11,9 @@
 #ifndef DUNE_COMMON_MPIGUARD_HH
 #define DUNE_COMMON_MPIGUARD_HH
 
+#include <functional>
+#include <utility>
+
 #include "mpihelper.hh"
 #include "collectivecommunication.hh"
 #include "mpicollectivecommunication.hh"
@@ -32,6 +35,9 @@ namespace Dune
     virtual int rank() = 0;
     virtual int size() = 0;
     virtual int sum(int i) = 0;
+    // start a nonblocking sum, completed by waitSum
+    virtual void startSum(int i) = 0;
+    virtual int waitSum() = 0;
     // create a new GuardCommunicator pointer
     template <class C>
     static GuardCommunicator * create(const C & c);
@@ -57,6 +63,10 @@ namespace Dune
       int rank() override { return comm.rank(); };
       int size() override { return comm.size(); };
       int sum(int i) override { return comm.sum(i); }
+      void startSum(int i) override { future = comm.template iallreduce<std::plus<int> >(std::move(i)); }
+      int waitSum() override { return future.get(); }
+      decltype(std::declval<const CollectiveCommunication<T>&>()
+               .template iallreduce<std::plus<int> >(std::declval<int>())) future;
     };
 
 #if HAVE_MPI
@@ -115,11 +125,34 @@ namespace Dune
      - MPIHelper
      - CollectiveCommunication
      - MPI_Comm
+
+     Every finalize() and every reactivate() of an active guard sums up
+     the errors of all processes and waits for the result. If the guard is
+     deferred by setDeferred(true), reactivate() only starts a nonblocking
+     sum for the section that just ended, which the next reactivate() or
+     finalize() completes. A guard that is reactivated at the end of every
+     step of a loop thus does not wait for the other processes in each
+     step, and an error is detected one step later:
+
+     @code
+     MPIGuard guard(comm);
+     guard.setDeferred(true);
+     for(int step=0; step<steps; ++step)
+     {
+       do_something();
+       // throws if an error occurred in the previous step on any process
+       guard.reactivate();
+     }
+     // throws if an error occurred in the last step on any process
+     guard.finalize();
+     @endcode
    */
   class MPIGuard
   {
     GuardCommunicator * comm_;
     bool active_;
+    bool deferred_ = false;
+    bool pending_ = false;
 
     // we don't want to copy this class
     MPIGuard (const MPIGuard &);
@@ -169,7 +202,10 @@ namespace Dune
       if (active_)
       {
         active_ = false;
-        finalize(false);
+        // the other processes detect an error in the pending sum and
+        // do not start another one
+        if (!pending_ || wait() == 0)
+          finalize(false);
       }
       delete comm_;
     }
@@ -177,20 +213,53 @@ namespace Dune
     /*! @brief reactivate the guard.
 
        If the guard is still active finalize(true) is called first.
+       If the guard is deferred, the errors of the section that just ended
+       are only communicated, and the errors of the section before are
+       detected instead. An exception of type MPIGuardError is thrown if an
+       error occurred on any of the processors in the communicator.
      */
     void reactivate() {
       if (active_ == true)
+      {
+        if (deferred_)
+        {
+          checkPending();
+          comm_->startSum(0);
+          pending_ = true;
+          return;
+        }
         finalize();
+      }
       active_ = true;
     }
 
+    /*! @brief Whether reactivate() only starts the communication of the errors.
+
+       This has to be set to the same value on all processes. If a sum of
+       the errors is still pending, it is completed first.
+
+       @throw MPIGuardError if an error occurred in the pending sum.
+     */
+    void setDeferred(bool deferred)
+    {
+      checkPending();
+      deferred_ = deferred;
+    }
+
+    //! @brief Whether reactivate() only starts the communication of the errors.
+    bool deferred() const
+    {
+      return deferred_;
+    }
+
     /*! @brief stop the guard.
 
        If no success parameter is passed, the guard assumes that
        everything worked as planned.  All errors are communicated
        and an exception of type MPIGuardError is thrown if an error
        (or exception) occurred on any of the processors in the
-       communicator.
+       communicator.  This includes the errors of a section ended
+       by a deferred reactivate().
 
        @param success inform the guard about possible errors
      */
@@ -199,7 +268,16 @@ namespace Dune
       int result = success ? 0 : 1;
       bool was_active = active_;
       active_ = false;
-      result = comm_->sum(result);
+      checkPending();
+      if (deferred_)
+      {
+        // all sums of a deferred guard are nonblocking, as they have to
+        // match the ones of the other processes
+        comm_->startSum(result);
+        result = comm_->waitSum();
+      }
+      else
+        result = comm_->sum(result);
       if (result>0 && was_active)
       {
         DUNE_THROW(MPIGuardError, "Terminating process "
@@ -207,6 +285,30 @@ namespace Dune
                    << result << " remote error(s)");
       }
     }
+
+  private:
+    // complete the pending sum of the errors
+    int wait()
+    {
+      pending_ = false;
+      return comm_->waitSum();
+    }
+
+    // complete the pending sum and stop the guard if an error occurred
+    // anywhere, then no process starts another sum
+    void checkPending()
+    {
+      if (!pending_)
+        return;
+      int result = wait();
+      if (result>0)
+      {
+        active_ = false;
+        DUNE_THROW(MPIGuardError, "Terminating process "
+                   << comm_->rank() << " due to "
+                   << result << " remote error(s)");
+      }
+    }
   };
 
 }
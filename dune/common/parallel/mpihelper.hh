@@ -7,10 +7,15 @@
 #include <cassert>
 #endif
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 #if HAVE_MPI
 #include <mpi.h>
 #endif
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/parallel/collectivecommunication.hh>
 #if HAVE_MPI
 #include <dune/common/parallel/mpicollectivecommunication.hh>
@@ -61,7 +66,36 @@ namespace Dune
    *
    * For checking whether we really use MPI or just fake please use
    * MPIHelper::isFake (this is also possible at compile time!)
+   *
+   * Threads that communicate concurrently need MPI to be initialized with
+   * MPIThreadLevel::multiple and a communicator each, so that their
+   * messages do not match the messages of other threads:
+   *   \code
+   *   int main(int argc, char** argv){
+   *      Dune::MPIHelper& helper =
+   *        Dune::MPIHelper::instance(argc, argv, Dune::MPIThreadLevel::multiple);
+   *      if(helper.threadLevel() == Dune::MPIThreadLevel::multiple)
+   *        helper.createThreadCommunicators(threads);
+   *      // in thread t
+   *      auto comm = helper.getThreadCommunicator(t);
+   *      ...
+   *   \endcode
+   */
+
+  /**
+   * @brief The thread support of MPI, in increasing order.
+   *
+   * The levels correspond to MPI_THREAD_SINGLE, MPI_THREAD_FUNNELED,
+   * MPI_THREAD_SERIALIZED and MPI_THREAD_MULTIPLE: only one thread exists,
+   * only the main thread calls MPI, only one thread calls MPI at a time,
+   * or all threads may call MPI concurrently.
+   *
+   * @ingroup ParallelCommunication
    */
+  enum class MPIThreadLevel {
+    single, funneled, serialized, multiple
+  };
+
   /**
    * @brief A fake mpi helper.
    *
@@ -130,10 +164,12 @@ namespace Dune
      * \endcode
      * @param argc The number of arguments provided to main.
      * @param argv The arguments provided to main.
+     * @param required The thread support requested, ignored.
      */
-    DUNE_EXPORT static FakeMPIHelper& instance(int argc, char** argv)
+    DUNE_EXPORT static FakeMPIHelper& instance(int argc, char** argv,
+                                               MPIThreadLevel required = MPIThreadLevel::single)
     {
-      (void)argc; (void)argv;
+      (void)argc; (void)argv; (void)required;
       // create singleton instance
       static FakeMPIHelper singleton;
       return singleton;
@@ -148,7 +184,49 @@ namespace Dune
      */
     int size () const { return 1; }
 
+    /**
+     * @brief The thread support granted, i.e. MPIThreadLevel::multiple
+     *
+     * Without MPI there is nothing that threads have to share.
+     */
+    MPIThreadLevel threadLevel () const { return MPIThreadLevel::multiple; }
+
+    /**
+     * @brief Provide communicators for the given number of threads.
+     *
+     * The fake communicator is shared by all threads.
+     */
+    void createThreadCommunicators (int threads)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      threads_ = std::max(threads_, threads);
+    }
+
+    /**
+     * @brief get the communicator of a thread, i.e. the fake communicator
+     *
+     * This method is thread safe.
+     * @throw RangeError if createThreadCommunicators() was not called for the thread.
+     */
+    MPICommunicator getThreadCommunicator (int thread) const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(thread < 0 || thread >= threads_)
+        DUNE_THROW(RangeError, "No communicator was created for thread " << thread << "!");
+      return getCommunicator();
+    }
+
+    //! The number of threads that have a communicator.
+    int threadCommunicators () const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return threads_;
+    }
+
   private:
+    mutable std::mutex mutex_;
+    int threads_ = 0;
+
     FakeMPIHelper() {}
     FakeMPIHelper(const FakeMPIHelper&);
     FakeMPIHelper& operator=(const FakeMPIHelper);
@@ -216,13 +294,20 @@ namespace Dune
      *   ...
      * }
      * \endcode
+     * The first call initializes MPI with MPI_Init_thread, requesting the
+     * thread support required. MPI may grant less, see threadLevel().
+     * If MPI was already initialized, the thread support it was
+     * initialized with is kept. The initialization is thread safe.
+     *
      * @param argc The number of arguments provided to main.
      * @param argv The arguments provided to main.
+     * @param required The thread support requested from MPI.
      */
-    DUNE_EXPORT static MPIHelper& instance(int& argc, char**& argv)
+    DUNE_EXPORT static MPIHelper& instance(int& argc, char**& argv,
+                                           MPIThreadLevel required = MPIThreadLevel::single)
     {
       // create singleton instance
-      static MPIHelper singleton (argc, argv);
+      static MPIHelper singleton (argc, argv, required);
       return singleton;
     }
 
@@ -235,26 +320,109 @@ namespace Dune
      */
     int size () const { return size_; }
 
+    /**
+     * @brief The thread support granted by MPI.
+     *
+     * Threads may only communicate concurrently if it is
+     * MPIThreadLevel::multiple.
+     */
+    MPIThreadLevel threadLevel () const { return threadLevel_; }
+
+    /**
+     * @brief Create a communicator for each of the given number of threads.
+     *
+     * The communicators are duplicates of MPI_COMM_WORLD, so that
+     * concurrent communication of different threads, e.g. halo exchanges
+     * of the same interface, does not mix up the messages. Communicators
+     * created by an earlier call are kept.
+     *
+     * This is a collective operation, it has to be called by one thread
+     * of every process with the same number of threads. They are freed
+     * before MPI_Finalize is called.
+     */
+    void createThreadCommunicators (int threads)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      while(int(threadCommunicators_.size()) < threads) {
+        MPI_Comm comm;
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        threadCommunicators_.push_back(comm);
+      }
+    }
+
+    /**
+     * @brief get the communicator of a thread
+     *
+     * This method is thread safe.
+     * @param thread The number of the thread, less than the number of
+     * threads passed to createThreadCommunicators().
+     * @throw RangeError if createThreadCommunicators() was not called for the thread.
+     */
+    MPICommunicator getThreadCommunicator (int thread) const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(thread < 0 || thread >= int(threadCommunicators_.size()))
+        DUNE_THROW(RangeError, "No communicator was created for thread " << thread << "!");
+      return threadCommunicators_[thread];
+    }
+
+    //! The number of threads that have a communicator.
+    int threadCommunicators () const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return threadCommunicators_.size();
+    }
+
   private:
     int rank_;
     int size_;
     bool initializedHere_;
-    void prevent_warning(int){}
+    MPIThreadLevel threadLevel_;
+    mutable std::mutex mutex_;
+    std::vector<MPI_Comm> threadCommunicators_;
+
+    static int mpiThreadLevel(MPIThreadLevel level)
+    {
+      switch(level) {
+      case MPIThreadLevel::funneled :
+        return MPI_THREAD_FUNNELED;
+      case MPIThreadLevel::serialized :
+        return MPI_THREAD_SERIALIZED;
+      case MPIThreadLevel::multiple :
+        return MPI_THREAD_MULTIPLE;
+      default :
+        return MPI_THREAD_SINGLE;
+      }
+    }
+
+    static MPIThreadLevel fromMPIThreadLevel(int level)
+    {
+      if(level >= MPI_THREAD_MULTIPLE)
+        return MPIThreadLevel::multiple;
+      if(level >= MPI_THREAD_SERIALIZED)
+        return MPIThreadLevel::serialized;
+      if(level >= MPI_THREAD_FUNNELED)
+        return MPIThreadLevel::funneled;
+      return MPIThreadLevel::single;
+    }
 
-    //! \brief calls MPI_Init with argc and argv as parameters
-    MPIHelper(int& argc, char**& argv)
+    //! \brief calls MPI_Init_thread with argc and argv as parameters
+    MPIHelper(int& argc, char**& argv, MPIThreadLevel required)
     : initializedHere_(false)
     {
       int wasInitialized = -1;
       MPI_Initialized( &wasInitialized );
+      int provided = MPI_THREAD_SINGLE;
       if(!wasInitialized)
       {
         rank_ = -1;
         size_ = -1;
-        static int is_initialized = MPI_Init(&argc, &argv);
-        prevent_warning(is_initialized);
+        MPI_Init_thread(&argc, &argv, mpiThreadLevel(required), &provided);
         initializedHere_ = true;
       }
+      else
+        MPI_Query_thread(&provided);
+      threadLevel_ = fromMPIThreadLevel(provided);
 
       MPI_Comm_rank(MPI_COMM_WORLD,&rank_);
       MPI_Comm_size(MPI_COMM_WORLD,&size_);
@@ -264,11 +432,14 @@ namespace Dune
 
       dverb << "Called  MPI_Init on p=" << rank_ << "!" << std::endl;
     }
-    //! \brief calls MPI_Finalize
+    //! \brief frees the thread communicators and calls MPI_Finalize
     ~MPIHelper()
     {
       int wasFinalized = -1;
       MPI_Finalized( &wasFinalized );
+      if(!wasFinalized)
+        for(MPI_Comm& comm : threadCommunicators_)
+          MPI_Comm_free(&comm);
       if(!wasFinalized && initializedHere_)
       {
         MPI_Finalize();
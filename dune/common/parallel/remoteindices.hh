@@ -5,18 +5,25 @@
 
 #if HAVE_MPI
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <ostream>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <mpi.h>
 
 #include <dune/common/exceptions.hh>
+#include <dune/common/parallel/communicationprofile.hh>
 #include <dune/common/parallel/indexset.hh>
 #include <dune/common/parallel/mpitraits.hh>
 #include <dune/common/parallel/plocalindex.hh>
@@ -51,6 +58,71 @@ namespace Dune {
   template<typename T1, typename T2>
   class RemoteIndex;
 
+#ifndef DOXYGEN
+  namespace Impl {
+
+    // Assigns global indices to the processes of a distributed directory
+    // by hashing them.
+    template<class G, bool = std::is_integral<G>::value>
+    class RemoteIndicesDirectory
+    {
+    public:
+      RemoteIndicesDirectory(const std::vector<G>&, MPI_Comm comm)
+      {
+        MPI_Comm_size(comm, &procs_);
+      }
+
+      int operator()(const G& global) const
+      {
+        return std::hash<G>()(global) % procs_;
+      }
+
+    private:
+      int procs_;
+    };
+
+    // Assigns consecutive ranges of integral global indices to the
+    // processes, so that a process with consecutive indices only talks
+    // to few directory processes.
+    template<class G>
+    class RemoteIndicesDirectory<G,true>
+    {
+    public:
+      // indices has to be sorted
+      RemoteIndicesDirectory(const std::vector<G>& indices, MPI_Comm comm)
+      {
+        int procs;
+        MPI_Comm_size(comm, &procs);
+        G local[2] = {std::numeric_limits<G>::max(), std::numeric_limits<G>::lowest()};
+        if(!indices.empty()) {
+          local[0] = indices.front();
+          local[1] = indices.back();
+        }
+        G max;
+        MPI_Allreduce(&local[0], &min_, 1, MPITraits<G>::getType(), MPI_MIN, comm);
+        MPI_Allreduce(&local[1], &max, 1, MPITraits<G>::getType(), MPI_MAX, comm);
+        width_ = min_ <= max ? (offset(max) / procs) + 1 : 1;
+      }
+
+      int operator()(const G& global) const
+      {
+        return offset(global) / width_;
+      }
+
+    private:
+      std::uint64_t offset(const G& global) const
+      {
+        // the unsigned difference is exact for signed types, too
+        return static_cast<std::uint64_t>(global) - static_cast<std::uint64_t>(min_);
+      }
+
+      G min_;
+      std::uint64_t width_;
+    };
+
+  } // end namespace Impl
+#endif // DOXYGEN
+
   // forward declaration needed for friend declaration.
   template<typename T>
   class IndicesSyncer;
@@ -174,10 +246,15 @@ namespace Dune {
    * are attached to them on the remote side.
    *
    * This information is managed by this class. The information can either
-   * be computed automatically calling rebuild (which requires information
-   * to be sent in a ring) or set up by hand using the
+   * be computed automatically calling rebuild or set up by hand using the
    * RemoteIndexListModifiers returned by function getModifier(int).
    *
+   * If the neighbours are not known, rebuild has to find them first. By
+   * default all indices are sent in a ring through all processes, which
+   * needs O(P) messages of the size of the largest index set. With
+   * setNeighbourDiscovery(directory) a distributed directory of the
+   * global indices is used instead, see NeighbourDiscovery.
+   *
    * @tparam T The type of the underlying index set.
    * @tparam A The type of the allocator to use.
    */
@@ -244,6 +321,33 @@ namespace Dune {
 
     typedef typename RemoteIndexMap::const_iterator const_iterator;
 
+    /**
+     * @brief How rebuild() finds the neighbours if they were not set.
+     */
+    enum NeighbourDiscovery {
+      /**
+       * @brief Send the indices of every process in a ring through all
+       * processes.
+       */
+      ring,
+      /**
+       * @brief Find the neighbours with a distributed directory.
+       *
+       * Every global index is assigned to a directory process, by ranges
+       * for integral global indices and by std::hash otherwise. Each
+       * process sends its global indices to their directory processes,
+       * which return the other processes knowing the same indices. The
+       * number of messages and their sizes only depend on the number of
+       * indices and neighbours, apart from an MPI_Alltoall of the message
+       * sizes. Afterwards the indices are exchanged with the neighbours
+       * only.
+       *
+       * If the global indices are not integral, std::hash has to be
+       * specialized for them.
+       */
+      directory
+    };
+
     /**
      * @brief Constructor.
      * @param comm The communicator to use.
@@ -307,6 +411,24 @@ namespace Dune {
       return neighbourIds;
     }
 
+    /**
+     * @brief Set how rebuild() finds the neighbours if they were not set.
+     *
+     * The default is ring.
+     */
+    void setNeighbourDiscovery(NeighbourDiscovery discovery)
+    {
+      discovery_ = discovery;
+    }
+
+    /**
+     * @brief Get how rebuild() finds the neighbours if they were not set.
+     */
+    NeighbourDiscovery neighbourDiscovery() const
+    {
+      return discovery_;
+    }
+
     /**
      * @brief Destructor.
      */
@@ -324,6 +446,38 @@ namespace Dune {
     template<bool ignorePublic>
     void rebuild();
 
+    /**
+     * @brief Start an incremental update of the remote indices.
+     *
+     * Has to be called before the index set is changed with
+     * ParallelIndexSet::beginResize(). After ParallelIndexSet::endResize()
+     * endUpdate() patches the remote index lists. Compared to rebuild(),
+     * only the indices that were added, removed or changed their attribute
+     * or public flag are sent, and only to the current neighbours.
+     *
+     * Only supported if the source and the destination index set are the
+     * same and includeSelf is false.
+     *
+     * @throw InvalidStateException if the remote indices are not synced.
+     * @throw NotImplemented if there are two index sets or includeSelf is set.
+     */
+    void beginUpdate();
+
+    /**
+     * @brief Complete an incremental update started by beginUpdate().
+     *
+     * Has to be called by this process and all its neighbours. If the
+     * template parameter ignorePublic is true all indices will be treated
+     * as public.
+     *
+     * @warning Indices shared with processes that are no neighbours yet are
+     * not found. In that case rebuild() has to be used.
+     *
+     * @throw InvalidStateException if beginUpdate() was not called.
+     */
+    template<bool ignorePublic>
+    void endUpdate();
+
     bool operator==(const RemoteIndices& ri);
 
     /**
@@ -418,6 +572,9 @@ namespace Dune {
      * If not empty this will speedup rebuild. */
     std::set<int> neighbourIds;
 
+    /** @brief How the neighbours are found if neighbourIds is empty. */
+    NeighbourDiscovery discovery_;
+
     /** @brief The communicator tag to use. */
     const static int commTag_=333;
 
@@ -463,6 +620,15 @@ namespace Dune {
      */
     RemoteIndexMap remoteIndices_;
 
+    /** @brief Whether beginUpdate() was called and endUpdate() not yet. */
+    bool updating_;
+
+    /** @brief The index pairs of the index set when beginUpdate() was called. */
+    std::vector<PairType> updateIndices_;
+
+    /** @brief The modifiers of the remote index lists during an update. */
+    std::map<int,std::unique_ptr<RemoteIndexListModifier<T,A,true> > > updateModifiers_;
+
     /**
      * @brief Build the remote mapping.
      *
@@ -476,6 +642,17 @@ namespace Dune {
     template<bool ignorePublic>
     inline void buildRemote(bool includeSelf);
 
+    /**
+     * @brief Find the processes that know one of our global indices
+     * using a distributed directory.
+     *
+     * If the template parameter ignorePublic is true all indices will be treated
+     * as public.
+     * @param neighbours The set to store the ranks of the neighbours in.
+     */
+    template<bool ignorePublic>
+    void discoverNeighbours(std::set<int>& neighbours);
+
     /**
      * @brief Count the number of public indices in an index set.
      * @param indexSet The index set whose indices we count.
@@ -962,8 +1139,8 @@ namespace Dune {
                                            const std::vector<int>& neighbours,
                                            bool includeSelf_)
     : source_(&source), target_(&destination), comm_(comm),
-      sourceSeqNo_(-1), destSeqNo_(-1), publicIgnored(false), firstBuild(true),
-      includeSelf(includeSelf_)
+      discovery_(ring), sourceSeqNo_(-1), destSeqNo_(-1), publicIgnored(false),
+      firstBuild(true), includeSelf(includeSelf_), updating_(false)
   {
     setNeighbours(neighbours);
   }
@@ -976,9 +1153,9 @@ namespace Dune {
 
   template<typename T, typename A>
   RemoteIndices<T,A>::RemoteIndices()
-    : source_(0), target_(0), sourceSeqNo_(-1),
+    : source_(0), target_(0), discovery_(ring), sourceSeqNo_(-1),
       destSeqNo_(-1), publicIgnored(false), firstBuild(true),
-      includeSelf(false)
+      includeSelf(false), updating_(false)
   {}
 
   template<class T, typename A>
@@ -1150,6 +1327,8 @@ namespace Dune {
       // Nothing to communicate
       return;
 
+    Impl::CommProfileScope profile(CommunicationProfile::remoteIndices);
+
     sourcePublish = (ignorePublic) ? source_->size() : noPublic(*source_);
 
     if(sendTwo)
@@ -1158,10 +1337,7 @@ namespace Dune {
       // we only need to send one set of indices
       destPublish = 0;
 
-    int maxPublish, publish=sourcePublish+destPublish;
-
-    // Calucate maximum number of indices send
-    MPI_Allreduce(&publish, &maxPublish, 1, MPI_INT, MPI_MAX, comm_);
+    int publish=sourcePublish+destPublish;
 
     // allocate buffers
     typedef IndexPair<GlobalIndex,LocalIndex> PairType;
@@ -1174,7 +1350,6 @@ namespace Dune {
     else
       destPairs=sourcePairs;
 
-    char** buffer = new char*[2];
     int bufferSize;
     int position=0;
     int intSize;
@@ -1183,7 +1358,7 @@ namespace Dune {
     // calculate buffer size
     MPI_Datatype type = MPITraits<PairType>::getType();
 
-    MPI_Pack_size(maxPublish, type, comm_,
+    MPI_Pack_size(publish, type, comm_,
                   &bufferSize);
     MPI_Pack_size(1, MPI_INT, comm_,
                   &intSize);
@@ -1197,39 +1372,54 @@ namespace Dune {
 
     if(bufferSize<=0) bufferSize=1;
 
-    buffer[0] = new char[bufferSize];
-    buffer[1] = new char[bufferSize];
-
-
-    // pack entries into buffer[0], p_out below!
-    MPI_Pack(&sendTwo, 1, MPI_CHAR, buffer[0], bufferSize, &position,
-             comm_);
-
-    // The number of indices we send for each index set
-    MPI_Pack(&sourcePublish, 1, MPI_INT, buffer[0], bufferSize, &position,
-             comm_);
-    MPI_Pack(&destPublish, 1, MPI_INT, buffer[0], bufferSize, &position,
-             comm_);
+    std::vector<char> sendBuffer(bufferSize);
 
-    // Now pack the source indices and setup the destination pairs
-    packEntries<ignorePublic>(sourcePairs, *source_, buffer[0], type,
-                              bufferSize, &position, sourcePublish);
-    // If necessary send the dest indices and setup the source pairs
-    if(sendTwo)
-      packEntries<ignorePublic>(destPairs, *target_, buffer[0], type,
-                                bufferSize, &position, destPublish);
+    {
+      Impl::CommProfileTimer timer(CommunicationProfile::remoteIndices, CommunicationProfile::packTime);
+
+      // pack entries into the send buffer
+      MPI_Pack(&sendTwo, 1, MPI_CHAR, sendBuffer.data(), bufferSize, &position,
+               comm_);
+
+      // The number of indices we send for each index set
+      MPI_Pack(&sourcePublish, 1, MPI_INT, sendBuffer.data(), bufferSize, &position,
+               comm_);
+      MPI_Pack(&destPublish, 1, MPI_INT, sendBuffer.data(), bufferSize, &position,
+               comm_);
+
+      // Now pack the source indices and setup the destination pairs
+      packEntries<ignorePublic>(sourcePairs, *source_, sendBuffer.data(), type,
+                                bufferSize, &position, sourcePublish);
+      // If necessary send the dest indices and setup the source pairs
+      if(sendTwo)
+        packEntries<ignorePublic>(destPairs, *target_, sendBuffer.data(), type,
+                                  bufferSize, &position, destPublish);
+    }
 
 
     // Update remote indices for ourself
     if(sendTwo|| includeSelf_)
-      unpackCreateRemote(buffer[0], sourcePairs, destPairs, rank, sourcePublish,
+      unpackCreateRemote(sendBuffer.data(), sourcePairs, destPairs, rank, sourcePublish,
                          destPublish, bufferSize, sendTwo, includeSelf_);
 
     neighbourIds.erase(rank);
 
-    if(neighbourIds.size()==0)
+    std::set<int> discoveredIds;
+    if(neighbourIds.size()==0 && discovery_==directory)
+      discoverNeighbours<ignorePublic>(discoveredIds);
+    const std::set<int>& neighbours = neighbourIds.size()==0 ? discoveredIds : neighbourIds;
+
+    if(neighbourIds.size()==0 && discovery_==ring)
     {
       Dune::dvverb<<rank<<": Sending messages in a ring"<<std::endl;
+
+      // Calculate maximum number of indices send
+      int maxBufferSize;
+      MPI_Allreduce(&bufferSize, &maxBufferSize, 1, MPI_INT, MPI_MAX, comm_);
+
+      char* buffer[2] = {new char[maxBufferSize], new char[maxBufferSize]};
+      std::copy(sendBuffer.begin(), sendBuffer.end(), buffer[0]);
+
       // send messages in ring
       for(int proc=1; proc<procs; proc++) {
         // pointers to the current input and output buffers
@@ -1237,15 +1427,17 @@ namespace Dune {
         char* p_in = buffer[proc%2];
 
         MPI_Status status;
+        Impl::commProfileSent(CommunicationProfile::remoteIndices, (rank+1)%procs, maxBufferSize);
+        Impl::commProfileReceived(CommunicationProfile::remoteIndices, (rank+procs-1)%procs, maxBufferSize);
         if(rank%2==0) {
-          MPI_Ssend(p_out, bufferSize, MPI_PACKED, (rank+1)%procs,
+          MPI_Ssend(p_out, maxBufferSize, MPI_PACKED, (rank+1)%procs,
                     commTag_, comm_);
-          MPI_Recv(p_in, bufferSize, MPI_PACKED, (rank+procs-1)%procs,
+          MPI_Recv(p_in, maxBufferSize, MPI_PACKED, (rank+procs-1)%procs,
                    commTag_, comm_, &status);
         }else{
-          MPI_Recv(p_in, bufferSize, MPI_PACKED, (rank+procs-1)%procs,
+          MPI_Recv(p_in, maxBufferSize, MPI_PACKED, (rank+procs-1)%procs,
                    commTag_, comm_, &status);
-          MPI_Ssend(p_out, bufferSize, MPI_PACKED, (rank+1)%procs,
+          MPI_Ssend(p_out, maxBufferSize, MPI_PACKED, (rank+1)%procs,
                     commTag_, comm_);
         }
 
@@ -1253,29 +1445,34 @@ namespace Dune {
         // The process these indices are from
         int remoteProc = (rank+procs-proc)%procs;
 
+        Impl::CommProfileTimer timer(CommunicationProfile::remoteIndices, CommunicationProfile::unpackTime);
         unpackCreateRemote(p_in, sourcePairs, destPairs, remoteProc, sourcePublish,
-                           destPublish, bufferSize, sendTwo);
+                           destPublish, maxBufferSize, sendTwo);
 
       }
 
+      delete[] buffer[0];
+      delete[] buffer[1];
     }
     else
     {
-      MPI_Request* requests=new MPI_Request[neighbourIds.size()];
+      MPI_Request* requests=new MPI_Request[neighbours.size()];
       MPI_Request* req=requests;
 
       typedef typename std::set<int>::size_type size_type;
-      size_type noNeighbours=neighbourIds.size();
+      size_type noNeighbours=neighbours.size();
 
       // setup sends
-      for(std::set<int>::iterator neighbour=neighbourIds.begin();
-          neighbour!= neighbourIds.end(); ++neighbour) {
+      for(std::set<int>::const_iterator neighbour=neighbours.begin();
+          neighbour!= neighbours.end(); ++neighbour) {
         // Only send the information to the neighbouring processors
-        MPI_Issend(buffer[0], position , MPI_PACKED, *neighbour, commTag_, comm_, req++);
+        Impl::commProfileSent(CommunicationProfile::remoteIndices, *neighbour, position);
+        MPI_Issend(sendBuffer.data(), position , MPI_PACKED, *neighbour, commTag_, comm_, req++);
       }
 
       //Test for received messages
 
+      std::vector<char> recvBuffer;
       for(size_type received=0; received <noNeighbours; ++received)
       {
         MPI_Status status;
@@ -1284,18 +1481,21 @@ namespace Dune {
         int remoteProc=status.MPI_SOURCE;
         int size;
         MPI_Get_count(&status, MPI_PACKED, &size);
-        // receive message
-        MPI_Recv(buffer[1], size, MPI_PACKED, remoteProc,
+        // receive message into a buffer of its size
+        recvBuffer.resize(size>0 ? size : 1);
+        MPI_Recv(recvBuffer.data(), size, MPI_PACKED, remoteProc,
                  commTag_, comm_, &status);
+        Impl::commProfileReceived(CommunicationProfile::remoteIndices, remoteProc, size);
 
-        unpackCreateRemote(buffer[1], sourcePairs, destPairs, remoteProc, sourcePublish,
-                           destPublish, bufferSize, sendTwo);
+        Impl::CommProfileTimer timer(CommunicationProfile::remoteIndices, CommunicationProfile::unpackTime);
+        unpackCreateRemote(recvBuffer.data(), sourcePairs, destPairs, remoteProc, sourcePublish,
+                           destPublish, size, sendTwo);
       }
       // wait for completion of pending requests
-      MPI_Status* statuses = new MPI_Status[neighbourIds.size()];
+      MPI_Status* statuses = new MPI_Status[neighbours.size()];
 
-      if(MPI_ERR_IN_STATUS==MPI_Waitall(neighbourIds.size(), requests, statuses)) {
-        for(size_type i=0; i < neighbourIds.size(); ++i)
+      if(MPI_ERR_IN_STATUS==MPI_Waitall(neighbours.size(), requests, statuses)) {
+        for(size_type i=0; i < neighbours.size(); ++i)
           if(statuses[i].MPI_ERROR!=MPI_SUCCESS) {
             std::cerr<<rank<<": MPI_Error occurred while receiving message."<<std::endl;
             MPI_Abort(comm_, 999);
@@ -1311,9 +1511,113 @@ namespace Dune {
       delete[] destPairs;
 
     delete[] sourcePairs;
-    delete[] buffer[0];
-    delete[] buffer[1];
-    delete[] buffer;
+  }
+
+  template<typename T, typename A>
+  template<bool ignorePublic>
+  void RemoteIndices<T,A>::discoverNeighbours(std::set<int>& neighbours)
+  {
+    int rank, procs;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &procs);
+
+    // the global indices we know
+    std::vector<GlobalIndex> known;
+    typedef typename ParallelIndexSet::const_iterator const_iterator;
+    for(const_iterator index = source_->begin(); index != source_->end(); ++index)
+      if(ignorePublic || index->local().isPublic())
+        known.push_back(index->global());
+    if(source_ != target_)
+      for(const_iterator index = target_->begin(); index != target_->end(); ++index)
+        if(ignorePublic || index->local().isPublic())
+          known.push_back(index->global());
+    std::sort(known.begin(), known.end());
+    known.erase(std::unique(known.begin(), known.end()), known.end());
+
+    // sort them by their directory process
+    Impl::RemoteIndicesDirectory<GlobalIndex> directory(known, comm_);
+    std::vector<int> owner(known.size());
+    std::vector<int> sendCounts(procs, 0), recvCounts(procs);
+    for(std::size_t i=0; i<known.size(); ++i)
+      ++sendCounts[owner[i] = directory(known[i])];
+
+    std::vector<int> sendOffsets(procs+1, 0), recvOffsets(procs+1, 0);
+    std::partial_sum(sendCounts.begin(), sendCounts.end(), sendOffsets.begin()+1);
+    std::vector<GlobalIndex> sendIndices(known.size());
+    {
+      std::vector<int> next(sendOffsets.begin(), sendOffsets.end()-1);
+      for(std::size_t i=0; i<known.size(); ++i)
+        sendIndices[next[owner[i]]++] = known[i];
+    }
+
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm_);
+    std::partial_sum(recvCounts.begin(), recvCounts.end(), recvOffsets.begin()+1);
+    std::vector<GlobalIndex> recvIndices(recvOffsets[procs]);
+
+    std::vector<MPI_Request> requests;
+    MPI_Datatype type = MPITraits<GlobalIndex>::getType();
+    for(int p=0; p<procs; ++p)
+      if(recvCounts[p]>0) {
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Irecv(recvIndices.data()+recvOffsets[p], recvCounts[p], type, p,
+                  commTag_+1, comm_, &requests.back());
+      }
+    for(int p=0; p<procs; ++p)
+      if(sendCounts[p]>0) {
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Isend(sendIndices.data()+sendOffsets[p], sendCounts[p], type, p,
+                  commTag_+1, comm_, &requests.back());
+      }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    requests.clear();
+
+    // For the global indices we are the directory of, tell every process
+    // knowing one of them the other processes knowing it.
+    std::vector<std::pair<GlobalIndex,int> > entries;
+    entries.reserve(recvIndices.size());
+    for(int p=0; p<procs; ++p)
+      for(int i=recvOffsets[p]; i<recvOffsets[p+1]; ++i)
+        entries.push_back(std::make_pair(recvIndices[i], p));
+    std::sort(entries.begin(), entries.end());
+
+    std::map<int,std::set<int> > answers;
+    for(std::size_t first=0, last=0; first<entries.size(); first=last) {
+      while(last<entries.size() && entries[last].first==entries[first].first)
+        ++last;
+      for(std::size_t i=first; i<last; ++i)
+        for(std::size_t j=first; j<last; ++j)
+          if(i!=j)
+            answers[entries[i].second].insert(entries[j].second);
+    }
+
+    std::fill(sendCounts.begin(), sendCounts.end(), 0);
+    std::vector<int> answerRanks;
+    for(const auto& answer : answers) {
+      sendCounts[answer.first] = answer.second.size();
+      answerRanks.insert(answerRanks.end(), answer.second.begin(), answer.second.end());
+    }
+    std::partial_sum(sendCounts.begin(), sendCounts.end(), sendOffsets.begin()+1);
+
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm_);
+    std::partial_sum(recvCounts.begin(), recvCounts.end(), recvOffsets.begin()+1);
+    std::vector<int> neighbourRanks(recvOffsets[procs]);
+
+    for(int p=0; p<procs; ++p)
+      if(recvCounts[p]>0) {
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Irecv(neighbourRanks.data()+recvOffsets[p], recvCounts[p], MPI_INT, p,
+                  commTag_+2, comm_, &requests.back());
+      }
+    for(int p=0; p<procs; ++p)
+      if(sendCounts[p]>0) {
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Isend(answerRanks.data()+sendOffsets[p], sendCounts[p], MPI_INT, p,
+                  commTag_+2, comm_, &requests.back());
+      }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    neighbours.insert(neighbourRanks.begin(), neighbourRanks.end());
+    neighbours.erase(rank);
   }
 
   template<typename T, typename A>
@@ -1447,6 +1751,9 @@ namespace Dune {
     }
     remoteIndices_.clear();
     firstBuild=true;
+    updateModifiers_.clear();
+    updateIndices_.clear();
+    updating_=false;
   }
 
   template<typename T, typename A>
@@ -1476,6 +1783,191 @@ namespace Dune {
 
   }
 
+  template<typename T, typename A>
+  void RemoteIndices<T,A>::beginUpdate()
+  {
+    if(source_ != target_ || includeSelf)
+      DUNE_THROW(NotImplemented, "Incremental updates of remote indices are only implemented for one index set without includeSelf!");
+    if(firstBuild || !isSynced())
+      DUNE_THROW(InvalidStateException, "The remote indices have to be synced with the index set before an update!");
+    if(updating_)
+      DUNE_THROW(InvalidStateException, "An update of the remote indices was already started!");
+
+    updateIndices_.assign(source_->begin(), source_->end());
+
+    // The modifiers remember the global indices of the lists, which allows
+    // to repair the pointers to the local index pairs after the update.
+    typedef typename RemoteIndexMap::iterator Iterator;
+    for(Iterator lists=remoteIndices_.begin(); lists != remoteIndices_.end(); ++lists)
+      updateModifiers_[lists->first].reset(new RemoteIndexListModifier<T,A,true>(*source_, *(lists->second.first)));
+
+    updating_ = true;
+  }
+
+  template<typename T, typename A>
+  template<bool ignorePublic>
+  void RemoteIndices<T,A>::endUpdate()
+  {
+    if(!updating_)
+      DUNE_THROW(InvalidStateException, "No update of the remote indices was started!");
+
+    if(ignorePublic != publicIgnored) {
+      // all published indices change
+      updateModifiers_.clear();
+      updateIndices_.clear();
+      updating_ = false;
+      firstBuild = true;
+      rebuild<ignorePublic>();
+      return;
+    }
+
+    Impl::CommProfileScope profile(CommunicationProfile::remoteIndices);
+
+    typedef typename ParallelIndexSet::const_iterator const_iterator;
+    typedef typename std::map<int,std::unique_ptr<RemoteIndexListModifier<T,A,true> > >::iterator ModifierIterator;
+
+    auto published = [](const PairType& pair) {
+                       return ignorePublic || pair.local().isPublic();
+                     };
+    auto globalLess = [](const PairType& pair, const GlobalIndex& global) {
+                        return pair.global() < global;
+                      };
+
+    // Compare the old and the new index set. An index whose attribute
+    // changed is removed and added again.
+    std::vector<PairType> removed, added;
+    typename std::vector<PairType>::const_iterator old = updateIndices_.begin();
+    const typename std::vector<PairType>::const_iterator oldEnd = updateIndices_.end();
+    const_iterator index = source_->begin();
+    const const_iterator end = source_->end();
+    while(old != oldEnd || index != end) {
+      if(index == end || (old != oldEnd && old->global() < index->global())) {
+        if(published(*old))
+          removed.push_back(*old);
+        ++old;
+      }else if(old == oldEnd || index->global() < old->global()) {
+        if(published(*index))
+          added.push_back(*index);
+        ++index;
+      }else{
+        const bool changed = published(*old) != published(*index)
+                             || old->local().attribute() != index->local().attribute();
+        if(changed && published(*old))
+          removed.push_back(*old);
+        if(changed && published(*index))
+          added.push_back(*index);
+        ++old;
+        ++index;
+      }
+    }
+
+    MPI_Datatype type = MPITraits<PairType>::getType();
+    std::vector<MPI_Request> requests;
+    auto send = [&](std::vector<PairType>& pairs, int proc, int tag) {
+                  Impl::commProfileSent(CommunicationProfile::remoteIndices, proc, pairs.size()*sizeof(PairType));
+                  requests.push_back(MPI_REQUEST_NULL);
+                  MPI_Isend(pairs.data(), pairs.size(), type, proc, tag, comm_, &requests.back());
+                };
+    auto receive = [&](std::vector<PairType>& pairs, int proc, int tag) {
+                     MPI_Status status;
+                     int count;
+                     MPI_Probe(proc, tag, comm_, &status);
+                     MPI_Get_count(&status, type, &count);
+                     pairs.resize(count);
+                     MPI_Recv(pairs.data(), count, type, proc, tag, comm_, MPI_STATUS_IGNORE);
+                     Impl::commProfileReceived(CommunicationProfile::remoteIndices, proc, count*sizeof(PairType));
+                   };
+
+    // Send the removed indices that the neighbour knows and all added
+    // indices to each neighbour.
+    std::map<int,std::vector<PairType> > removedFor, theirRemoved, theirAdded, replies, theirReplies;
+    for(ModifierIterator m = updateModifiers_.begin(); m != updateModifiers_.end(); ++m) {
+      std::vector<PairType>& pairs = removedFor[m->first];
+      typename RemoteIndexListModifier<T,A,true>::GlobalList::const_iterator
+        global = m->second->glist_.begin(), globalEnd = m->second->glist_.end();
+      for(const PairType& pair : removed) {
+        while(global != globalEnd && *global < pair.global())
+          ++global;
+        if(global != globalEnd && *global == pair.global())
+          pairs.push_back(pair);
+      }
+      send(pairs, m->first, commTag_+3);
+      send(added, m->first, commTag_+4);
+    }
+
+    // For the indices added by a neighbour that we know and did not add
+    // ourselves, the neighbour needs our attribute.
+    for(ModifierIterator m = updateModifiers_.begin(); m != updateModifiers_.end(); ++m) {
+      receive(theirRemoved[m->first], m->first, commTag_+3);
+      receive(theirAdded[m->first], m->first, commTag_+4);
+      std::vector<PairType>& pairs = replies[m->first];
+      for(const PairType& pair : theirAdded[m->first]) {
+        const_iterator mine = std::lower_bound(source_->begin(), end, pair.global(), globalLess);
+        if(mine != end && mine->global() == pair.global() && published(*mine)) {
+          typename std::vector<PairType>::const_iterator own
+            = std::lower_bound(added.begin(), added.end(), pair.global(), globalLess);
+          if(own == added.end() || own->global() != pair.global())
+            pairs.push_back(*mine);
+        }
+      }
+      send(pairs, m->first, commTag_+5);
+    }
+
+    for(ModifierIterator m = updateModifiers_.begin(); m != updateModifiers_.end(); ++m)
+      receive(theirReplies[m->first], m->first, commTag_+5);
+
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    // Patch the remote index lists in ascending order of the global indices.
+    for(ModifierIterator m = updateModifiers_.begin(); m != updateModifiers_.end(); ++m) {
+      const int proc = m->first;
+      std::vector<GlobalIndex> removals;
+      for(const PairType& pair : removedFor[proc])
+        removals.push_back(pair.global());
+      for(const PairType& pair : theirRemoved[proc])
+        removals.push_back(pair.global());
+      std::sort(removals.begin(), removals.end());
+      removals.erase(std::unique(removals.begin(), removals.end()), removals.end());
+
+      std::vector<std::pair<GlobalIndex,Attribute> > insertions;
+      for(const PairType& pair : theirAdded[proc]) {
+        const_iterator mine = std::lower_bound(source_->begin(), end, pair.global(), globalLess);
+        if(mine != end && mine->global() == pair.global() && published(*mine))
+          insertions.push_back(std::make_pair(pair.global(), pair.local().attribute()));
+      }
+      for(const PairType& pair : theirReplies[proc])
+        insertions.push_back(std::make_pair(pair.global(), pair.local().attribute()));
+      std::sort(insertions.begin(), insertions.end());
+
+      RemoteIndexListModifier<T,A,true>& modifier = *(m->second);
+      std::size_t i=0, j=0;
+      while(i < removals.size() || j < insertions.size()) {
+        if(j == insertions.size() || (i < removals.size() && !(insertions[j].first < removals[i])))
+          modifier.remove(removals[i++]);
+        else{
+          modifier.insert(RemoteIndex(insertions[j].second), insertions[j].first);
+          ++j;
+        }
+      }
+      modifier.repairLocalIndexPointers();
+    }
+    updateModifiers_.clear();
+    updateIndices_.clear();
+    updating_ = false;
+
+    // drop the neighbours we do not share indices with any more
+    typedef typename RemoteIndexMap::iterator Iterator;
+    for(Iterator lists=remoteIndices_.begin(); lists != remoteIndices_.end();)
+      if(lists->second.first->empty()) {
+        delete lists->second.first;
+        remoteIndices_.erase(lists++);
+      }else
+        ++lists;
+
+    sourceSeqNo_ = source_->seqNo();
+    destSeqNo_ = target_->seqNo();
+  }
+
   template<typename T, typename A>
   inline bool RemoteIndices<T,A>::isSynced() const
   {
@@ -1596,7 +2088,7 @@ namespace Dune {
       GlobalIterator giter = glist_.begin();
       IndexIterator index = indexSet_->begin();
 
-      for(Iterator iter=rList_->begin(); iter != end_; ++iter) {
+      for(Iterator iter=rList_->begin(); iter != end_; ++iter, ++giter) {
         while(index->global()<*giter) {
           ++index;
 #ifdef DUNE_ISTL_WITH_CHECKING
@@ -1654,7 +2146,7 @@ namespace Dune {
     }
 
     // No duplicate entries allowed
-    assert(iter_->localIndexPair().global() != global);
+    assert(iter_ == end_ || *giter_ != global);
     iter_.insert(index);
     giter_.insert(global);
 
@@ -1678,7 +2170,7 @@ namespace Dune {
         ++giter_;
         ++iter_;
       }
-      if(*giter_ == global) {
+      if(iter_!=end_ && *giter_ == global) {
         giter_.remove();
         iter_.remove();
         found=true;
@@ -1687,7 +2179,7 @@ namespace Dune {
       while(iter_!=end_ && iter_->localIndexPair().global() < global)
         ++iter_;
 
-      if(iter_->localIndexPair().global()==global) {
+      if(iter_!=end_ && iter_->localIndexPair().global()==global) {
         iter_.remove();
         found = true;
       }
@@ -22,7 +22,7 @@ namespace Dune
   /**
    * @brief A const iterator over an uncached selection.
    */
-  template<typename TS, typename TG, typename TL, int N>
+  template<typename TS, typename TG, typename TL, int N, typename S = ArrayListIndexStorage>
   class SelectionIterator
   {
   public:
@@ -39,11 +39,10 @@ namespace Dune
     /**
      * @brief The type of the underlying index set.
      */
-    typedef Dune::ParallelIndexSet<TG,TL,N> ParallelIndexSet;
+    typedef Dune::ParallelIndexSet<TG,TL,N,S> ParallelIndexSet;
 
-    //typedef typename ParallelIndexSet::const_iterator ParallelIndexSetIterator;
+    typedef typename ParallelIndexSet::const_iterator ParallelIndexSetIterator;
 
-    typedef ConstArrayListIterator<IndexPair<TG,TL>, N, std::allocator<Dune::IndexPair<TG,TL> > > ParallelIndexSetIterator;
     /**
      * @brief Constructor.
      * @param iter The iterator over the index set.
@@ -71,12 +70,12 @@ namespace Dune
       return iter_->local().local();
     }
 
-    bool operator==(const SelectionIterator<TS,TG,TL,N>& other) const
+    bool operator==(const SelectionIterator<TS,TG,TL,N,S>& other) const
     {
       return iter_ == other.iter_;
     }
 
-    bool operator!=(const SelectionIterator<TS,TG,TL,N>& other) const
+    bool operator!=(const SelectionIterator<TS,TG,TL,N,S>& other) const
     {
       return iter_ != other.iter_;
     }
@@ -90,7 +89,7 @@ namespace Dune
   /**
    * @brief An uncached selection of indices.
    */
-  template<typename TS, typename TG, typename TL, int N>
+  template<typename TS, typename TG, typename TL, int N, typename S = ArrayListIndexStorage>
   class UncachedSelection
   {
   public:
@@ -120,12 +119,12 @@ namespace Dune
     /**
      * @brief The type of the underlying index set.
      */
-    typedef Dune::ParallelIndexSet<GlobalIndex,LocalIndex,N> ParallelIndexSet;
+    typedef Dune::ParallelIndexSet<GlobalIndex,LocalIndex,N,S> ParallelIndexSet;
 
     /**
      * @brief The type of the iterator of the selected indices.
      */
-    typedef SelectionIterator<TS,TG,TL,N> iterator;
+    typedef SelectionIterator<TS,TG,TL,N,S> iterator;
 
     /**
      * @brief The type of the iterator of the selected indices.
@@ -171,7 +170,7 @@ namespace Dune
   /**
    * @brief A cached selection of indices.
    */
-  template<typename TS, typename TG, typename TL, int N>
+  template<typename TS, typename TG, typename TL, int N, typename S = ArrayListIndexStorage>
   class Selection
   {
   public:
@@ -201,7 +200,7 @@ namespace Dune
     /**
      * @brief The type of the underlying index set.
      */
-    typedef Dune::ParallelIndexSet<GlobalIndex,LocalIndex,N> ParallelIndexSet;
+    typedef Dune::ParallelIndexSet<GlobalIndex,LocalIndex,N,S> ParallelIndexSet;
 
     /**
      * @brief The type of the iterator of the selected indices.
@@ -261,8 +260,8 @@ namespace Dune
 
   };
 
-  template<typename TS, typename TG, typename TL, int N>
-  inline void Selection<TS,TG,TL,N>::setIndexSet(const ParallelIndexSet& indexset)
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  inline void Selection<TS,TG,TL,N,S>::setIndexSet(const ParallelIndexSet& indexset)
   {
     if(built_)
       free();
@@ -288,48 +287,48 @@ namespace Dune
     built_=true;
   }
 
-  template<typename TS, typename TG, typename TL, int N>
-  uint32_t* Selection<TS,TG,TL,N>::begin() const
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  uint32_t* Selection<TS,TG,TL,N,S>::begin() const
   {
     return selected_;
   }
 
-  template<typename TS, typename TG, typename TL, int N>
-  uint32_t* Selection<TS,TG,TL,N>::end() const
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  uint32_t* Selection<TS,TG,TL,N,S>::end() const
   {
     return selected_+size_;
   }
 
-  template<typename TS, typename TG, typename TL, int N>
-  inline void Selection<TS,TG,TL,N>::free()
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  inline void Selection<TS,TG,TL,N,S>::free()
   {
     delete[] selected_;
     size_=0;
     built_=false;
   }
 
-  template<typename TS, typename TG, typename TL, int N>
-  inline Selection<TS,TG,TL,N>::~Selection()
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  inline Selection<TS,TG,TL,N,S>::~Selection()
   {
     if(built_)
       free();
   }
 
-  template<typename TS, typename TG, typename TL, int N>
-  SelectionIterator<TS,TG,TL,N> UncachedSelection<TS,TG,TL,N>::begin() const
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  SelectionIterator<TS,TG,TL,N,S> UncachedSelection<TS,TG,TL,N,S>::begin() const
   {
-    return SelectionIterator<TS,TG,TL,N>(indexSet_->begin(),
+    return SelectionIterator<TS,TG,TL,N,S>(indexSet_->begin(),
                                          indexSet_->end());
   }
 
-  template<typename TS, typename TG, typename TL, int N>
-  SelectionIterator<TS,TG,TL,N> UncachedSelection<TS,TG,TL,N>::end() const
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  SelectionIterator<TS,TG,TL,N,S> UncachedSelection<TS,TG,TL,N,S>::end() const
   {
-    return SelectionIterator<TS,TG,TL,N>(indexSet_->end(),
+    return SelectionIterator<TS,TG,TL,N,S>(indexSet_->end(),
                                          indexSet_->end());
   }
-  template<typename TS, typename TG, typename TL, int N>
-  void UncachedSelection<TS,TG,TL,N>::setIndexSet(const ParallelIndexSet& indexset)
+  template<typename TS, typename TG, typename TL, int N, typename S>
+  void UncachedSelection<TS,TG,TL,N,S>::setIndexSet(const ParallelIndexSet& indexset)
   {
     indexSet_ = &indexset;
   }
@@ -0,0 +1,177 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include <config.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dune/common/enumset.hh>
+#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/parallel/communicationprofile.hh>
+#include <dune/common/parallel/communicator.hh>
+#include <dune/common/parallel/indexset.hh>
+#include <dune/common/parallel/interface.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/parallel/plocalindex.hh>
+#include <dune/common/parallel/remoteindices.hh>
+#include <dune/common/parallel/variablesizecommunicator.hh>
+#include <dune/common/test/testsuite.hh>
+
+enum GridFlags {
+  owner, overlap
+};
+
+typedef Dune::ParallelLocalIndex<GridFlags> LocalIndex;
+typedef Dune::ParallelIndexSet<int,LocalIndex> IndexSet;
+typedef Dune::RemoteIndices<IndexSet> RemoteIndices;
+typedef std::vector<double> Vector;
+typedef Dune::CommunicationProfile Profile;
+
+// Sends one double per index of the interface
+struct DataHandle
+{
+  typedef double DataType;
+
+  bool fixedsize()
+  {
+    return true;
+  }
+
+  std::size_t size(int)
+  {
+    return 1;
+  }
+
+  template<class B>
+  void gather(B& buffer, int i)
+  {
+    buffer.write(v[i]);
+  }
+
+  template<class B>
+  void scatter(B& buffer, int i, int)
+  {
+    buffer.read(v[i]);
+  }
+
+  Vector& v;
+};
+
+int main(int argc, char** argv)
+{
+  Dune::MPIHelper& helper = Dune::MPIHelper::instance(argc, argv);
+  Dune::TestSuite suite;
+  Profile& profile = Profile::instance();
+  const int procs = helper.size();
+  const int rank = helper.rank();
+  const int n = 5;
+
+  suite.check(Profile::enabled) << "The profiling is not enabled";
+  profile.reset();
+
+  // A one dimensional decomposition, every process owns n indices and
+  // has a copy of the last index of its left and the first index of its
+  // right neighbour.
+  const int begin = std::max(rank*n-1, 0);
+  const int end = std::min((rank+1)*n+1, procs*n);
+  IndexSet indexSet;
+  indexSet.beginResize();
+  for(int g=begin; g<end; ++g)
+    indexSet.add(g, LocalIndex(g-begin, g>=rank*n && g<(rank+1)*n ? owner : overlap, true));
+  indexSet.endResize();
+
+  RemoteIndices remoteIndices(indexSet, indexSet, MPI_COMM_WORLD);
+  remoteIndices.rebuild<false>();
+  suite.check(profile.value(Profile::remoteIndices, Profile::calls) == (procs>1 ? 1 : 0))
+    << "rebuild() was not recorded";
+  suite.check(profile.value(Profile::remoteIndices, Profile::sentMessages)
+              == profile.value(Profile::remoteIndices, Profile::receivedMessages))
+    << "RemoteIndices did not receive as many messages as it sent";
+
+  Dune::Interface interface(MPI_COMM_WORLD);
+  interface.build(remoteIndices, Dune::EnumItem<GridFlags,owner>(), Dune::EnumItem<GridFlags,overlap>());
+  const std::size_t neighbours = (rank>0) + (rank<procs-1);
+  Vector v(end-begin, 1.0);
+
+  Dune::BufferedCommunicator communicator;
+  communicator.build<Vector>(interface);
+  communicator.forward<Dune::CopyGatherScatter<Vector> >(v);
+  communicator.forwardBegin<Dune::CopyGatherScatter<Vector> >(v);
+  communicator.forwardEnd<Dune::CopyGatherScatter<Vector> >(v);
+  suite.check(profile.value(Profile::bufferedCommunicator, Profile::calls) == 2)
+    << "Not all calls of BufferedCommunicator were recorded";
+  suite.check(profile.value(Profile::bufferedCommunicator, Profile::sentMessages) == 2*neighbours
+              && profile.value(Profile::bufferedCommunicator, Profile::sentBytes) == 2*neighbours*sizeof(double))
+    << "BufferedCommunicator recorded wrong sends";
+  suite.check(profile.value(Profile::bufferedCommunicator, Profile::receivedMessages) == 2*neighbours
+              && profile.value(Profile::bufferedCommunicator, Profile::receivedBytes) == 2*neighbours*sizeof(double))
+    << "BufferedCommunicator recorded wrong receives";
+  suite.check(profile.value(Profile::bufferedCommunicator, Profile::packTime) >= 0
+              && profile.value(Profile::bufferedCommunicator, Profile::unpackTime) >= 0
+              && profile.value(Profile::bufferedCommunicator, Profile::waitTime) >= 0)
+    << "BufferedCommunicator recorded negative times";
+  suite.check(profile.neighbours(Profile::bufferedCommunicator).size() == neighbours)
+    << "BufferedCommunicator recorded wrong neighbours";
+  for(const auto& neighbour : profile.neighbours(Profile::bufferedCommunicator))
+    suite.check((neighbour.first == rank-1 || neighbour.first == rank+1)
+                && neighbour.second.sentMessages == 2 && neighbour.second.receivedMessages == 2
+                && neighbour.second.sentBytes == 2*sizeof(double))
+      << "Wrong traffic with neighbour " << neighbour.first;
+
+  DataHandle handle{v};
+  Dune::VariableSizeCommunicator<> variableSize(interface);
+  variableSize.forward(handle);
+  variableSize.setAggregateMessages(true);
+  variableSize.forward(handle);
+  suite.check(profile.value(Profile::variableSizeCommunicator, Profile::calls) == 2)
+    << "Not all calls of VariableSizeCommunicator were recorded";
+  suite.check(profile.value(Profile::variableSizeCommunicator, Profile::sentMessages) == 2*neighbours
+              && profile.value(Profile::variableSizeCommunicator, Profile::receivedMessages) == 2*neighbours)
+    << "VariableSizeCommunicator recorded wrong messages";
+  suite.check(profile.value(Profile::variableSizeCommunicator, Profile::sentBytes)
+              == profile.value(Profile::variableSizeCommunicator, Profile::receivedBytes))
+    << "VariableSizeCommunicator recorded wrong bytes";
+
+  Dune::CollectiveCommunication<MPI_Comm> comm(MPI_COMM_WORLD);
+  const double calls = profile.value(Profile::collectiveCommunication, Profile::calls);
+  const double bytes = profile.value(Profile::collectiveCommunication, Profile::sentBytes);
+  comm.sum(1);
+  comm.barrier();
+  suite.check(profile.value(Profile::collectiveCommunication, Profile::calls) == calls+2
+              && profile.value(Profile::collectiveCommunication, Profile::sentBytes) == bytes+sizeof(int))
+    << "CollectiveCommunication recorded wrong calls";
+
+  std::ostringstream text, json;
+  profile.report(text, comm);
+  profile.report(json, comm, Profile::json);
+  if(rank == 0) {
+    suite.check(text.str().find("BufferedCommunicator") != std::string::npos
+                && text.str().find("waitTime") != std::string::npos)
+      << "The text report misses the BufferedCommunicator";
+    suite.check(json.str().find("\"processes\": " + std::to_string(procs)) != std::string::npos
+                && json.str().find("\"VariableSizeCommunicator\"") != std::string::npos)
+      << "The JSON report is wrong";
+    if(procs > 1)
+      suite.check(json.str().find("\"neighbour\": 1") != std::string::npos)
+        << "The JSON report misses the neighbours";
+  }else
+    suite.check(text.str().empty() && json.str().empty())
+      << "Only the first process may write the report";
+
+  std::ostringstream local;
+  profile.report(local, Dune::CollectiveCommunication<Dune::No_Comm>(), Profile::json);
+  suite.check(local.str().find("\"processes\": 1") != std::string::npos)
+    << "The report of a single process is wrong";
+
+  profile.reset();
+  suite.check(profile.value(Profile::bufferedCommunicator, Profile::calls) == 0
+              && profile.neighbours(Profile::bufferedCommunicator).empty())
+    << "reset() did not clear the profile";
+
+  return suite.exit();
+}
@@ -0,0 +1,327 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include <config.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dune/common/enumset.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/communicator.hh>
+#include <dune/common/parallel/indexset.hh>
+#include <dune/common/parallel/interface.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/parallel/plocalindex.hh>
+#include <dune/common/parallel/remoteindices.hh>
+#include <dune/common/test/testsuite.hh>
+
+enum GridFlags {
+  owner, overlap
+};
+
+typedef Dune::ParallelLocalIndex<GridFlags> LocalIndex;
+typedef Dune::ParallelIndexSet<int,LocalIndex> IndexSet;
+typedef Dune::RemoteIndices<IndexSet> RemoteIndices;
+typedef std::vector<double> Vector;
+typedef Dune::CopyGatherScatter<Vector> GatherScatter;
+typedef std::vector<Dune::FieldVector<double,3> > BlockVector;
+
+// A one dimensional decomposition: every process owns n consecutive
+// indices and has a copy of the last index of its left and the first
+// index of its right neighbour.
+struct Decomposition
+{
+  Decomposition(MPI_Comm comm, int n)
+    : remoteIndices(indexSet, indexSet, comm), interface(comm)
+  {
+    MPI_Comm_size(comm, &procs);
+    MPI_Comm_rank(comm, &rank);
+
+    begin = std::max(rank*n-1, 0);
+    end = std::min((rank+1)*n+1, procs*n);
+    ownedBegin = rank*n;
+    ownedEnd = (rank+1)*n;
+
+    indexSet.beginResize();
+    for(int g=begin; g<end; ++g) {
+      bool isOwned = g>=ownedBegin && g<ownedEnd;
+      indexSet.add(g, LocalIndex(g-begin, isOwned ? owner : overlap, true));
+    }
+    indexSet.endResize();
+
+    remoteIndices.rebuild<false>();
+    interface.build(remoteIndices, Dune::EnumItem<GridFlags,owner>(),
+                    Dune::EnumItem<GridFlags,overlap>());
+  }
+
+  std::size_t size() const
+  {
+    return end-begin;
+  }
+
+  int global(std::size_t i) const
+  {
+    return begin+i;
+  }
+
+  bool isOwned(std::size_t i) const
+  {
+    return global(i)>=ownedBegin && global(i)<ownedEnd;
+  }
+
+  // whether another process has a copy of the owned entry i
+  bool isCopied(std::size_t i) const
+  {
+    return isOwned(i) && ((global(i)==ownedBegin && rank>0)
+                          || (global(i)==ownedEnd-1 && rank<procs-1));
+  }
+
+  int procs, rank, begin, end, ownedBegin, ownedEnd;
+  IndexSet indexSet;
+  RemoteIndices remoteIndices;
+  Dune::Interface interface;
+};
+
+// owned entries hold their global index, the others -1
+Vector ownerValues(const Decomposition& d, double offset = 0)
+{
+  Vector v(d.size());
+  for(std::size_t i=0; i<v.size(); ++i)
+    v[i] = d.isOwned(i) ? d.global(i)+offset : -1;
+  return v;
+}
+
+bool consistent(const Decomposition& d, const Vector& v, double offset = 0)
+{
+  for(std::size_t i=0; i<v.size(); ++i)
+    if(v[i] != d.global(i)+offset)
+      return false;
+  return true;
+}
+
+// How the messages are exchanged
+enum Exchange {
+  pointToPoint, neighbourhood, sharedMemory
+};
+
+void setExchange(Dune::BufferedCommunicator& comm, Exchange exchange)
+{
+  comm.setNeighbourhoodCollectives(exchange == neighbourhood);
+  comm.setSharedMemory(exchange == sharedMemory);
+}
+
+void testBlocking(Dune::TestSuite& suite, const Decomposition& d, Exchange exchange)
+{
+  Dune::BufferedCommunicator comm;
+  setExchange(comm, exchange);
+  suite.check(comm.neighbourhoodCollectives() == (exchange == neighbourhood))
+    << "neighbourhoodCollectives() does not return the value set";
+  suite.check(comm.sharedMemory() == (exchange == sharedMemory))
+    << "sharedMemory() does not return the value set";
+  comm.build<Vector>(d.interface);
+
+  Vector v = ownerValues(d);
+  comm.forward<GatherScatter>(v);
+  suite.check(consistent(d, v)) << "forward did not update the overlap";
+
+  // send the overlap back to the owners
+  Vector w(d.size());
+  for(std::size_t i=0; i<w.size(); ++i)
+    w[i] = d.isOwned(i) ? -1 : d.global(i);
+  comm.backward<GatherScatter>(w);
+  for(std::size_t i=0; i<w.size(); ++i)
+    if(d.isOwned(i))
+      suite.check(w[i] == (d.isCopied(i) ? d.global(i) : -1))
+        << "backward communicated a wrong value at " << d.global(i);
+
+  // the persistent requests are reused, also after a rebuild
+  for(int k=0; k<4; ++k) {
+    if(k==2) {
+      comm.free();
+      comm.build<Vector>(d.interface);
+    }
+    Vector u = ownerValues(d, k);
+    comm.forward<GatherScatter>(u);
+    suite.check(consistent(d, u, k)) << "forward number " << k << " did not update the overlap";
+  }
+}
+
+template<class E, class F>
+bool throws(F&& f)
+{
+  try {
+    f();
+  }
+  catch (const E&) {
+    return true;
+  }
+  return false;
+}
+
+void testSplitPhase(Dune::TestSuite& suite, const Decomposition& d, Exchange exchange)
+{
+  Dune::BufferedCommunicator comm;
+  setExchange(comm, exchange);
+  comm.build<Vector>(d.interface);
+
+  // the values are gathered by forwardBegin, changing the source
+  // afterwards does not change what is received
+  Vector v = ownerValues(d);
+  comm.forwardBegin<GatherScatter>(v);
+  suite.check(comm.pending()) << "no communication pending after forwardBegin";
+  for(std::size_t i=0; i<v.size(); ++i)
+    if(d.isOwned(i))
+      v[i] += 1000;
+  comm.forwardEnd<GatherScatter>(v);
+  suite.check(!comm.pending()) << "communication pending after forwardEnd";
+  for(std::size_t i=0; i<v.size(); ++i)
+    suite.check(v[i] == d.global(i) + (d.isOwned(i) ? 1000 : 0))
+      << "split forward communicated a wrong value at " << d.global(i);
+
+  // separate source and target
+  Vector source = ownerValues(d, 0.5), target(d.size(), -1);
+  comm.forwardBegin<GatherScatter>(source);
+  comm.forwardEnd<GatherScatter>(target);
+  for(std::size_t i=0; i<target.size(); ++i)
+    suite.check(d.isOwned(i) || target[i] == d.global(i)+0.5)
+      << "split forward with separate target is wrong at " << d.global(i);
+
+  // backward: the owners receive the values of the copies
+  Vector back(d.size());
+  for(std::size_t i=0; i<back.size(); ++i)
+    back[i] = d.isOwned(i) ? -1 : -d.global(i);
+  comm.backwardBegin<GatherScatter>(back);
+  comm.backwardEnd<GatherScatter>(back);
+  for(std::size_t i=0; i<back.size(); ++i)
+    if(d.isOwned(i))
+      suite.check(back[i] == (d.isCopied(i) ? -d.global(i) : -1))
+        << "split backward communicated a wrong value at " << d.global(i);
+
+  // a second communication cannot be started before the first is completed
+  comm.forwardBegin<GatherScatter>(v);
+  suite.check(throws<Dune::InvalidStateException>([&]{ comm.forwardBegin<GatherScatter>(v); }))
+    << "starting two communications does not throw";
+  suite.check(throws<Dune::InvalidStateException>([&]{ comm.backwardEnd<GatherScatter>(v); }))
+    << "completing a communication in the wrong direction does not throw";
+  comm.forwardEnd<GatherScatter>(v);
+  suite.check(throws<Dune::InvalidStateException>([&]{ comm.forwardEnd<GatherScatter>(v); }))
+    << "completing a communication that was not started does not throw";
+
+  // free() completes a pending communication
+  comm.forwardBegin<GatherScatter>(v);
+  comm.free();
+  suite.check(!comm.pending()) << "communication pending after free";
+}
+
+// adds the received values instead of copying them, which needs the buffers
+struct AddGatherScatter
+{
+  static double gather(const Vector& v, std::size_t i)
+  {
+    return v[i];
+  }
+
+  static void scatter(Vector& v, double value, std::size_t i)
+  {
+    v[i] += value;
+  }
+};
+
+void testZeroCopy(Dune::TestSuite& suite, const Decomposition& d)
+{
+  // blocks are sent without buffers as well as with them
+  for(bool zeroCopy : {true, false}) {
+    Dune::BufferedCommunicator comm;
+    comm.setZeroCopy(zeroCopy);
+    suite.check(comm.zeroCopy() == zeroCopy) << "zeroCopy() does not return the value set";
+    comm.build<BlockVector>(d.interface);
+
+    BlockVector source(d.size()), target(d.size(), Dune::FieldVector<double,3>(-1.0));
+    for(std::size_t i=0; i<source.size(); ++i)
+      for(int c=0; c<3; ++c)
+        source[i][c] = d.isOwned(i) ? 3*d.global(i)+c : -1;
+    comm.forward<Dune::CopyGatherScatter<BlockVector> >(source, target);
+    for(std::size_t i=0; i<target.size(); ++i)
+      for(int c=0; c<3; ++c)
+        suite.check(d.isOwned(i) ? target[i][c] == -1 : target[i][c] == 3*d.global(i)+c)
+          << "forward of blocks with zeroCopy=" << zeroCopy
+          << " communicated a wrong value at " << d.global(i);
+
+    comm.forward<Dune::CopyGatherScatter<BlockVector> >(source);
+    for(std::size_t i=0; i<source.size(); ++i)
+      suite.check(source[i][2] == 3*d.global(i)+2)
+        << "in place forward of blocks with zeroCopy=" << zeroCopy
+        << " did not update the overlap at " << d.global(i);
+  }
+
+  // other GatherScatters use the buffers
+  Dune::BufferedCommunicator comm;
+  comm.build<Vector>(d.interface);
+  Vector v = ownerValues(d);
+  for(std::size_t i=0; i<v.size(); ++i)
+    if(!d.isOwned(i))
+      v[i] = 1;
+  comm.forward<AddGatherScatter>(v);
+  for(std::size_t i=0; i<v.size(); ++i)
+    suite.check(v[i] == d.global(i) + (d.isOwned(i) ? 0 : 1))
+      << "forward with adding GatherScatter is wrong at " << d.global(i);
+}
+
+// every shared entry is both sent and received, communicating in place
+// has to send the values before they are overwritten
+void testInPlace(Dune::TestSuite& suite, const Decomposition& d, Exchange exchange)
+{
+  Dune::Interface interface(MPI_COMM_WORLD);
+  interface.build(d.remoteIndices, Dune::AllSet<GridFlags>(), Dune::AllSet<GridFlags>());
+
+  for(bool zeroCopy : {true, false}) {
+    Dune::BufferedCommunicator comm;
+    comm.setZeroCopy(zeroCopy);
+    setExchange(comm, exchange);
+    comm.build<Vector>(interface);
+
+    Vector v(d.size()), w(d.size());
+    for(std::size_t i=0; i<v.size(); ++i)
+      v[i] = d.global(i) + 1000*d.rank;
+    comm.forward<GatherScatter>(v, w);
+    comm.forward<GatherScatter>(v);
+    for(std::size_t i=0; i<v.size(); ++i) {
+      // the process the entry is shared with
+      int neighbour = d.rank;
+      if(d.global(i)<=d.ownedBegin && d.rank>0)
+        neighbour = d.rank-1;
+      if(d.global(i)>=d.ownedEnd-1 && d.rank<d.procs-1)
+        neighbour = d.rank+1;
+      suite.check(v[i] == d.global(i) + 1000*neighbour)
+        << "in place forward with zeroCopy=" << zeroCopy
+        << " communicated a wrong value at " << d.global(i);
+      suite.check(neighbour == d.rank || w[i] == v[i])
+        << "forward with zeroCopy=" << zeroCopy
+        << " and separate target communicated a wrong value at " << d.global(i);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  Dune::TestSuite suite;
+
+  for(int n : {1, 5}) {
+    Decomposition d(MPI_COMM_WORLD, n);
+    testZeroCopy(suite, d);
+    for(Exchange exchange : {pointToPoint, neighbourhood, sharedMemory}) {
+      testBlocking(suite, d, exchange);
+      testSplitPhase(suite, d, exchange);
+      // with a single index per process, an index is shared by three processes
+      if(n>1)
+        testInPlace(suite, d, exchange);
+    }
+  }
+
+  return suite.exit();
+}
@@ -0,0 +1,100 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include "config.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <dune/common/parallel/indexset.hh>
+#include <dune/common/parallel/plocalindex.hh>
+#include <dune/common/timer.hh>
+
+// Measures building ParallelIndexSets with both storage policies and
+// compares the lookup of global indices by binary search with the lookup
+// in the hash table.  The number of indices can be given as the first
+// argument.  The default is small enough for running it as a test, for
+// meaningful timings use e.g. 10000000.
+
+enum GridFlags {
+  owner, overlap
+};
+
+typedef Dune::ParallelLocalIndex<GridFlags> LocalIndex;
+
+// look up all the queries and sum up their local indices
+template<class I>
+std::size_t measure(const I& indexSet, const std::vector<long>& queries,
+                     const char* name)
+{
+  Dune::Timer timer;
+  std::size_t sum=0;
+  for(long global : queries)
+    sum += indexSet[global].local();
+  double elapsed = timer.elapsed();
+  std::cout<<"  "<<name<<": "<<elapsed<<" seconds, "
+           <<1e9*elapsed/queries.size()<<" ns per lookup"<<std::endl;
+  return sum;
+}
+
+template<class S>
+bool benchmark(std::size_t n, const std::vector<long>& queries, const char* storage)
+{
+  std::cout<<storage<<":"<<std::endl;
+
+  // every other global index is known, as for a decomposition that
+  // skips the indices of the neighbours, and the indices are added in a
+  // scattered order as for an unstructured grid
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937_64(7919));
+
+  Dune::ParallelIndexSet<long,LocalIndex,512,S> indexSet;
+  Dune::Timer timer;
+  indexSet.beginResize();
+  for(std::size_t j : order)
+    indexSet.add(2*j, LocalIndex(j, j%10 ? owner : overlap, true));
+  indexSet.endResize();
+  std::cout<<"  Building the index set with "<<n<<" indices took "
+           <<timer.elapsed()<<" seconds"<<std::endl;
+
+  timer.reset();
+  std::size_t owned=0;
+  for(const auto& pair : indexSet)
+    owned += pair.local().attribute()==owner;
+  std::cout<<"  Counting the "<<owned<<" owned indices took "<<timer.elapsed()<<" seconds"<<std::endl;
+
+  timer.reset();
+  indexSet.setHashLookup(true);
+  std::cout<<"  Building the hash table took "<<timer.elapsed()<<" seconds"<<std::endl;
+
+  std::size_t hashed = measure(indexSet, queries, "Hash lookup");
+  indexSet.setHashLookup(false);
+  std::size_t searched = measure(indexSet, queries, "Binary search");
+
+  if(hashed != searched) {
+    std::cerr<<"Hash lookup and binary search found different indices!"<<std::endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  const std::size_t n = argc>1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+
+  // random queries as in an assembly with an unstructured numbering
+  std::mt19937_64 generator(42);
+  std::uniform_int_distribution<std::size_t> distribution(0, n-1);
+  std::vector<long> queries(n);
+  for(long& global : queries)
+    global = 2*distribution(generator);
+
+  bool success = benchmark<Dune::ArrayListIndexStorage>(n, queries, "ArrayListIndexStorage");
+  success &= benchmark<Dune::ContiguousIndexStorage>(n, queries, "ContiguousIndexStorage");
+  return success ? 0 : 1;
+}
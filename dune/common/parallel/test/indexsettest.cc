@@ -5,17 +5,27 @@
 #include "config.h"
 #endif
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
 #include <ostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/parallel/indexset.hh>
 #include <dune/common/parallel/localindex.hh>
+#include <dune/common/parallel/plocalindex.hh>
 
+template<class S>
 int testDeleteIndices()
 {
-  Dune::ParallelIndexSet<int,Dune::LocalIndex,15> indexSet;
-  Dune::ParallelIndexSet<int,Dune::LocalIndex,25> indexSet1;
+  Dune::ParallelIndexSet<int,Dune::LocalIndex,15,S> indexSet;
+  Dune::ParallelIndexSet<int,Dune::LocalIndex,25,S> indexSet1;
 
   indexSet.beginResize();
   indexSet1.beginResize();
@@ -28,7 +38,7 @@ int testDeleteIndices()
   indexSet.endResize();
   indexSet1.endResize();
 
-  typedef Dune::ParallelIndexSet<int,Dune::LocalIndex,15>::iterator
+  typedef typename Dune::ParallelIndexSet<int,Dune::LocalIndex,15,S>::iterator
   Iterator;
 
   Iterator entry = indexSet.begin();
@@ -58,7 +68,7 @@ int testDeleteIndices()
     ret++;
   }
 
-  Dune::ParallelIndexSet<int,Dune::LocalIndex,25>::iterator iter=indexSet1.begin();
+  typename Dune::ParallelIndexSet<int,Dune::LocalIndex,25,S>::iterator iter=indexSet1.begin();
 
   // Test whether the local indices changed
   for(entry = indexSet.begin(); entry != end; ++entry) {
@@ -77,7 +87,146 @@ int testDeleteIndices()
   return ret;
 }
 
+// Check that every global index is found with the same local index
+// as by the binary search of a copy without the hash lookup.
+template<class I>
+int checkLookup(const I& indexSet)
+{
+  int ret=0;
+  I reference(indexSet);
+  reference.setHashLookup(false);
+
+  if(!indexSet.hashLookup() || reference.hashLookup()) {
+    std::cerr<<"Hash lookup flag not correct!"<<std::endl;
+    ret++;
+  }
+
+  for(const auto& pair : reference) {
+    if(indexSet[pair.global()].local() != pair.local()
+       || indexSet.at(pair.global()).local() != pair.local()
+       || indexSet[pair.global()].local() != reference[pair.global()].local()) {
+      std::cerr<<"Hash lookup of "<<pair.global()<<" failed!"<<std::endl;
+      ret++;
+    }
+  }
+  return ret;
+}
+
+template<class I, class G>
+int checkMissing(const I& indexSet, const G& global)
+{
+  try {
+    indexSet.at(global);
+  }
+  catch(const Dune::RangeError&) {
+    return 0;
+  }
+  std::cerr<<"Missing global index "<<global<<" was found!"<<std::endl;
+  return 1;
+}
+
+template<class S>
+int testHashLookup()
+{
+  typedef Dune::ParallelIndexSet<int,Dune::LocalIndex,15,S> IndexSet;
+  IndexSet indexSet;
+  int ret=0;
+
+  // enabled before the set is filled
+  indexSet.setHashLookup(true);
+  ret += checkMissing(indexSet, 3);
+
+  indexSet.beginResize();
+  for(int i=999; i>=0; --i)
+    indexSet.add(7*i+3, Dune::LocalIndex(i));
+  indexSet.endResize();
+
+  ret += checkLookup(indexSet);
+  ret += checkMissing(indexSet, 4);
+  ret += checkMissing(indexSet, 7*1000+3);
+
+  // remove every third index and add new ones in between
+  indexSet.beginResize();
+  int i=0;
+  for(auto pair = indexSet.begin(); pair != indexSet.end(); ++pair, ++i)
+    if(i%3==0)
+      indexSet.markAsDeleted(pair);
+  for(int j=0; j<500; ++j)
+    indexSet.add(7*j+5, Dune::LocalIndex(1000+j));
+  indexSet.endResize();
+
+  ret += checkLookup(indexSet);
+  ret += checkMissing(indexSet, 3);
+
+  // enabled after the set is filled, with a non-integral global index
+  Dune::ParallelIndexSet<std::string,Dune::LocalIndex,15,S> names;
+  names.beginResize();
+  for(int j=0; j<100; ++j)
+    names.add(std::to_string(j), Dune::LocalIndex(j));
+  names.endResize();
+  names.setHashLookup(true);
+
+  ret += checkLookup(names);
+  ret += checkMissing(names, std::string("a"));
+
+  return ret;
+}
+
+// Check that large index sets, which are sorted by a radix sort, are
+// sorted by the global index and the attribute.
+template<class G, class S>
+int testSort()
+{
+  enum Flags { owner, overlap };
+  typedef Dune::ParallelLocalIndex<Flags> LocalIndex;
+  typedef Dune::ParallelIndexSet<G,LocalIndex,64,S> IndexSet;
+  IndexSet indexSet;
+  int ret=0;
+
+  // negative and repeated global indices, which are added as overlap
+  // first and as owner afterwards
+  std::vector<G> globals;
+  for(int i=0; i<20000; ++i)
+    globals.push_back(G((i*7919)%10007) - G(std::is_signed<G>::value ? 5000 : 0));
+  std::mt19937 generator(1);
+  std::shuffle(globals.begin(), globals.end(), generator);
+
+  for(int round=0; round<2; ++round) {
+    indexSet.beginResize();
+    for(std::size_t i=round; i<globals.size(); i+=2)
+      indexSet.add(globals[i], LocalIndex(i, i%3 ? overlap : owner, true));
+    indexSet.endResize();
+  }
+
+  std::vector<std::pair<G,Flags> > expected;
+  for(std::size_t i=0; i<globals.size(); ++i)
+    expected.emplace_back(globals[i], i%3 ? overlap : owner);
+  std::sort(expected.begin(), expected.end());
+
+  if(indexSet.size() != expected.size()) {
+    std::cerr<<"Sorted index set has wrong size!"<<std::endl;
+    return 1;
+  }
+  auto pair = indexSet.begin();
+  for(std::size_t i=0; i<expected.size(); ++i, ++pair)
+    if(pair->global() != expected[i].first || pair->local().attribute() != expected[i].second) {
+      std::cerr<<"Index set is not sorted at position "<<i<<": "<<*pair<<" instead of "
+               <<expected[i].first<<" with attribute "<<expected[i].second<<"!"<<std::endl;
+      ret++;
+      break;
+    }
+  return ret;
+}
+
+template<class S>
+int testStorage()
+{
+  return testDeleteIndices<S>() + testHashLookup<S>()
+         + testSort<int,S>() + testSort<unsigned long,S>() + testSort<long long,S>();
+}
+
 int main(int, char **)
 {
-  std::exit(testDeleteIndices());
+  std::exit(testStorage<Dune::ArrayListIndexStorage>()
+            + testStorage<Dune::ContiguousIndexStorage>());
 }
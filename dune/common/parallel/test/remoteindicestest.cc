@@ -650,6 +650,121 @@ void testRedistributeIndicesBuffered(MPI_Comm comm)
 }
 
 
+// The directory neighbour discovery has to give the same remote indices
+// as the ring.
+template<bool ignorePublic>
+bool testNeighbourDiscovery(MPI_Comm comm)
+{
+  const int Nx = 20;
+  const int Ny = 2;
+
+  int procs, rank, master=0;
+  MPI_Comm_size(comm, &procs);
+  MPI_Comm_rank(comm, &rank);
+
+  typedef Dune::ParallelIndexSet<int,Dune::ParallelLocalIndex<GridFlags> > ParallelIndexSet;
+  typedef Dune::RemoteIndices<ParallelIndexSet> RemoteIndices;
+
+  ParallelIndexSet distIndexSet, globalIndexSet;
+  Array distArray, globalArray;
+
+  setupDistributed<Nx,Ny>(distArray, distIndexSet, rank, procs);
+  if(rank==master)
+    setupGlobal<Nx,Ny>(globalArray, globalIndexSet);
+
+  bool success = true;
+
+  for(int twoSets=0; twoSets<2; ++twoSets) {
+    const ParallelIndexSet& target = twoSets ? globalIndexSet : distIndexSet;
+    RemoteIndices ringIndices(distIndexSet, target, comm);
+    RemoteIndices directoryIndices(distIndexSet, target, comm);
+    directoryIndices.setNeighbourDiscovery(RemoteIndices::directory);
+
+    ringIndices.rebuild<ignorePublic>();
+    directoryIndices.rebuild<ignorePublic>();
+
+    if(!(ringIndices == directoryIndices)) {
+      std::cerr<<rank<<": directory neighbour discovery gives different remote indices"
+               <<(twoSets ? " for two index sets" : "")<<std::endl;
+      success = false;
+    }
+  }
+  return success;
+}
+
+// Add the indices in [first,last) that are not owned by us as overlap
+// and remove the overlap outside of it.
+template<class ParallelIndexSet>
+void setOverlap(ParallelIndexSet& indexSet, int first, int last, int start, int end)
+{
+  typedef typename ParallelIndexSet::iterator iterator;
+  std::vector<int> present;
+  int localIndex = indexSet.size();
+  indexSet.beginResize();
+  for(iterator index = indexSet.begin(); index != indexSet.end(); ++index) {
+    present.push_back(index->global());
+    if(index->global() < first || index->global() >= last)
+      indexSet.markAsDeleted(index);
+  }
+  for(int i=first; i<last; ++i)
+    if(std::find(present.begin(), present.end(), i) == present.end())
+      indexSet.add(i, Dune::ParallelLocalIndex<GridFlags>(localIndex++, (i<start || i>=end) ? overlap : owner, true));
+  indexSet.endResize();
+}
+
+// An incremental update has to give the same remote indices as a rebuild.
+bool testUpdate(MPI_Comm comm)
+{
+  int procs, rank;
+  MPI_Comm_size(comm, &procs);
+  MPI_Comm_rank(comm, &rank);
+
+  typedef Dune::ParallelIndexSet<int,Dune::ParallelLocalIndex<GridFlags> > ParallelIndexSet;
+  typedef Dune::RemoteIndices<ParallelIndexSet> RemoteIndices;
+
+  // every process owns n indices, the overlap width changes
+  const int n = 6;
+  const int start = rank*n, end = start+n, N = procs*n;
+  ParallelIndexSet indexSet;
+  setOverlap(indexSet, std::max(start-1, 0), std::min(end+1, N), start, end);
+
+  RemoteIndices remoteIndices(indexSet, indexSet, comm);
+  remoteIndices.rebuild<true>();
+
+  bool success = true;
+  for(int width : {3, 2, 1}) {
+    remoteIndices.beginUpdate();
+    setOverlap(indexSet, std::max(start-width, 0), std::min(end+width, N), start, end);
+    remoteIndices.endUpdate<true>();
+
+    RemoteIndices rebuilt(indexSet, indexSet, comm);
+    rebuilt.rebuild<true>();
+    if(!remoteIndices.isSynced() || !(remoteIndices == rebuilt)) {
+      std::cerr<<rank<<": incremental update to overlap "<<width
+               <<" gives different remote indices"<<std::endl;
+      success = false;
+    }
+  }
+
+  // only the attribute of an index changes
+  remoteIndices.beginUpdate();
+  indexSet.beginResize();
+  for(ParallelIndexSet::iterator index = indexSet.begin(); index != indexSet.end(); ++index)
+    if(index->global() == start) {
+      indexSet.markAsDeleted(index);
+      indexSet.add(start, Dune::ParallelLocalIndex<GridFlags>(index->local().local(), border, true));
+    }
+  indexSet.endResize();
+  remoteIndices.endUpdate<true>();
+  RemoteIndices rebuilt(indexSet, indexSet, comm);
+  rebuilt.rebuild<true>();
+  if(!(remoteIndices == rebuilt)) {
+    std::cerr<<rank<<": incremental update of an attribute gives different remote indices"<<std::endl;
+    success = false;
+  }
+  return success;
+}
+
 /**
  * @brief MPI Error.
  * Thrown when an mpi error occurs.
@@ -716,8 +831,13 @@ int main(int argc, char **argv)
 
   //  testRedistributeIndices(comm);
   testRedistributeIndicesBuffered(comm);
+
+  bool success = testNeighbourDiscovery<false>(comm);
+  success = testNeighbourDiscovery<true>(comm) && success;
+  success = testUpdate(comm) && success;
+
   MPI_Comm_free(&comm);
   MPI_Finalize();
 
-  return 0;
+  return success ? 0 : 1;
 }
@@ -40,7 +40,7 @@ int meassure(const T& selection)
   return count;
 }
 
-template<int SIZE>
+template<int SIZE, class S>
 void test()
 {
   const int Nx = SIZE;
@@ -49,7 +49,7 @@ void test()
   // Process configuration
   const int ALSIZE=55;
 
-  Dune::ParallelIndexSet<int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE> distIndexSet;
+  Dune::ParallelIndexSet<int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE,S> distIndexSet;
 
   distIndexSet.beginResize();
 
@@ -64,16 +64,16 @@ void test()
 
   distIndexSet.endResize();
 
-  Dune::UncachedSelection<Dune::EnumItem<GridFlags,owner>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE>
+  Dune::UncachedSelection<Dune::EnumItem<GridFlags,owner>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE,S>
   ownerUncached(distIndexSet);
 
-  Dune::Selection<Dune::EnumItem<GridFlags,owner>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE>
+  Dune::Selection<Dune::EnumItem<GridFlags,owner>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE,S>
   ownerCached(distIndexSet);
 
-  Dune::UncachedSelection<Dune::EnumItem<GridFlags,overlap>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE>
+  Dune::UncachedSelection<Dune::EnumItem<GridFlags,overlap>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE,S>
   overlapUncached(distIndexSet);
 
-  Dune::Selection<Dune::EnumItem<GridFlags,overlap>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE>
+  Dune::Selection<Dune::EnumItem<GridFlags,overlap>,int,Dune::ParallelLocalIndex<GridFlags>,ALSIZE,S>
   overlapCached(distIndexSet);
 
   int count=0;
@@ -91,5 +91,8 @@ void test()
 
 int main()
 {
-  test<1000>();
+  std::cout<<"ArrayListIndexStorage:"<<std::endl;
+  test<1000,Dune::ArrayListIndexStorage>();
+  std::cout<<"ContiguousIndexStorage:"<<std::endl;
+  test<1000,Dune::ContiguousIndexStorage>();
 }
@@ -309,10 +309,19 @@ bool testIndicesSyncer()
   syncer.sync();
 
   std::cout<<rank<<": Synced:   "<<changedIndexSet<<std::endl<<changedRemoteIndices<<std::endl;
+  if(!areEqual(indexSet, remoteIndices,changedIndexSet, changedRemoteIndices)) {
+    std::cerr<<"Output not equal!"<<std::endl;
+    return false;
+  }
+
+  // Syncing again reuses the buffers and must not change anything
+  syncer.sync();
+
+  std::cout<<rank<<": Synced again:   "<<changedIndexSet<<std::endl<<changedRemoteIndices<<std::endl;
   if( areEqual(indexSet, remoteIndices,changedIndexSet, changedRemoteIndices))
     return true;
   else{
-    std::cerr<<"Output not equal!"<<std::endl;
+    std::cerr<<"Output not equal after syncing again!"<<std::endl;
     return false;
   }
 
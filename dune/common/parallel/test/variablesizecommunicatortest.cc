@@ -298,6 +298,36 @@ struct VarDataHandle1D : public VarDataHandle
     }
 };
 
+// A handle with a fixed size of zero items per entry, whose messages carry
+// only the size. Nothing is scattered for empty entries.
+struct EmptyDataHandle
+{
+    typedef double DataType;
+
+    bool fixedsize()
+    {
+        return true;
+    }
+    std::size_t size(int i)
+    {
+        DUNE_UNUSED_PARAMETER(i);
+        return 0;
+    }
+    template<class B>
+    void gather(B& buffer, int i)
+    {
+        DUNE_UNUSED_PARAMETER(buffer);
+        DUNE_UNUSED_PARAMETER(i);
+    }
+    template<class B>
+    void scatter(B& buffer, int i, int size)
+    {
+        DUNE_UNUSED_PARAMETER(buffer);
+        std::cerr << "Scattering "<<size<<" entries for "<<i<<" with an empty handle!" << std::endl;
+        std::abort();
+    }
+};
+
 int main(int argc, char** argv)
 {
     MPI_Init(&argc, &argv);
@@ -320,19 +350,31 @@ int main(int argc, char** argv)
         Interface inf;
         inf[0]=std::make_pair(send, recv);
         Dune::VariableSizeCommunicator<> comm(MPI_COMM_SELF, inf, 6);
-        MyDataHandle1D handle(0);
-        comm.forward(handle);
-        handle.verify(procs, 0, 0);
-        std::cout<<"===================== backward ========================="<<std::endl;
-        comm.backward(handle);
-        handle.verify(procs, 0, 0);
-        std::cout<<"================== variable size ======================="<<std::endl;
-        VarDataHandle1D vhandle(0);
-        comm.forward(vhandle);
-        vhandle.verify(procs, 0, 0);
-        std::cout<<"===================== backward ========================="<<std::endl;
-        comm.backward(vhandle);
-        vhandle.verify(procs, 0, 0);
+        // first with separate messages for the sizes, then with the sizes
+        // in the data messages
+        for(bool aggregate : {false, true})
+        {
+            comm.setAggregateMessages(aggregate);
+            std::cout<<"================ aggregate messages: "<<aggregate<<" ================="<<std::endl;
+            MyDataHandle1D handle(0);
+            comm.forward(handle);
+            handle.verify(procs, 0, 0);
+            std::cout<<"===================== backward ========================="<<std::endl;
+            comm.backward(handle);
+            handle.verify(procs, 0, 0);
+            std::cout<<"================== variable size ======================="<<std::endl;
+            VarDataHandle1D vhandle(0);
+            comm.forward(vhandle);
+            vhandle.verify(procs, 0, 0);
+            std::cout<<"===================== backward ========================="<<std::endl;
+            comm.backward(vhandle);
+            vhandle.verify(procs, 0, 0);
+            if(aggregate)
+            {
+                EmptyDataHandle ehandle;
+                comm.forward(ehandle);
+            }
+        }
     }
     else
     {
@@ -402,33 +444,44 @@ int main(int argc, char** argv)
             std::cout<<" rank "<<rank<<" has empty interface "<<inf.size()<<std::endl;
 
         Dune::VariableSizeCommunicator<> comm(MPI_COMM_WORLD, inf, 6);
-        MyDataHandle handle(rank);
-        comm.forward(handle);
-        MPI_Barrier(MPI_COMM_WORLD);
-        handle.verify(procs, start, end);
-        MPI_Barrier(MPI_COMM_WORLD);
-        if(rank==0)
-            std::cout<<"===================== backward ========================="<<std::endl;
-        MPI_Barrier(MPI_COMM_WORLD);
-        comm.backward(handle);
-        MPI_Barrier(MPI_COMM_WORLD);
-        handle.verify(procs, start, end);
-        MPI_Barrier(MPI_COMM_WORLD);
-        if(rank==0)
-            std::cout<<"================== variable size ======================="<<std::endl;
-        MPI_Barrier(MPI_COMM_WORLD);
-        VarDataHandle vhandle(rank);
-        MPI_Barrier(MPI_COMM_WORLD);
-        comm.forward(vhandle);
-        MPI_Barrier(MPI_COMM_WORLD);
-        vhandle.verify(procs, start, end);
-        MPI_Barrier(MPI_COMM_WORLD);
-        if(rank==0)
-            std::cout<<"===================== backward ========================="<<std::endl;
-        MPI_Barrier(MPI_COMM_WORLD);
-        comm.backward(vhandle);
-        MPI_Barrier(MPI_COMM_WORLD);
-        vhandle.verify(procs, start, end);
+        for(bool aggregate : {false, true})
+        {
+            comm.setAggregateMessages(aggregate);
+            if(rank==0)
+                std::cout<<"================ aggregate messages: "<<aggregate<<" ================="<<std::endl;
+            MyDataHandle handle(rank);
+            comm.forward(handle);
+            MPI_Barrier(MPI_COMM_WORLD);
+            handle.verify(procs, start, end);
+            MPI_Barrier(MPI_COMM_WORLD);
+            if(rank==0)
+                std::cout<<"===================== backward ========================="<<std::endl;
+            MPI_Barrier(MPI_COMM_WORLD);
+            comm.backward(handle);
+            MPI_Barrier(MPI_COMM_WORLD);
+            handle.verify(procs, start, end);
+            MPI_Barrier(MPI_COMM_WORLD);
+            if(rank==0)
+                std::cout<<"================== variable size ======================="<<std::endl;
+            MPI_Barrier(MPI_COMM_WORLD);
+            VarDataHandle vhandle(rank);
+            MPI_Barrier(MPI_COMM_WORLD);
+            comm.forward(vhandle);
+            MPI_Barrier(MPI_COMM_WORLD);
+            vhandle.verify(procs, start, end);
+            MPI_Barrier(MPI_COMM_WORLD);
+            if(rank==0)
+                std::cout<<"===================== backward ========================="<<std::endl;
+            MPI_Barrier(MPI_COMM_WORLD);
+            comm.backward(vhandle);
+            MPI_Barrier(MPI_COMM_WORLD);
+            vhandle.verify(procs, start, end);
+            if(aggregate)
+            {
+                EmptyDataHandle ehandle;
+                comm.forward(ehandle);
+            }
+        }
     }
 
     MPI_Finalize();
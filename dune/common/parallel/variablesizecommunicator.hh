@@ -8,15 +8,18 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <algorithm>
 
 #include <mpi.h>
 
+#include <dune/common/parallel/communicationprofile.hh>
 #include <dune/common/parallel/interface.hh>
 #include <dune/common/parallel/mpitraits.hh>
 #include <dune/common/unused.hh>
@@ -144,6 +147,105 @@ private:
   std::size_t position_;
 };
 
+/**
+ * @brief A buffer for a message that carries the sizes of the entries in
+ * front of their data.
+ *
+ * The message is sent as bytes, the items are copied in and out with
+ * memcpy. The bytes are stored in a vector owned by the communicator, so
+ * that the memory is reused by the next communication.
+ * @tparam T The type of data that the buffer will hold.
+ */
+template<class T>
+class AggregatedMessageBuffer
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Aggregated messages copy the data items as bytes");
+public:
+  /**
+   * @brief Constructs a buffer.
+   * @param buffer The vector to store the bytes of the message in.
+   */
+  explicit AggregatedMessageBuffer(std::vector<char>& buffer)
+    : buffer_(&buffer), sizePosition_(0), position_(0)
+  {}
+
+  /**
+   * @brief Prepare the buffer for writing a message.
+   * @param noSizes The number of sizes in front of the data.
+   * @param noItems The number of data items.
+   */
+  void allocate(std::size_t noSizes, std::size_t noItems)
+  {
+    resize(noSizes*sizeof(std::size_t)+noItems*sizeof(T));
+  }
+
+  /**
+   * @brief Prepare the buffer for receiving a message.
+   * @param bytes The size of the message in bytes.
+   */
+  void resize(std::size_t bytes)
+  {
+    buffer_->resize(bytes);
+    sizePosition_ = position_ = 0;
+  }
+
+  /** @brief Write the next size. */
+  void writeSize(std::size_t size)
+  {
+    std::memcpy(buffer_->data()+sizePosition_, &size, sizeof(std::size_t));
+    position_ = sizePosition_ += sizeof(std::size_t);
+  }
+
+  /** @brief Read the next size. */
+  std::size_t readSize()
+  {
+    std::size_t size;
+    std::memcpy(&size, buffer_->data()+sizePosition_, sizeof(std::size_t));
+    position_ = sizePosition_ += sizeof(std::size_t);
+    return size;
+  }
+
+  /**
+   * @brief Write an item to the buffer.
+   * @param data The data item to write.
+   */
+  void write(const T& data)
+  {
+    std::memcpy(buffer_->data()+position_, &data, sizeof(T));
+    position_ += sizeof(T);
+  }
+
+  /**
+   * @brief Reads a data item from the buffer
+   * @param[out] data Reference to where to store the read data.
+   */
+  void read(T& data)
+  {
+    std::memcpy(&data, buffer_->data()+position_, sizeof(T));
+    position_ += sizeof(T);
+  }
+
+  /** @brief The size of the message in bytes. */
+  std::size_t bytes() const
+  {
+    return buffer_->size();
+  }
+
+  /** @brief The bytes of the message. */
+  char* data()
+  {
+    return buffer_->data();
+  }
+
+private:
+  std::vector<char>* buffer_;
+  /** @brief The position of the next size in bytes. */
+  std::size_t sizePosition_;
+  /** @brief The position of the next data item in bytes. */
+  std::size_t position_;
+};
+
 /**
  * @brief A tracker for the current position in a communication interface.
  */
@@ -308,6 +410,12 @@ private:
  * communicate a vector in-place, e.g. to sum up partial results from
  * different ranks.  Instead, have separate source and target vectors and copy
  * the source vector to the target vector before communicating.
+ *
+ * By default the sizes of the entries are sent before the data, and both
+ * in messages of at most the maximum buffer size.  For many small entries
+ * the communication is then dominated by the latency of these messages.
+ * With setAggregateMessages(true) all the data for a neighbour is sent in a
+ * single message that carries the sizes in front of the data.
  */
 template<class Allocator=std::allocator<std::pair<InterfaceInformation,InterfaceInformation> > >
 class VariableSizeCommunicator
@@ -329,7 +437,7 @@ public:
    * is set to or 32768 if is not set.
    */
   VariableSizeCommunicator(MPI_Comm comm, const InterfaceMap& inf)
-    : maxBufferSize_(32768), interface_(&inf)
+    : maxBufferSize_(32768), interface_(&inf), aggregateMessages_(false)
   {
     MPI_Comm_dup(comm, &communicator_);
   }
@@ -338,7 +446,7 @@ public:
    * @param inf The communication interface.
    */
   VariableSizeCommunicator(const Interface& inf)
-  : maxBufferSize_(32768), interface_(&inf.interfaces())
+  : maxBufferSize_(32768), interface_(&inf.interfaces()), aggregateMessages_(false)
   {
     MPI_Comm_dup(inf.communicator(), &communicator_);
   }
@@ -351,7 +459,7 @@ public:
    */
   VariableSizeCommunicator(MPI_Comm comm, InterfaceMap& inf)
     : maxBufferSize_(DUNE_PARALLEL_MAX_COMMUNICATION_BUFFER_SIZE),
-      interface_(&inf)
+      interface_(&inf), aggregateMessages_(false)
   {
     MPI_Comm_dup(comm, &communicator_);
   }
@@ -361,7 +469,7 @@ public:
    */
   VariableSizeCommunicator(const Interface& inf)
   : maxBufferSize_(DUNE_PARALLEL_MAX_COMMUNICATION_BUFFER_SIZE),
-    interface_(&inf.interfaces())
+    interface_(&inf.interfaces()), aggregateMessages_(false)
   {
     MPI_Comm_dup(inf.communicator(), &communicator_);
   }
@@ -373,7 +481,7 @@ public:
   * @param max_buffer_size The maximum buffer size allowed.
   */
   VariableSizeCommunicator(MPI_Comm comm, const InterfaceMap& inf, std::size_t max_buffer_size)
-    : maxBufferSize_(max_buffer_size), interface_(&inf)
+    : maxBufferSize_(max_buffer_size), interface_(&inf), aggregateMessages_(false)
   {
     MPI_Comm_dup(comm, &communicator_);
   }
@@ -384,7 +492,8 @@ public:
   * @param max_buffer_size The maximum buffer size allowed.
   */
   VariableSizeCommunicator(const Interface& inf, std::size_t max_buffer_size)
-    : maxBufferSize_(max_buffer_size), interface_(&inf.interfaces())
+    : maxBufferSize_(max_buffer_size), interface_(&inf.interfaces()),
+      aggregateMessages_(false)
   {
     MPI_Comm_dup(inf.communicator(), &communicator_);
   }
@@ -445,6 +554,34 @@ public:
     communicate<false>(handle);
   }
 
+  /**
+   * @brief Send all data for a neighbour in a single message.
+   *
+   * If enabled, the sizes of the entries are sent in front of the data
+   * instead of in separate messages, and the data is not split into
+   * messages of the maximum buffer size.  The receiver probes for the
+   * message to allocate a buffer that is large enough.  This halves the
+   * number of messages for data of variable size and avoids further
+   * messages for large data, at the cost of buffers for the whole data,
+   * which are kept for the next communication.  The messages are sent as
+   * bytes, which requires DataHandle::DataType to be trivially copyable
+   * and all processes to use the same representation of it.
+   *
+   * All processes have to use the same setting.
+   */
+  void setAggregateMessages(bool aggregate)
+  {
+    aggregateMessages_ = aggregate;
+  }
+
+  /**
+   * @brief Whether all data for a neighbour is sent in a single message.
+   */
+  bool aggregateMessages() const
+  {
+    return aggregateMessages_;
+  }
+
 private:
   template<bool FORWARD, class DataHandle>
   void communicateSizes(DataHandle& handle,
@@ -489,6 +626,15 @@ private:
    */
   template<bool FORWARD, class DataHandle>
   void communicateVariableSize(DataHandle& handle);
+  /**
+   * @brief Communicate data with a single message per neighbour.
+   * @tparam FORWARD If true we send in the forward direction.
+   * @tparam DataHandle DataHandle The type of the data handle.
+   * @param handle The handle describing the data and responsible for gather
+   * and scatter operations.
+   */
+  template<bool FORWARD, class DataHandle>
+  void communicateAggregated(DataHandle& handle);
   /**
    * @brief The maximum size if the buffers used for gather and scatter.
    *
@@ -510,6 +656,22 @@ private:
    * This is a cloned communicator to ensure there are no interferences.
    */
   MPI_Comm communicator_;
+  /**
+   * @brief Whether all data for a neighbour is sent in a single message.
+   */
+  bool aggregateMessages_;
+  /**
+   * @brief The bytes of the messages sent with aggregated messages, one per neighbour.
+   */
+  std::vector<std::vector<char> > sendMessages_;
+  /**
+   * @brief The bytes of the message received last with aggregated messages.
+   */
+  std::vector<char> recvMessage_;
+  /**
+   * @brief The tag of the aggregated messages.
+   */
+  constexpr static int aggregatedTag_=933400;
 };
 
 /** @} */
@@ -791,13 +953,21 @@ struct SetupSendRequest{
                   MPI_Comm comm) const
   {
     buffer.reset();
-    int size=PackEntries<DataHandle>()(handle, tracker, buffer);
+    int size;
+    {
+      Impl::CommProfileTimer timer(CommunicationProfile::variableSizeCommunicator, CommunicationProfile::packTime);
+      size=PackEntries<DataHandle>()(handle, tracker, buffer);
+    }
     // Skip indices of zero size.
     while(!tracker.finished() &&  !handle.size(tracker.index()))
       tracker.moveToNextIndex();
     if(size)
+    {
+      Impl::commProfileSent(CommunicationProfile::variableSizeCommunicator, tracker.rank(),
+                            size*sizeof(typename DataHandle::DataType));
       MPI_Issend(buffer, size, MPITraits<typename DataHandle::DataType>::getType(),
                  tracker.rank(), 933399, comm, &request);
+    }
   }
 };
 
@@ -877,6 +1047,18 @@ std::size_t checkAndContinue(DataHandle& handle,
   {
     InterfaceTracker& tracker=trackers[*index];
     setReceivingIndex(handle, *index);
+#if DUNE_COMMUNICATION_PROFILING
+    // Only the functors that unpack data complete receives
+    if(!std::is_same<BufferFunctor,NullPackUnpackFunctor<DataHandle> >::value)
+    {
+      int received;
+      MPI_Get_count(&(statuses[index-indices.begin()]),
+                    MPITraits<typename DataHandle::DataType>::getType(),
+                    &received);
+      Impl::commProfileReceived(CommunicationProfile::variableSizeCommunicator, tracker.rank(),
+                                received*sizeof(typename DataHandle::DataType));
+    }
+#endif
     if(getCount)
     {
       // Get the number of entries received
@@ -885,9 +1067,13 @@ std::size_t checkAndContinue(DataHandle& handle,
                     MPITraits<typename DataHandle::DataType>::getType(),
                     &count);
       // Communication completed, we can reuse the buffers, e.g. unpack or repack
+      Impl::CommProfileTimer timer(CommunicationProfile::variableSizeCommunicator, CommunicationProfile::unpackTime);
       buffer_func(handle, tracker, buffers[*index], count);
     }else
+    {
+      Impl::CommProfileTimer timer(CommunicationProfile::variableSizeCommunicator, CommunicationProfile::unpackTime);
       buffer_func(handle, tracker, buffers[*index]);
+    }
     tracker.skipZeroIndices();
     if(!tracker.finished()){
       // Maybe start another communication.
@@ -1181,16 +1367,124 @@ void VariableSizeCommunicator<Allocator>::communicateVariableSize(DataHandle& ha
   }
 }
 
+template<class Allocator>
+template<bool FORWARD, class DataHandle>
+void VariableSizeCommunicator<Allocator>::communicateAggregated(DataHandle& handle)
+{
+  typedef typename DataHandle::DataType DataType;
+  typedef typename InterfaceMap::const_iterator IIter;
+  const bool fixedsize = handle.fixedsize();
+
+  // A message starts with the number of data items per entry if it is
+  // fixed, and with the number of items of each entry otherwise. The data
+  // of the entries is at the end.
+  sendMessages_.resize(interface_->size());
+  std::vector<AggregatedMessageBuffer<DataType> > send_buffers;
+  send_buffers.reserve(interface_->size());
+  for(std::vector<char>& message : sendMessages_)
+    send_buffers.push_back(AggregatedMessageBuffer<DataType>(message));
+  std::vector<MPI_Request> send_requests;
+  send_requests.reserve(interface_->size());
+  std::vector<IIter> to_recv;
+  to_recv.reserve(interface_->size());
+
+  typename std::vector<AggregatedMessageBuffer<DataType> >::iterator buffer=send_buffers.begin();
+  for(IIter inf=interface_->begin(), end=interface_->end(); inf!=end; ++inf)
+  {
+    if(InterfaceInformationChooser<FORWARD>::getReceive(inf->second).size())
+      to_recv.push_back(inf);
+    const InterfaceInformation& send=InterfaceInformationChooser<FORWARD>::getSend(inf->second);
+    if(!send.size())
+      continue;
+
+    Impl::CommProfileTimer timer(CommunicationProfile::variableSizeCommunicator, CommunicationProfile::packTime);
+    if(fixedsize)
+    {
+      const std::size_t size=handle.size(send[0]);
+      buffer->allocate(1, size*send.size());
+      buffer->writeSize(size);
+      for(std::size_t i=0; i<send.size(); ++i)
+        handle.gather(*buffer, send[i]);
+    }
+    else
+    {
+      std::size_t noItems=0;
+      for(std::size_t i=0; i<send.size(); ++i)
+        noItems+=handle.size(send[i]);
+      buffer->allocate(send.size(), noItems);
+      for(std::size_t i=0; i<send.size(); ++i)
+        buffer->writeSize(handle.size(send[i]));
+      for(std::size_t i=0; i<send.size(); ++i)
+        handle.gather(*buffer, send[i]);
+    }
+    Impl::commProfileSent(CommunicationProfile::variableSizeCommunicator, inf->first, buffer->bytes());
+    send_requests.push_back(MPI_REQUEST_NULL);
+    MPI_Isend(buffer->data(), buffer->bytes(), MPI_BYTE, inf->first, aggregatedTag_,
+              communicator_, &send_requests.back());
+    ++buffer;
+  }
+
+  // Receive the messages in the order they arrive. Probing each neighbour
+  // separately makes sure that a message of a following communication is
+  // not taken for one of this communication.
+  AggregatedMessageBuffer<DataType> recv_buffer(recvMessage_);
+  while(!to_recv.empty())
+  {
+    for(typename std::vector<IIter>::iterator inf=to_recv.begin(); inf!=to_recv.end();)
+    {
+      int flag;
+      MPI_Message message;
+      MPI_Status status;
+      MPI_Improbe((*inf)->first, aggregatedTag_, communicator_, &flag, &message, &status);
+      if(!flag)
+      {
+        ++inf;
+        continue;
+      }
+      int bytes;
+      MPI_Get_count(&status, MPI_BYTE, &bytes);
+      recv_buffer.resize(bytes);
+      MPI_Mrecv(recv_buffer.data(), bytes, MPI_BYTE, &message, MPI_STATUS_IGNORE);
+      Impl::commProfileReceived(CommunicationProfile::variableSizeCommunicator, (*inf)->first, bytes);
+
+      Impl::CommProfileTimer timer(CommunicationProfile::variableSizeCommunicator, CommunicationProfile::unpackTime);
+      const InterfaceInformation& recv=InterfaceInformationChooser<FORWARD>::getReceive((*inf)->second);
+      if(fixedsize)
+      {
+        const std::size_t size=recv_buffer.readSize();
+        if(size)
+          for(std::size_t i=0; i<recv.size(); ++i)
+            handle.scatter(recv_buffer, recv[i], size);
+      }
+      else
+      {
+        std::vector<std::size_t> sizes(recv.size());
+        for(std::size_t i=0; i<recv.size(); ++i)
+          sizes[i]=recv_buffer.readSize();
+        for(std::size_t i=0; i<recv.size(); ++i)
+          if(sizes[i])
+            handle.scatter(recv_buffer, recv[i], sizes[i]);
+      }
+      inf=to_recv.erase(inf);
+    }
+  }
+
+  MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
+}
+
 template<class Allocator>
 template<bool FORWARD, class DataHandle>
 void VariableSizeCommunicator<Allocator>::communicate(DataHandle& handle)
 {
+  Impl::CommProfileScope profile(CommunicationProfile::variableSizeCommunicator);
   if( interface_->size() == 0)
     // Simply return as otherwise we will index an empty container
     // either for MPI_Wait_all or MPI_Test_some.
     return;
 
-  if(handle.fixedsize())
+  if(aggregateMessages_)
+    communicateAggregated<FORWARD>(handle);
+  else if(handle.fixedsize())
     communicateFixedSize<FORWARD>(handle);
   else
     communicateVariableSize<FORWARD>(handle);
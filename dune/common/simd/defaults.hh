@@ -142,6 +142,104 @@ namespace Dune {
         return V(Simd::Scalar<V>(s));
       }
 
+      //! implements Simd::load<V>()
+      /**
+       * Default sets the lanes one by one.
+       */
+      template<class V>
+      V load(ADLTag<0>, MetaType<V>, const Scalar<V> *p)
+      {
+        V v(Scalar<V>(0));
+        for(std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+          Simd::lane(l, v) = p[l];
+        return v;
+      }
+
+      //! implements Simd::loadAligned<V>()
+      /**
+       * Default uses Simd::load<V>()
+       */
+      template<class V>
+      V loadAligned(ADLTag<0>, MetaType<V>, const Scalar<V> *p)
+      {
+        return Simd::load<V>(p);
+      }
+
+      //! implements Simd::store()
+      /**
+       * Default stores the lanes one by one.
+       */
+      template<class V>
+      void store(ADLTag<0>, const V &v, Scalar<V> *p)
+      {
+        for(std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+          p[l] = Simd::lane(l, v);
+      }
+
+      //! implements Simd::storeAligned()
+      /**
+       * Default uses Simd::store()
+       */
+      template<class V>
+      void storeAligned(ADLTag<0>, const V &v, Scalar<V> *p)
+      {
+        Simd::store(v, p);
+      }
+
+      //! implements Simd::maskedLoad<V>()
+      /**
+       * Default sets the selected lanes one by one.
+       */
+      template<class V>
+      V maskedLoad(ADLTag<0>, MetaType<V>, const Mask<V> &mask,
+                   const Scalar<V> *p)
+      {
+        V v(Scalar<V>(0));
+        for(std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+          if(Simd::lane(l, mask))
+            Simd::lane(l, v) = p[l];
+        return v;
+      }
+
+      //! implements Simd::maskedStore()
+      /**
+       * Default stores the selected lanes one by one.
+       */
+      template<class V>
+      void maskedStore(ADLTag<0>, const Mask<V> &mask, const V &v,
+                       Scalar<V> *p)
+      {
+        for(std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+          if(Simd::lane(l, mask))
+            p[l] = Simd::lane(l, v);
+      }
+
+      //! implements Simd::gather<V>()
+      /**
+       * Default sets the lanes one by one.
+       */
+      template<class V>
+      V gather(ADLTag<0>, MetaType<V>, const Scalar<V> *p,
+               const Index<V> &indices)
+      {
+        V v(Scalar<V>(0));
+        for(std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+          Simd::lane(l, v) = p[Simd::lane(l, indices)];
+        return v;
+      }
+
+      //! implements Simd::scatter()
+      /**
+       * Default stores the lanes one by one.
+       */
+      template<class V>
+      void scatter(ADLTag<0>, const V &v, Scalar<V> *p,
+                   const Index<V> &indices)
+      {
+        for(std::size_t l = 0; l < Simd::lanes<V>(); ++l)
+          p[Simd::lane(l, indices)] = Simd::lane(l, v);
+      }
+
       //! @} Overloadable and default functions
       //! @} Group SIMDAbstract
     } // namespace Overloads
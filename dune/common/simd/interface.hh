@@ -433,6 +433,136 @@ namespace Dune {
 
     //! @}
 
+    /** @name Memory access
+     *
+     * Functions in this group move data between arrays of scalars and SIMD
+     * vectors.  They are directly implemented by functions in namespace
+     * Overloads, which have defaults that access the lanes one by one.
+     *
+     * The functions creating a vector take the vector type as explicit
+     * template argument, like `broadcast()`.
+     *
+     * @{
+     */
+
+    //! Load a vector from consecutive memory locations
+    /**
+     * \param p Pointer to `lanes<V>()` consecutive scalars.  No alignment
+     *          beyond that of `Scalar<V>` is required.
+     *
+     * Equivalent to `lane(l, result) = p[l]` for all lanes `l`.
+     *
+     * Implemented by `Overloads::load()`.
+     */
+    template<class V>
+    V load(const Scalar<V> *p)
+    {
+      return load(Overloads::ADLTag<7>{}, MetaType<std::decay_t<V> >{}, p);
+    }
+
+    //! Load a vector from consecutive, aligned memory locations
+    /**
+     * Like `load()`, but `p` must be aligned to `alignof(V)`.  This may be
+     * faster than `load()` on some architectures.
+     *
+     * Implemented by `Overloads::loadAligned()`.
+     */
+    template<class V>
+    V loadAligned(const Scalar<V> *p)
+    {
+      return loadAligned(Overloads::ADLTag<7>{}, MetaType<std::decay_t<V> >{},
+                         p);
+    }
+
+    //! Store a vector to consecutive memory locations
+    /**
+     * \param v Vector to store.
+     * \param p Pointer to `lanes(v)` consecutive scalars.  No alignment
+     *          beyond that of `Scalar<V>` is required.
+     *
+     * Equivalent to `p[l] = lane(l, v)` for all lanes `l`.
+     *
+     * Implemented by `Overloads::store()`.
+     */
+    template<class V>
+    void store(const V &v, Scalar<V> *p)
+    {
+      store(Overloads::ADLTag<7>{}, v, p);
+    }
+
+    //! Store a vector to consecutive, aligned memory locations
+    /**
+     * Like `store()`, but `p` must be aligned to `alignof(V)`.
+     *
+     * Implemented by `Overloads::storeAligned()`.
+     */
+    template<class V>
+    void storeAligned(const V &v, Scalar<V> *p)
+    {
+      storeAligned(Overloads::ADLTag<7>{}, v, p);
+    }
+
+    //! Load the lanes selected by a mask from consecutive memory locations
+    /**
+     * Equivalent to
+     * \code
+     *   lane(l, result) = lane(l, mask) ? p[l] : Scalar<V>(0);
+     * \endcode
+     * for all lanes `l`.  `p[l]` is not accessed for lanes where `mask` is
+     * `false`, so this can be used to load the incomplete tail of an array.
+     *
+     * Implemented by `Overloads::maskedLoad()`.
+     */
+    template<class V>
+    V maskedLoad(const Mask<V> &mask, const Scalar<V> *p)
+    {
+      return maskedLoad(Overloads::ADLTag<7>{}, MetaType<std::decay_t<V> >{},
+                        mask, p);
+    }
+
+    //! Store the lanes selected by a mask to consecutive memory locations
+    /**
+     * Equivalent to `if(lane(l, mask)) p[l] = lane(l, v);` for all lanes
+     * `l`.  `p[l]` is not accessed for lanes where `mask` is `false`.
+     *
+     * Implemented by `Overloads::maskedStore()`.
+     */
+    template<class V>
+    void maskedStore(const Mask<V> &mask, const V &v, Scalar<V> *p)
+    {
+      maskedStore(Overloads::ADLTag<7>{}, mask, v, p);
+    }
+
+    //! Load a vector from indexed memory locations
+    /**
+     * Equivalent to `lane(l, result) = p[lane(l, indices)]` for all lanes
+     * `l`.
+     *
+     * Implemented by `Overloads::gather()`.
+     */
+    template<class V>
+    V gather(const Scalar<V> *p, const Index<V> &indices)
+    {
+      return gather(Overloads::ADLTag<7>{}, MetaType<std::decay_t<V> >{},
+                    p, indices);
+    }
+
+    //! Store a vector to indexed memory locations
+    /**
+     * Equivalent to `p[lane(l, indices)] = lane(l, v)` for all lanes `l`.
+     * If several lanes have the same index, it is unspecified which of their
+     * values ends up in memory.
+     *
+     * Implemented by `Overloads::scatter()`.
+     */
+    template<class V>
+    void scatter(const V &v, Scalar<V> *p, const Index<V> &indices)
+    {
+      scatter(Overloads::ADLTag<7>{}, v, p, indices);
+    }
+
+    //! @}
+
     /** @name Syntactic Sugar
      *
      * Templates and functions in this group provide syntactic sugar, they are
@@ -355,6 +355,70 @@ namespace Dune {
         }
         return out;
       }
+
+      template<class T, std::size_t S>
+      LoopSIMD<T,S> load(ADLTag<5>, MetaType<LoopSIMD<T,S>>, const T *p) {
+        LoopSIMD<T,S> out;
+        for(std::size_t i=0; i<S; i++) {
+          out[i] = p[i];
+        }
+        return out;
+      }
+
+      template<class T, std::size_t S>
+      LoopSIMD<T,S> loadAligned(ADLTag<5>, MetaType<LoopSIMD<T,S>>,
+                                const T *p) {
+        return load(ADLTag<5>{}, MetaType<LoopSIMD<T,S>>{}, p);
+      }
+
+      template<class T, std::size_t S>
+      void store(ADLTag<5>, const LoopSIMD<T,S> &v, T *p) {
+        for(std::size_t i=0; i<S; i++) {
+          p[i] = v[i];
+        }
+      }
+
+      template<class T, std::size_t S>
+      void storeAligned(ADLTag<5>, const LoopSIMD<T,S> &v, T *p) {
+        store(ADLTag<5>{}, v, p);
+      }
+
+      template<class T, std::size_t S>
+      LoopSIMD<T,S> maskedLoad(ADLTag<5>, MetaType<LoopSIMD<T,S>>,
+                               const LoopSIMD<bool,S> &mask, const T *p) {
+        LoopSIMD<T,S> out;
+        for(std::size_t i=0; i<S; i++) {
+          out[i] = mask[i] ? p[i] : T(0);
+        }
+        return out;
+      }
+
+      template<class T, std::size_t S>
+      void maskedStore(ADLTag<5>, const LoopSIMD<bool,S> &mask,
+                       const LoopSIMD<T,S> &v, T *p) {
+        for(std::size_t i=0; i<S; i++) {
+          if(mask[i])
+            p[i] = v[i];
+        }
+      }
+
+      template<class T, std::size_t S>
+      LoopSIMD<T,S> gather(ADLTag<5>, MetaType<LoopSIMD<T,S>>, const T *p,
+                           const LoopSIMD<std::size_t,S> &indices) {
+        LoopSIMD<T,S> out;
+        for(std::size_t i=0; i<S; i++) {
+          out[i] = p[indices[i]];
+        }
+        return out;
+      }
+
+      template<class T, std::size_t S>
+      void scatter(ADLTag<5>, const LoopSIMD<T,S> &v, T *p,
+                   const LoopSIMD<std::size_t,S> &indices) {
+        for(std::size_t i=0; i<S; i++) {
+          p[indices[i]] = v[i];
+        }
+      }
     }  //namespace Overloads
 
   }  //namespace Simd
@@ -119,6 +119,71 @@ namespace Dune {
       //! implements Simd::allFalse()
       inline bool allFalse(ADLTag<2>, bool mask) { return !mask; }
 
+      //! implements Simd::load<V>()
+      template<class V>
+      V load(ADLTag<2, std::is_same<V, Scalar<V> >::value>, MetaType<V>,
+             const V *p)
+      {
+        return *p;
+      }
+
+      //! implements Simd::loadAligned<V>()
+      template<class V>
+      V loadAligned(ADLTag<2, std::is_same<V, Scalar<V> >::value>,
+                    MetaType<V>, const V *p)
+      {
+        return *p;
+      }
+
+      //! implements Simd::store()
+      template<class V>
+      void store(ADLTag<2, std::is_same<V, Scalar<V> >::value>,
+                 const V &v, V *p)
+      {
+        *p = v;
+      }
+
+      //! implements Simd::storeAligned()
+      template<class V>
+      void storeAligned(ADLTag<2, std::is_same<V, Scalar<V> >::value>,
+                        const V &v, V *p)
+      {
+        *p = v;
+      }
+
+      //! implements Simd::maskedLoad<V>()
+      template<class V>
+      V maskedLoad(ADLTag<2, std::is_same<V, Scalar<V> >::value>,
+                   MetaType<V>, bool mask, const V *p)
+      {
+        return mask ? *p : V(0);
+      }
+
+      //! implements Simd::maskedStore()
+      template<class V>
+      void maskedStore(ADLTag<2, std::is_same<V, Scalar<V> >::value>,
+                       bool mask, const V &v, V *p)
+      {
+        if(mask)
+          *p = v;
+      }
+
+      //! implements Simd::gather<V>()
+      template<class V>
+      V gather(ADLTag<2, std::is_same<V, Scalar<V> >::value>, MetaType<V>,
+               const V *p, std::size_t index)
+      {
+        return p[index];
+      }
+
+      //! implements Simd::scatter()
+      template<class V>
+      void scatter(ADLTag<2, std::is_same<V, Scalar<V> >::value>,
+                   const V &v, V *p, std::size_t index)
+      {
+        p[index] = v;
+      }
+
       //! @} group SIMDStandard
 
     } // namespace Overloads
@@ -1518,6 +1518,110 @@ namespace Dune {
         }
       }
 
+      template<class V>
+      void checkLoadStore()
+      {
+        using M = Mask<V>;
+        using I = Index<V>;
+        using T = Scalar<V>;
+        constexpr std::size_t L = lanes<V>();
+
+        static_assert
+          (std::is_same<decltype(load<V>(std::declval<const T*>())), V>::value,
+           "The result of load<V>() should have exactly the type V");
+        static_assert
+          (std::is_same<decltype(maskedLoad<V>(std::declval<const M&>(),
+                                               std::declval<const T*>())),
+                        V>::value,
+           "The result of maskedLoad<V>() should have exactly the type V");
+        static_assert
+          (std::is_same<decltype(gather<V>(std::declval<const T*>(),
+                                           std::declval<const I&>())),
+                        V>::value,
+           "The result of gather<V>() should have exactly the type V");
+
+        // the arrays have one guard element at either end to detect
+        // accesses outside of the lanes
+        auto source = [](std::size_t i) { return T((i+1)%3); };
+        auto background = [](std::size_t i) { return T((i+2)%3); };
+        T src[L+2];
+        T dst[L+2];
+        alignas(V) T aligned[L];
+        for(std::size_t i = 0; i < L+2; ++i)
+          src[i] = source(i);
+        auto resetDst = [&] {
+          for(std::size_t i = 0; i < L+2; ++i)
+            dst[i] = background(i);
+        };
+        auto guardsIntact = [&] {
+          return dst[0] == background(0) && dst[L+1] == background(L+1);
+        };
+
+        // mask selecting the odd lanes, and indices reversing the lanes
+        M mask(Scalar<M>(false));
+        I reversed(Scalar<I>(0));
+        for(std::size_t l = 0; l < L; ++l)
+        {
+          lane(l, mask) = (l % 2);
+          lane(l, reversed) = Scalar<I>(L-1-l);
+        }
+
+        // unaligned
+        {
+          const V vec = load<V>(src+1);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(lane(l, vec) == src[l+1]);
+
+          resetDst();
+          store(vec, dst+1);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(dst[l+1] == src[l+1]);
+          DUNE_SIMD_CHECK(guardsIntact());
+        }
+
+        // aligned
+        {
+          for(std::size_t l = 0; l < L; ++l)
+            aligned[l] = src[l+1];
+          const V vec = loadAligned<V>(aligned);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(lane(l, vec) == src[l+1]);
+
+          for(std::size_t l = 0; l < L; ++l)
+            aligned[l] = background(l);
+          storeAligned(vec, aligned);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(aligned[l] == src[l+1]);
+        }
+
+        // masked
+        {
+          const V vec = maskedLoad<V>(mask, src+1);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(lane(l, vec) == ((l % 2) ? src[l+1] : T(0)));
+
+          const V full = load<V>(src+1);
+          resetDst();
+          maskedStore(mask, full, dst+1);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(dst[l+1] == ((l % 2) ? src[l+1] : background(l+1)));
+          DUNE_SIMD_CHECK(guardsIntact());
+        }
+
+        // gather and scatter
+        {
+          const V vec = gather<V>(src+1, reversed);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(lane(l, vec) == src[L-l]);
+
+          resetDst();
+          scatter(vec, dst+1, reversed);
+          for(std::size_t l = 0; l < L; ++l)
+            DUNE_SIMD_CHECK(dst[l+1] == src[l+1]);
+          DUNE_SIMD_CHECK(guardsIntact());
+        }
+      }
+
 #undef DUNE_SIMD_CHECK
 
     public:
@@ -1643,6 +1747,8 @@ namespace Dune {
 
       checkMinMax<V>();
       checkIO<V>();
+
+      checkLoadStore<V>();
     }
 
     template<class M>
@@ -1689,6 +1795,8 @@ namespace Dune {
 
       checkMinMax<M>();
       checkIO<M>();
+
+      checkLoadStore<M>();
     }
 
   } // namespace Simd
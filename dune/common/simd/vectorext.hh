@@ -0,0 +1,742 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_COMMON_SIMD_VECTOREXT_HH
+#define DUNE_COMMON_SIMD_VECTOREXT_HH
+
+/** @file
+ *  @ingroup SIMDVectorExt
+ *  @brief SIMD abstractions for the vector extensions of GCC and Clang
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+#include <dune/common/simd/defaults.hh>
+#include <dune/common/simd/simd.hh>
+#include <dune/common/typetraits.hh>
+
+/** @defgroup SIMDVectorExt SIMD Abstraction Implementation for compiler vector extensions
+ *  @ingroup SIMDApp
+ *
+ * This implements the vectorization interface for `VectorExtSIMD<T,S>` and
+ * `VectorExtMask<T,S>`, which wrap the generic vector types that GCC and
+ * Clang provide through `__attribute__((vector_size(N)))`.  Arithmetic,
+ * bitwise and comparison operations as well as `cond()` map directly to
+ * operations on these vector types, which the compiler translates to the
+ * SIMD instructions of the target architecture, or to a sequence of scalar
+ * instructions if the target has no suitable instructions.  Contrary to Vc,
+ * no external library is needed.
+ *
+ * The scalar type `T` must be an arithmetic type other than `bool` of at
+ * most 8 bytes, and the number of lanes `S` must be a power of two.  The
+ * mask of `VectorExtSIMD<T,S>` is `VectorExtMask<T,S>`, whose lanes are
+ * stored as signed integers of the same size as `T`, with all bits set for
+ * `true`.  The index type is `VectorExtSIMD<std::size_t,S>`.
+ *
+ * The functions from `<cmath>` are applied lane by lane, there is no vector
+ * math library behind them.
+ *
+ * @note Vectors larger than 16 bytes may be over-aligned.  Before C++17,
+ *       dynamically allocated objects (e.g. in a `std::vector`) are not
+ *       guaranteed to respect that alignment.
+ *
+ * @note g++ warns (`-Wpsabi`) when vectors wider than the enabled
+ *       instruction set are passed to or returned from functions, because
+ *       the calling convention differs between instruction sets.  This is
+ *       harmless as long as all code is compiled with the same flags, and
+ *       can be silenced with `-Wno-psabi`.
+ */
+
+namespace Dune {
+
+  template<class T, std::size_t S>
+  class VectorExtSIMD;
+
+  template<class T, std::size_t S>
+  class VectorExtMask;
+
+  namespace Simd {
+    namespace VectorExtImpl {
+
+      template<class T, std::size_t S>
+      struct Native
+      {
+        static_assert(std::is_arithmetic<T>::value &&
+                      !std::is_same<T, bool>::value && sizeof(T) <= 8,
+                      "VectorExtSIMD only supports arithmetic types other than "
+                      "bool of at most 8 bytes");
+        static_assert(S > 0 && (S & (S-1)) == 0,
+                      "The number of lanes of VectorExtSIMD must be a power "
+                      "of two");
+
+        typedef T type __attribute__((vector_size(sizeof(T)*S)));
+        // the result of comparisons: signed integers with all bits set for true
+        using mask = decltype(std::declval<type>() < std::declval<type>());
+      };
+
+      // reinterpret the bits of a native vector as another native vector of
+      // the same size
+      template<class To, class From>
+      To bitCast(const From &from)
+      {
+        static_assert(sizeof(To) == sizeof(From),
+                      "Can only reinterpret vectors of the same size");
+        return (To)from;
+      }
+
+      //! A reference-like proxy for the lanes of a VectorExtMask
+      template<class M>
+      class MaskProxy
+      {
+        M &mask_;
+        std::size_t idx_;
+
+      public:
+        using value_type = bool;
+
+        MaskProxy(std::size_t idx, M &mask)
+          : mask_(mask), idx_(idx)
+        { }
+
+        operator bool() const { return mask_.get(idx_); }
+
+        bool operator!() const { return !mask_.get(idx_); }
+
+        MaskProxy &operator=(const MaskProxy &o)
+        {
+          mask_.set(idx_, bool(o));
+          return *this;
+        }
+
+        template<class T,
+                 class = std::enable_if_t<std::is_convertible<T, bool>::value> >
+        MaskProxy &operator=(T &&o)
+        {
+          mask_.set(idx_, bool(o));
+          return *this;
+        }
+
+#define DUNE_SIMD_VECTOREXT_PROXY_ASSIGNMENT(SYMBOL)                    \
+        template<class T, class = std::enable_if_t<                     \
+                            std::is_convertible<T, bool>::value> >      \
+        MaskProxy &operator SYMBOL##=(T &&o)                            \
+        {                                                               \
+          mask_.set(idx_, mask_.get(idx_) SYMBOL bool(o));              \
+          return *this;                                                 \
+        }
+
+        DUNE_SIMD_VECTOREXT_PROXY_ASSIGNMENT(&);
+        DUNE_SIMD_VECTOREXT_PROXY_ASSIGNMENT(|);
+        DUNE_SIMD_VECTOREXT_PROXY_ASSIGNMENT(^);
+#undef DUNE_SIMD_VECTOREXT_PROXY_ASSIGNMENT
+      };
+
+    } // namespace VectorExtImpl
+  } // namespace Simd
+
+  /**
+   *  @ingroup SIMDVectorExt
+   *  @brief SIMD vector with `S` lanes of type `T` based on the vector
+   *         extensions of GCC and Clang
+   *
+   *  The lanes can be accessed with `operator[]`, the underlying compiler
+   *  vector with `native()`.  All operators supported by the scalar type are
+   *  supported lane-wise, comparisons result in a `VectorExtMask<T,S>`.
+   *  Operations with a scalar of type `T` broadcast the scalar.
+   */
+  template<class T, std::size_t S>
+  class VectorExtSIMD
+  {
+  public:
+    //! the compiler vector type
+    using NativeType = typename Simd::VectorExtImpl::Native<T,S>::type;
+    using value_type = T;
+    using mask_type = VectorExtMask<T,S>;
+
+    //! the number of lanes
+    static constexpr std::size_t size() { return S; }
+
+    //! construct without initializing the lanes
+    VectorExtSIMD() = default;
+
+    //! broadcast a scalar
+    VectorExtSIMD(const T &s)
+    {
+      for(std::size_t l = 0; l < S; ++l)
+        v_[l] = s;
+    }
+
+    //! wrap a compiler vector
+    explicit VectorExtSIMD(const NativeType &v) : v_(v) {}
+
+    NativeType &native() { return v_; }
+    const NativeType &native() const { return v_; }
+
+    T &operator[](std::size_t l)
+    {
+      return reinterpret_cast<T*>(&v_)[l];
+    }
+    const T &operator[](std::size_t l) const
+    {
+      return reinterpret_cast<const T*>(&v_)[l];
+    }
+
+    // prefix and postfix operators
+    VectorExtSIMD &operator++() { v_ += VectorExtSIMD(T(1)).v_; return *this; }
+    VectorExtSIMD &operator--() { v_ -= VectorExtSIMD(T(1)).v_; return *this; }
+    VectorExtSIMD operator++(int) { auto out = *this; ++*this; return out; }
+    VectorExtSIMD operator--(int) { auto out = *this; --*this; return out; }
+
+    // unary operators
+    VectorExtSIMD operator+() const { return *this; }
+    VectorExtSIMD operator-() const { return VectorExtSIMD(-v_); }
+    VectorExtSIMD operator~() const { return VectorExtSIMD(~v_); }
+    mask_type operator!() const { return mask_type(v_ == NativeType{}); }
+
+    // assignment operators
+#define DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(SYMBOL)       \
+    VectorExtSIMD &operator SYMBOL(const T &s)          \
+    {                                                   \
+      v_ SYMBOL VectorExtSIMD(s).v_;                    \
+      return *this;                                     \
+    }                                                   \
+    VectorExtSIMD &operator SYMBOL(const VectorExtSIMD &o) \
+    {                                                   \
+      v_ SYMBOL o.v_;                                   \
+      return *this;                                     \
+    }
+
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(+=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(-=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(*=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(/=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(%=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(<<=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(>>=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(&=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(|=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(^=);
+#undef DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP
+
+  private:
+    NativeType v_;
+  };
+
+  /**
+   *  @ingroup SIMDVectorExt
+   *  @brief Mask for `VectorExtSIMD<T,S>`
+   *
+   *  The lanes are stored as signed integers of the size of `T`, with all
+   *  bits set for `true` and no bits set for `false`, which is the
+   *  representation the compiler uses for the result of vector comparisons.
+   */
+  template<class T, std::size_t S>
+  class VectorExtMask
+  {
+  public:
+    //! the compiler vector type
+    using NativeType = typename Simd::VectorExtImpl::Native<T,S>::mask;
+    using value_type = bool;
+
+    //! the number of lanes
+    static constexpr std::size_t size() { return S; }
+
+    //! construct without initializing the lanes
+    VectorExtMask() = default;
+
+    //! broadcast a bool
+    VectorExtMask(bool b)
+    {
+      for(std::size_t l = 0; l < S; ++l)
+        set(l, b);
+    }
+
+    //! wrap a compiler vector, each lane must be either 0 or -1
+    explicit VectorExtMask(const NativeType &m) : m_(m) {}
+
+    NativeType &native() { return m_; }
+    const NativeType &native() const { return m_; }
+
+    bool get(std::size_t l) const { return m_[l] != 0; }
+    void set(std::size_t l, bool b) { m_[l] = b ? -1 : 0; }
+
+    Simd::VectorExtImpl::MaskProxy<VectorExtMask> operator[](std::size_t l)
+    {
+      return { l, *this };
+    }
+    bool operator[](std::size_t l) const { return get(l); }
+
+    VectorExtMask operator!() const { return VectorExtMask(~m_); }
+
+#define DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(SYMBOL)          \
+    VectorExtMask &operator SYMBOL(const VectorExtMask &o) \
+    {                                                      \
+      m_ SYMBOL o.m_;                                      \
+      return *this;                                        \
+    }
+
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(&=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(|=);
+    DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP(^=);
+#undef DUNE_SIMD_VECTOREXT_ASSIGNMENT_OP
+
+  private:
+    NativeType m_;
+  };
+
+  //Arithmetic and bitwise operators
+#define DUNE_SIMD_VECTOREXT_BINARY_OP(SYMBOL)                           \
+  template<class T, std::size_t S>                                      \
+  VectorExtSIMD<T,S> operator SYMBOL(const VectorExtSIMD<T,S> &v,       \
+                                     const VectorExtSIMD<T,S> &w) {     \
+    return VectorExtSIMD<T,S>(v.native() SYMBOL w.native());            \
+  }                                                                     \
+  template<class T, std::size_t S>                                      \
+  VectorExtSIMD<T,S> operator SYMBOL(const VectorExtSIMD<T,S> &v,       \
+                                     const T &s) {                      \
+    return v SYMBOL VectorExtSIMD<T,S>(s);                              \
+  }                                                                     \
+  template<class T, std::size_t S>                                      \
+  VectorExtSIMD<T,S> operator SYMBOL(const T &s,                        \
+                                     const VectorExtSIMD<T,S> &v) {     \
+    return VectorExtSIMD<T,S>(s) SYMBOL v;                              \
+  }
+
+  DUNE_SIMD_VECTOREXT_BINARY_OP(+);
+  DUNE_SIMD_VECTOREXT_BINARY_OP(-);
+  DUNE_SIMD_VECTOREXT_BINARY_OP(*);
+  DUNE_SIMD_VECTOREXT_BINARY_OP(/);
+  DUNE_SIMD_VECTOREXT_BINARY_OP(%);
+
+  DUNE_SIMD_VECTOREXT_BINARY_OP(&);
+  DUNE_SIMD_VECTOREXT_BINARY_OP(|);
+  DUNE_SIMD_VECTOREXT_BINARY_OP(^);
+
+#undef DUNE_SIMD_VECTOREXT_BINARY_OP
+
+  //Bitshift operators
+#define DUNE_SIMD_VECTOREXT_BITSHIFT_OP(SYMBOL)                         \
+  template<class T, std::size_t S>                                      \
+  VectorExtSIMD<T,S> operator SYMBOL(const VectorExtSIMD<T,S> &v,       \
+                                     const VectorExtSIMD<T,S> &w) {     \
+    return VectorExtSIMD<T,S>(v.native() SYMBOL w.native());            \
+  }                                                                     \
+  template<class T, std::size_t S, class U,                             \
+           class = std::enable_if_t<std::is_integral<U>::value> >       \
+  VectorExtSIMD<T,S> operator SYMBOL(const VectorExtSIMD<T,S> &v,       \
+                                     const U &s) {                      \
+    return v SYMBOL VectorExtSIMD<T,S>(T(s));                           \
+  }
+
+  DUNE_SIMD_VECTOREXT_BITSHIFT_OP(<<);
+  DUNE_SIMD_VECTOREXT_BITSHIFT_OP(>>);
+
+#undef DUNE_SIMD_VECTOREXT_BITSHIFT_OP
+
+  //Comparison operators
+#define DUNE_SIMD_VECTOREXT_COMPARISON_OP(SYMBOL)                       \
+  template<class T, std::size_t S>                                      \
+  VectorExtMask<T,S> operator SYMBOL(const VectorExtSIMD<T,S> &v,       \
+                                     const VectorExtSIMD<T,S> &w) {     \
+    return VectorExtMask<T,S>(v.native() SYMBOL w.native());            \
+  }                                                                     \
+  template<class T, std::size_t S>                                      \
+  VectorExtMask<T,S> operator SYMBOL(const VectorExtSIMD<T,S> &v,       \
+                                     const T &s) {                      \
+    return v SYMBOL VectorExtSIMD<T,S>(s);                              \
+  }                                                                     \
+  template<class T, std::size_t S>                                      \
+  VectorExtMask<T,S> operator SYMBOL(const T &s,                        \
+                                     const VectorExtSIMD<T,S> &v) {     \
+    return VectorExtSIMD<T,S>(s) SYMBOL v;                              \
+  }
+
+  DUNE_SIMD_VECTOREXT_COMPARISON_OP(<);
+  DUNE_SIMD_VECTOREXT_COMPARISON_OP(>);
+  DUNE_SIMD_VECTOREXT_COMPARISON_OP(<=);
+  DUNE_SIMD_VECTOREXT_COMPARISON_OP(>=);
+  DUNE_SIMD_VECTOREXT_COMPARISON_OP(==);
+  DUNE_SIMD_VECTOREXT_COMPARISON_OP(!=);
+#undef DUNE_SIMD_VECTOREXT_COMPARISON_OP
+
+  //Mask operators
+#define DUNE_SIMD_VECTOREXT_MASK_OP(SYMBOL, NATIVE)                     \
+  template<class T, std::size_t S>                                      \
+  VectorExtMask<T,S> operator SYMBOL(const VectorExtMask<T,S> &m,       \
+                                     const VectorExtMask<T,S> &n) {     \
+    return VectorExtMask<T,S>(m.native() NATIVE n.native());            \
+  }
+
+  DUNE_SIMD_VECTOREXT_MASK_OP(&, &);
+  DUNE_SIMD_VECTOREXT_MASK_OP(|, |);
+  DUNE_SIMD_VECTOREXT_MASK_OP(^, ^);
+  DUNE_SIMD_VECTOREXT_MASK_OP(&&, &);
+  DUNE_SIMD_VECTOREXT_MASK_OP(||, |);
+  DUNE_SIMD_VECTOREXT_MASK_OP(==, ==);
+  DUNE_SIMD_VECTOREXT_MASK_OP(!=, !=);
+#undef DUNE_SIMD_VECTOREXT_MASK_OP
+
+#define DUNE_SIMD_VECTOREXT_MASK_BOOL_OP(SYMBOL)                        \
+  template<class T, std::size_t S>                                      \
+  VectorExtMask<T,S> operator SYMBOL(const VectorExtMask<T,S> &m,       \
+                                     bool b) {                          \
+    return m SYMBOL VectorExtMask<T,S>(b);                              \
+  }                                                                     \
+  template<class T, std::size_t S>                                      \
+  VectorExtMask<T,S> operator SYMBOL(bool b,                            \
+                                     const VectorExtMask<T,S> &m) {     \
+    return VectorExtMask<T,S>(b) SYMBOL m;                              \
+  }
+
+  DUNE_SIMD_VECTOREXT_MASK_BOOL_OP(&&);
+  DUNE_SIMD_VECTOREXT_MASK_BOOL_OP(||);
+#undef DUNE_SIMD_VECTOREXT_MASK_BOOL_OP
+
+  //prints a given VectorExtSIMD
+  template<class T, std::size_t S>
+  std::ostream& operator<< (std::ostream &os, const VectorExtSIMD<T,S> &v) {
+    os << "[";
+    for(std::size_t i=0; i<S-1; i++) {
+      os << v[i] << ", ";
+    }
+    os << v[S-1] << "]";
+    return os;
+  }
+
+  //prints a given VectorExtMask
+  template<class T, std::size_t S>
+  std::ostream& operator<< (std::ostream &os, const VectorExtMask<T,S> &m) {
+    os << "[";
+    for(std::size_t i=0; i<S-1; i++) {
+      os << m[i] << ", ";
+    }
+    os << m[S-1] << "]";
+    return os;
+  }
+
+  namespace Simd {
+    namespace Overloads {
+
+      /** @name Specialized classes and overloaded functions
+       *  @ingroup SIMDVectorExt
+       *  @{
+       */
+
+      //! Implements Simd::Scalar
+      template<class T, std::size_t S>
+      struct ScalarType<VectorExtSIMD<T,S> > { using type = T; };
+
+      //! Implements Simd::Scalar
+      template<class T, std::size_t S>
+      struct ScalarType<VectorExtMask<T,S> > { using type = bool; };
+
+      //! Implements Simd::Index
+      template<class T, std::size_t S>
+      struct IndexType<VectorExtSIMD<T,S> >
+      {
+        using type = VectorExtSIMD<std::size_t,S>;
+      };
+
+      //! Implements Simd::Index
+      template<class T, std::size_t S>
+      struct IndexType<VectorExtMask<T,S> >
+      {
+        using type = VectorExtSIMD<std::size_t,S>;
+      };
+
+      //! Implements Simd::Mask
+      template<class T, std::size_t S>
+      struct MaskType<VectorExtSIMD<T,S> >
+      {
+        using type = VectorExtMask<T,S>;
+      };
+
+      //! Implements Simd::Mask
+      template<class T, std::size_t S>
+      struct MaskType<VectorExtMask<T,S> >
+      {
+        using type = VectorExtMask<T,S>;
+      };
+
+      //! Implements Simd::lanes()
+      template<class T, std::size_t S>
+      struct LaneCount<VectorExtSIMD<T,S> > : index_constant<S> {};
+
+      //! Implements Simd::lanes()
+      template<class T, std::size_t S>
+      struct LaneCount<VectorExtMask<T,S> > : index_constant<S> {};
+
+      //! implements Simd::lane()
+      template<class T, std::size_t S>
+      T &lane(ADLTag<5>, std::size_t l, VectorExtSIMD<T,S> &v)
+      {
+        return v[l];
+      }
+
+      //! implements Simd::lane()
+      template<class T, std::size_t S>
+      const T &lane(ADLTag<5>, std::size_t l, const VectorExtSIMD<T,S> &v)
+      {
+        return v[l];
+      }
+
+      //! implements Simd::lane()
+      template<class T, std::size_t S>
+      T lane(ADLTag<5>, std::size_t l, VectorExtSIMD<T,S> &&v)
+      {
+        return v[l];
+      }
+
+      //! implements Simd::lane()
+      template<class T, std::size_t S>
+      VectorExtImpl::MaskProxy<VectorExtMask<T,S> >
+      lane(ADLTag<5>, std::size_t l, VectorExtMask<T,S> &m)
+      {
+        return m[l];
+      }
+
+      //! implements Simd::lane()
+      template<class T, std::size_t S>
+      bool lane(ADLTag<5>, std::size_t l, const VectorExtMask<T,S> &m)
+      {
+        return m.get(l);
+      }
+
+      //! implements Simd::lane()
+      template<class T, std::size_t S>
+      bool lane(ADLTag<5>, std::size_t l, VectorExtMask<T,S> &&m)
+      {
+        return m.get(l);
+      }
+
+      //! implements Simd::cond()
+      /**
+       * Selects the bits of the operands with the mask, which compilers
+       * translate to a blend instruction where available.
+       */
+      template<class T, std::size_t S>
+      VectorExtSIMD<T,S> cond(ADLTag<5>, const VectorExtMask<T,S> &mask,
+                              const VectorExtSIMD<T,S> &ifTrue,
+                              const VectorExtSIMD<T,S> &ifFalse)
+      {
+        using V = typename VectorExtSIMD<T,S>::NativeType;
+        using M = typename VectorExtMask<T,S>::NativeType;
+        const M t = VectorExtImpl::bitCast<M>(ifTrue.native());
+        const M f = VectorExtImpl::bitCast<M>(ifFalse.native());
+        return VectorExtSIMD<T,S>(VectorExtImpl::bitCast<V>
+                                  ((t & mask.native()) |
+                                   (f & ~mask.native())));
+      }
+
+      //! implements Simd::cond()
+      template<class T, std::size_t S>
+      VectorExtMask<T,S> cond(ADLTag<5>, const VectorExtMask<T,S> &mask,
+                              const VectorExtMask<T,S> &ifTrue,
+                              const VectorExtMask<T,S> &ifFalse)
+      {
+        return VectorExtMask<T,S>((ifTrue.native() & mask.native()) |
+                                  (ifFalse.native() & ~mask.native()));
+      }
+
+      //! implements Simd::anyTrue()
+      template<class T, std::size_t S>
+      bool anyTrue(ADLTag<5>, const VectorExtMask<T,S> &mask)
+      {
+        bool out = false;
+        for(std::size_t i=0; i<S; i++) {
+          out |= mask.get(i);
+        }
+        return out;
+      }
+
+      //! implements Simd::allTrue()
+      template<class T, std::size_t S>
+      bool allTrue(ADLTag<5>, const VectorExtMask<T,S> &mask)
+      {
+        bool out = true;
+        for(std::size_t i=0; i<S; i++) {
+          out &= mask.get(i);
+        }
+        return out;
+      }
+
+      //! implements Simd::load()
+      template<class T, std::size_t S>
+      VectorExtSIMD<T,S> load(ADLTag<5>, MetaType<VectorExtSIMD<T,S> >,
+                              const T *p)
+      {
+        typename VectorExtSIMD<T,S>::NativeType v;
+        std::memcpy(&v, p, sizeof(v));
+        return VectorExtSIMD<T,S>(v);
+      }
+
+      //! implements Simd::loadAligned()
+      template<class T, std::size_t S>
+      VectorExtSIMD<T,S> loadAligned(ADLTag<5>,
+                                     MetaType<VectorExtSIMD<T,S> >,
+                                     const T *p)
+      {
+        using V = typename VectorExtSIMD<T,S>::NativeType;
+        return VectorExtSIMD<T,S>(*reinterpret_cast<const V*>(p));
+      }
+
+      //! implements Simd::store()
+      template<class T, std::size_t S>
+      void store(ADLTag<5>, const VectorExtSIMD<T,S> &v, T *p)
+      {
+        std::memcpy(p, &v.native(), sizeof(v.native()));
+      }
+
+      //! implements Simd::storeAligned()
+      template<class T, std::size_t S>
+      void storeAligned(ADLTag<5>, const VectorExtSIMD<T,S> &v, T *p)
+      {
+        using V = typename VectorExtSIMD<T,S>::NativeType;
+        *reinterpret_cast<V*>(p) = v.native();
+      }
+
+      //! @} Overloadable and default functions
+
+    } // namespace Overloads
+  } // namespace Simd
+
+  /*
+   *  Overloads the unary cmath-operations lane by lane, like for LoopSIMD.
+   *  Operations requiring or returning more than one argument are not
+   *  supported.  Cmath-operations on integral types are also not supported.
+   */
+
+#define DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN(expr, returnType)  \
+  template<class T, std::size_t S, typename Sfinae =                      \
+           typename std::enable_if_t<!std::is_integral<T>::value> >       \
+  auto expr(const VectorExtSIMD<T,S> &v) {                                \
+    using std::expr;                                                      \
+    VectorExtSIMD<returnType,S> out;                                      \
+    for(std::size_t i=0; i<S; i++) {                                      \
+      out[i] = expr(v[i]);                                                \
+    }                                                                     \
+    return out;                                                           \
+  }
+
+#define DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(expr)        \
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN(expr, T)
+
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(cos);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(sin);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(tan);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(acos);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(asin);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(atan);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(cosh);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(sinh);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(tanh);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(acosh);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(asinh);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(atanh);
+
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(exp);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(log);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(log10);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(exp2);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(expm1);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN(ilogb, int);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(log1p);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(log2);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(logb);
+
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(sqrt);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(cbrt);
+
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(erf);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(erfc);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(tgamma);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(lgamma);
+
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(ceil);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(floor);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(trunc);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(round);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN(lround, long);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN(llround, long long);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(rint);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN(lrint, long);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN(llrint, long long);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(nearbyint);
+
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(fabs);
+  DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP(abs);
+
+#undef DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP
+#undef DUNE_SIMD_VECTOREXT_CMATH_UNARY_OP_WITH_RETURN
+
+  /*
+   * Overloads specific functions usually provided by the std library
+   */
+
+  template<class T, std::size_t S>
+  VectorExtSIMD<T,S> real(const VectorExtSIMD<T,S> &v) {
+    return v;
+  }
+
+  template<class T, std::size_t S>
+  VectorExtSIMD<T,S> imag(const VectorExtSIMD<T,S> &) {
+    return VectorExtSIMD<T,S>(T(0));
+  }
+
+  // same semantics as std::max() and std::min(), including for NaN
+  template<class T, std::size_t S>
+  VectorExtSIMD<T,S> max(const VectorExtSIMD<T,S> &v,
+                         const VectorExtSIMD<T,S> &w) {
+    return Simd::cond(v < w, w, v);
+  }
+
+  template<class T, std::size_t S>
+  VectorExtSIMD<T,S> min(const VectorExtSIMD<T,S> &v,
+                         const VectorExtSIMD<T,S> &w) {
+    return Simd::cond(w < v, w, v);
+  }
+
+  namespace MathOverloads {
+    template<class T, std::size_t S>
+    auto isNaN(const VectorExtSIMD<T,S> &v, PriorityTag<3>, ADLTag) {
+      return v != v;
+    }
+
+    template<class T, std::size_t S>
+    auto isInf(const VectorExtSIMD<T,S> &v, PriorityTag<3>, ADLTag) {
+      VectorExtMask<T,S> out;
+      for(auto l : range(S))
+        out.set(l, Dune::isInf(v[l]));
+      return out;
+    }
+
+    template<class T, std::size_t S>
+    auto isFinite(const VectorExtSIMD<T,S> &v, PriorityTag<3>, ADLTag) {
+      VectorExtMask<T,S> out;
+      for(auto l : range(S))
+        out.set(l, Dune::isFinite(v[l]));
+      return out;
+    }
+  } //namespace MathOverloads
+
+  template<class T, std::size_t S>
+  struct IsNumber<VectorExtSIMD<T,S> > :
+    public std::integral_constant<bool, IsNumber<T>::value> {
+  };
+
+  //! Specialization of AutonomousValue for the lane proxies of VectorExtMask
+  template<class M>
+  struct AutonomousValueType<Simd::VectorExtImpl::MaskProxy<M> >
+  {
+    using type = bool;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_COMMON_SIMD_VECTOREXT_HH
@@ -383,7 +383,10 @@ namespace CheckMatrixInterface
       for( size_type i = size_type( 0 ); i < size; ++i )
       {
         row_reference row = matrix[ i ];
-        row = row_type( value_type( 0 ) );
+        row = value_type( 0 );
+        // the rows of a DynamicMatrix keep their size, row_type( value_type( 0 ) )
+        // would be an empty row for it
+        row = row_type( row );
       }
 
       const size_type rows = MatrixSizeHelper< Matrix >::rows( matrix );
@@ -402,7 +405,8 @@ namespace CheckMatrixInterface
       for( Iterator it = matrix.begin(); it != end; ++it )
       {
         row_reference row = *it;
-        row = row_type( value_type( 0 ) );
+        row = value_type( 0 );
+        row = row_type( row );
       }
     }
   };
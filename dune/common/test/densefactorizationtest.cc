@@ -0,0 +1,259 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+
+#include <dune/common/densefactorization.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/test/testsuite.hh>
+
+using namespace Dune;
+
+template<class MAT>
+void resizeMatrix (MAT&, std::size_t, std::size_t)
+{}
+
+template<class K>
+void resizeMatrix (DynamicMatrix<K>& A, std::size_t n, std::size_t m)
+{
+  A.resize(n, m);
+}
+
+template<class VEC>
+void resizeVector (VEC&, std::size_t)
+{}
+
+template<class K>
+void resizeVector (DynamicVector<K>& x, std::size_t n)
+{
+  x.resize(n);
+}
+
+// a nonsymmetric matrix that needs pivoting
+template<class MAT>
+void fillGeneral (MAT& A, std::size_t n)
+{
+  typedef typename MAT::field_type K;
+  resizeMatrix(A, n, n);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      A[i][j] = K(double((3*i + 7*j) % 11) - 5.0) / K(4);
+  for (std::size_t i = 0; i < n; ++i)
+    A[i][(i+1) % n] += K(n);
+}
+
+// a symmetric (hermitian) positive definite matrix
+template<class MAT>
+void fillSPD (MAT& A, std::size_t n)
+{
+  typedef typename MAT::field_type K;
+  resizeMatrix(A, n, n);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      A[i][j] = K(1.0 / double(1 + i + j));
+  for (std::size_t i = 0; i < n; ++i)
+    A[i][i] += K(1);
+}
+
+template<class MAT, class VEC>
+void checkFactorization (TestSuite& suite, const MAT& A, const char* name, double tol)
+{
+  typedef typename MAT::field_type K;
+  const std::size_t n = A.N();
+
+  VEC b, x;
+  resizeVector(b, n);
+  resizeVector(x, n);
+  for (std::size_t i = 0; i < n; ++i)
+    b[i] = K(double(i % 5) - 2.0);
+
+  // single right hand side
+  {
+    const K det = A.N() > 0 ? A.determinant() : K(1);
+
+    DenseLUFactorization<MAT> lu(A);
+    lu.solve(x, b);
+    VEC r(b);
+    A.mmv(x, r);
+    suite.check(r.infinity_norm() <= tol) << name << ": LU solve, size " << n;
+
+    using std::abs;
+    suite.check(abs(lu.determinant() - det) <= tol * abs(det)) << name << ": LU determinant, size " << n;
+
+    // solve in place
+    VEC y(b);
+    lu.solve(y, y);
+    y -= x;
+    suite.check(y.infinity_norm() <= tol) << name << ": LU solve in place, size " << n;
+
+    // inverse and multiple right hand sides
+    MAT inv, AB, X, B;
+    lu.inverse(inv);
+    AB = A;
+    AB.rightmultiply(inv);
+    for (std::size_t i = 0; i < n; ++i)
+      AB[i][i] -= K(1);
+    suite.check(AB.infinity_norm() <= tol) << name << ": LU inverse, size " << n;
+
+    B = A;
+    resizeMatrix(X, n, n);
+    lu.solve(X, B);
+    for (std::size_t i = 0; i < n; ++i)
+      X[i][i] -= K(1);
+    suite.check(X.infinity_norm() <= tol) << name << ": LU multiple right hand sides, size " << n;
+  }
+}
+
+template<class MAT, class VEC>
+void checkSPDFactorizations (TestSuite& suite, const MAT& A, const char* name, double tol)
+{
+  typedef typename MAT::field_type K;
+  const std::size_t n = A.N();
+  using std::abs;
+
+  VEC b, x;
+  resizeVector(b, n);
+  resizeVector(x, n);
+  for (std::size_t i = 0; i < n; ++i)
+    b[i] = K(double(i % 3) - 1.0);
+  const K det = DenseLUFactorization<MAT>(A).determinant();
+
+  // solving with the columns of A as right hand sides gives the identity
+  auto checkSolves = [&](const auto& f, const char* kind)
+  {
+    f.solve(x, b);
+    VEC r(b);
+    A.mmv(x, r);
+    suite.check(r.infinity_norm() <= tol) << name << ": " << kind << " solve, size " << n;
+
+    suite.check(abs(f.determinant() - det) <= tol * abs(det)) << name << ": " << kind << " determinant, size " << n;
+
+    MAT X, inv, P;
+    resizeMatrix(X, n, n);
+    resizeMatrix(P, n, n);
+    f.solve(X, A);
+    f.inverse(inv);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      X[i][i] -= K(1);
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        P[i][j] = (i == j) ? K(-1) : K(0);
+        for (std::size_t k = 0; k < n; ++k)
+          P[i][j] += A[i][k]*inv[k][j];
+      }
+    }
+    suite.check(X.infinity_norm() <= tol) << name << ": " << kind << " multiple right hand sides, size " << n;
+    suite.check(P.infinity_norm() <= tol) << name << ": " << kind << " inverse, size " << n;
+  };
+
+  checkSolves(DenseCholeskyFactorization<MAT>(A), "Cholesky");
+  checkSolves(DenseLDLTFactorization<MAT>(A), "LDLT");
+}
+
+template<class K, int n>
+void checkFieldMatrix (TestSuite& suite, double tol)
+{
+  typedef FieldMatrix<K,n,n> MAT;
+  MAT A;
+  fillGeneral(A, n);
+  checkFactorization<MAT, FieldVector<K,n> >(suite, A, "FieldMatrix", tol);
+  fillSPD(A, n);
+  checkSPDFactorizations<MAT, FieldVector<K,n> >(suite, A, "FieldMatrix", tol);
+}
+
+template<class K>
+void checkDynamicMatrix (TestSuite& suite, double tol)
+{
+  typedef DynamicMatrix<K> MAT;
+  // sizes below, at and above the panel width
+  for (std::size_t n : {1, 2, 7, 31, 32, 33, 70, 100})
+  {
+    MAT A;
+    fillGeneral(A, n);
+    checkFactorization<MAT, DynamicVector<K> >(suite, A, "DynamicMatrix", tol);
+    fillSPD(A, n);
+    checkSPDFactorizations<MAT, DynamicVector<K> >(suite, A, "DynamicMatrix", tol);
+  }
+}
+
+template<class F>
+bool throwsFMatrixError (F&& f)
+{
+  try {
+    f();
+  }
+  catch (const FMatrixError&) {
+    return true;
+  }
+  return false;
+}
+
+void checkReuseAndErrors (TestSuite& suite)
+{
+  // the same object for matrices of different sizes
+  DenseLUFactorization<DynamicMatrix<double> > lu;
+  DenseCholeskyFactorization<DynamicMatrix<double> > chol;
+  for (std::size_t n : {40, 3, 40})
+  {
+    DynamicMatrix<double> A;
+    fillSPD(A, n);
+    lu.factorize(A);
+    chol.factorize(A);
+    suite.check(lu.N() == n && chol.N() == n) << "factorizations have wrong size";
+    suite.check(std::abs(lu.determinant() - chol.determinant()) <= 1e-12 * std::abs(lu.determinant()))
+      << "LU and Cholesky determinants differ for size " << n;
+  }
+
+  // an indefinite matrix: Cholesky fails, LDLT works
+  FieldMatrix<double,2,2> indefinite = {{1, 2}, {2, 1}};
+  suite.check(throwsFMatrixError([&]{ DenseCholeskyFactorization<FieldMatrix<double,2,2> > c(indefinite); }))
+    << "Cholesky factorization of an indefinite matrix does not throw";
+  DenseLDLTFactorization<FieldMatrix<double,2,2> > ldlt(indefinite);
+  suite.check(std::abs(ldlt.determinant() + 3) < 1e-14) << "LDLT determinant of indefinite matrix";
+
+  // singular matrices
+  FieldMatrix<double,3,3> singular = {{1, 2, 3}, {2, 4, 6}, {0, 1, 1}};
+  suite.check(throwsFMatrixError([&]{ DenseLUFactorization<FieldMatrix<double,3,3> > l(singular); }))
+    << "LU factorization of a singular matrix does not throw";
+
+  // pivots below FMatrixPrecision<>::absolute_limit(), the threshold of
+  // DenseMatrix::solve(), count as singular
+  FieldMatrix<double,2,2> nearlySingular = {{1, 0}, {0, 1e-90}};
+  suite.check(throwsFMatrixError([&]{ DenseLUFactorization<FieldMatrix<double,2,2> > l(nearlySingular); }))
+    << "LU factorization of a nearly singular matrix does not throw";
+  suite.check(throwsFMatrixError([&]{ DenseLDLTFactorization<FieldMatrix<double,2,2> > l(nearlySingular); }))
+    << "LDLT factorization of a nearly singular matrix does not throw";
+
+  DynamicMatrix<double> rectangular(2, 3, 1.0);
+  suite.check(throwsFMatrixError([&]{ lu.factorize(rectangular); }))
+    << "LU factorization of a rectangular matrix does not throw";
+}
+
+int main()
+{
+  TestSuite suite;
+
+  checkFieldMatrix<double, 1>(suite, 1e-12);
+  checkFieldMatrix<double, 2>(suite, 1e-12);
+  checkFieldMatrix<double, 3>(suite, 1e-12);
+  checkFieldMatrix<double, 5>(suite, 1e-12);
+  checkFieldMatrix<double, 9>(suite, 1e-12);
+  checkFieldMatrix<float, 4>(suite, 1e-4);
+  checkFieldMatrix<std::complex<double>, 4>(suite, 1e-12);
+
+  checkDynamicMatrix<double>(suite, 1e-10);
+  checkDynamicMatrix<std::complex<double> >(suite, 1e-10);
+
+  checkReuseAndErrors(suite);
+
+  return suite.exit();
+}
@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <complex>
 #include <vector>
 
 #include "checkmatrixinterface.hh"
@@ -387,6 +388,174 @@ int test_determinant()
   return 0;
 }
 
+int test_storage()
+{
+  int ret = 0;
+
+  DynamicMatrix<double> A = {{1, 2, 3}, {4, 5, 6}};
+
+  // the entries are stored row-wise in one contiguous buffer
+  for (std::size_t i=0; i<A.N(); ++i)
+    for (std::size_t j=0; j<A.M(); ++j)
+      if (&A[i][j] != A.data() + i*A.leadingDimension() + j)
+      {
+        std::cerr << "Entry (" << i << "," << j << ") is not stored contiguously" << std::endl;
+        ++ret;
+      }
+
+  // copies do not share their storage
+  DynamicMatrix<double> B = A;
+  B[0][0] = 10;
+  if (A[0][0] != 1 || B.data() == A.data())
+  {
+    std::cerr << "Copy of a DynamicMatrix shares storage with the original" << std::endl;
+    ++ret;
+  }
+
+  // assigning and swapping rows copies the entries
+  B[1] = A[0];
+  using std::swap;
+  swap(B[0], B[1]);
+  if (B[0][0] != 1 || B[1][0] != 10 || A[0][0] != 1)
+  {
+    std::cerr << "Row assignment or swap failed" << std::endl;
+    ++ret;
+  }
+
+  // copies of rows and sums of rows are independent of the matrix
+  auto row = A[1];
+  row[0] = 20;
+  auto sum = A[0] + A[1];
+  if (A[1][0] != 4 || A[0][0] != 1 || sum[0] != 5 || row.data() == A[1].data())
+  {
+    std::cerr << "Copy or sum of rows aliases the matrix" << std::endl;
+    ++ret;
+  }
+  DynamicMatrix<double>::row_type filled(3, 2.0);
+  A[0] = filled;
+  if (A[0][2] != 2.0 || filled.size() != 3)
+  {
+    std::cerr << "Assignment of an independent row failed" << std::endl;
+    ++ret;
+  }
+  try
+  {
+    A[0] = DynamicMatrix<double>::row_type(2);
+    std::cerr << "Assignment of a row of a different size did not throw" << std::endl;
+    ++ret;
+  }
+  catch (const Dune::RangeError&)
+  {}
+
+  // std::swap moves rows, which must not alias the matrix
+  DynamicMatrix<double> S = {{1, 2}, {3, 4}};
+  std::swap(S[0], S[1]);
+  if (S[0][0] != 3 || S[0][1] != 4 || S[1][0] != 1 || S[1][1] != 2)
+  {
+    std::cerr << "std::swap of rows failed: " << S << std::endl;
+    ++ret;
+  }
+  auto moved = std::move(S[0]);
+  moved[0] = 5;
+  if (S[0][0] != 3)
+  {
+    std::cerr << "Moving a row aliases the matrix" << std::endl;
+    ++ret;
+  }
+
+  // moving takes over the storage
+  const double* data = B.data();
+  DynamicMatrix<double> C = std::move(B);
+  if (C.data() != data || C[1][0] != 10)
+  {
+    std::cerr << "Move construction did not take over the storage" << std::endl;
+    ++ret;
+  }
+
+  // shrinking does not reallocate
+  C.resize(2, 1, 7.0);
+  if (C.data() != data || C.N() != 2 || C.M() != 1 || C[1][0] != 7.0)
+  {
+    std::cerr << "Shrinking resize reallocated or produced wrong entries" << std::endl;
+    ++ret;
+  }
+
+  return ret;
+}
+
+template<class K>
+int test_multiply(std::size_t m, std::size_t k, std::size_t n)
+{
+  int ret = 0;
+
+  DynamicMatrix<K> A(m, k), B(k, n), C(m, n), R(m, n, K(0));
+  for (std::size_t i=0; i<m; ++i)
+    for (std::size_t j=0; j<k; ++j)
+      A[i][j] = K((i*7 + j*3) % 11) - K(5);
+  for (std::size_t i=0; i<k; ++i)
+    for (std::size_t j=0; j<n; ++j)
+      B[i][j] = K((i*5 + j*2) % 13) - K(6);
+
+  // reference product
+  for (std::size_t i=0; i<m; ++i)
+    for (std::size_t j=0; j<n; ++j)
+      for (std::size_t l=0; l<k; ++l)
+        R[i][j] += A[i][l]*B[l][j];
+
+  DenseMatrixHelp::multMatrix(A, B, C);
+  C -= R;
+  if (C.infinity_norm() > 1e-4 * (1 + R.infinity_norm()))
+  {
+    std::cerr << "multMatrix failed for a " << m << "x" << k << " times "
+              << k << "x" << n << " product" << std::endl;
+    ++ret;
+  }
+
+  if (k == n)
+  {
+    DynamicMatrix<K> D = A;
+    D.rightmultiply(B);
+    D -= R;
+    if (D.infinity_norm() > 1e-4 * (1 + R.infinity_norm()))
+    {
+      std::cerr << "rightmultiply failed for size " << m << "x" << k << std::endl;
+      ++ret;
+    }
+  }
+
+  if (m == k)
+  {
+    DynamicMatrix<K> D = B;
+    D.leftmultiply(A);
+    D -= R;
+    if (D.infinity_norm() > 1e-4 * (1 + R.infinity_norm()))
+    {
+      std::cerr << "leftmultiply failed for size " << k << "x" << n << std::endl;
+      ++ret;
+    }
+  }
+
+  return ret;
+}
+
+int test_multiply()
+{
+  int ret = 0;
+  // sizes below, around and above the blocking parameters
+  for (std::size_t s : {1, 3, 17, 33, 70, 130})
+  {
+    ret += test_multiply<double>(s, s, s);
+    ret += test_multiply<float>(s, s, s);
+    ret += test_multiply<int>(s, s, s);
+  }
+  ret += test_multiply<double>(5, 300, 7);
+  ret += test_multiply<double>(67, 29, 41);
+  ret += test_multiply<std::complex<double>>(35, 19, 21);
+  ret += test_multiply<int>(1100, 3, 5);
+  ret += test_multiply<int>(3, 2, 1100);
+  return ret;
+}
+
 int main()
 {
   try {
@@ -401,7 +570,7 @@ int main()
     Dune::DynamicMatrix<double> B(34, 34, 1e-15);
     for (int i=0; i<34; i++) B[i][i] = 1;
     B.invert();
-    return test_invert_solve();
+    return test_invert_solve() + test_storage() + test_multiply();
   }
   catch (Dune::Exception & e)
   {
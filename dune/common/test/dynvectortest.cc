@@ -6,8 +6,12 @@
 
 #include <iostream>
 
+#include <type_traits>
+
+#include <dune/common/dynmatrix.hh>
 #include <dune/common/dynvector.hh>
 #include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
 #include <dune/common/unused.hh>
 
 using Dune::DynamicVector;
@@ -62,6 +66,138 @@ void dynamicVectorTest(int d) {
 
 }
 
+template<class ct>
+void expressionTest(int d) {
+  DynamicVector<ct> x(d), y(d), z(d), r(d);
+  for (int i=0; i<d; i++)
+  {
+    x[i] = ct(i+1);
+    y[i] = ct(2*i);
+    z[i] = ct(3-i);
+  }
+
+  // fused evaluation of an expression with several operators
+  r = x + ct(2)*y - z/ct(1) + (-x);
+  for (int i=0; i<d; i++)
+    if (r[i] != ct(2)*y[i] - z[i])
+      DUNE_THROW(Dune::Exception, "wrong result of x + 2*y - z - x");
+
+  // construction and assignment resize the vector
+  DynamicVector<ct> s = x - y*ct(3);
+  DynamicVector<ct> t;
+  t = ct(2) * (x + y);
+  if (int(s.size()) != d || int(t.size()) != d)
+    DUNE_THROW(Dune::Exception, "expression result has wrong size");
+  for (int i=0; i<d; i++)
+    if (s[i] != x[i] - ct(3)*y[i] || t[i] != ct(2)*(x[i] + y[i]))
+      DUNE_THROW(Dune::Exception, "wrong result of evaluated expression");
+
+  // the assigned vector may appear in the expression
+  DynamicVector<ct> a(x);
+  a = y - a + a*ct(2);
+  a -= x + y;
+  for (int i=0; i<d; i++)
+    if (a[i] != ct(0))
+      DUNE_THROW(Dune::Exception, "expression with aliasing gives wrong result");
+  a = x;
+  a += a + a;
+  for (int i=0; i<d; i++)
+    if (a[i] != ct(3)*x[i])
+      DUNE_THROW(Dune::Exception, "aliased += gives wrong result");
+
+  // norms and dot products of expressions agree with those of the result
+  const DynamicVector<ct> e = x - z;
+  if ((x - z).two_norm2() != e.two_norm2()
+      || (x - z).one_norm() != e.one_norm()
+      || (x - z).infinity_norm() != e.infinity_norm()
+      || (x - z) * y != e * y
+      || y * (x - z) != y * e
+      || (x - z).dot(x + z) != e.dot(x + z))
+    DUNE_THROW(Dune::Exception, "norm of expression differs from norm of vector");
+
+  // arithmetic of matrix rows does not modify the matrix
+  Dune::DynamicMatrix<ct> m(2, d, ct(1));
+  DynamicVector<ct> row = m[0] + m[1];
+  row = m[0] - x;
+  for (int i=0; i<d; i++)
+    if (m[0][i] != ct(1) || row[i] != ct(1) - x[i])
+      DUNE_THROW(Dune::Exception, "arithmetic of matrix rows is wrong");
+
+  // FieldVector arithmetic still returns vectors
+  Dune::FieldVector<ct,3> f(1), g(2);
+  static_assert(std::is_same<decltype(f + g), Dune::FieldVector<ct,3> >::value,
+                "sum of FieldVectors has to be a FieldVector");
+  static_assert(std::is_same<decltype(f - g), Dune::FieldVector<ct,3> >::value,
+                "difference of FieldVectors has to be a FieldVector");
+  f = f + g;
+  if (f[0] != ct(3))
+    DUNE_THROW(Dune::Exception, "wrong sum of FieldVectors");
+}
+
+template<class ct>
+void reductionTest() {
+  using std::abs;
+  const ct eps = std::numeric_limits<ct>::epsilon();
+
+  for (int d : {0, 1, 3, 7, 8, 9, 15, 16, 17, 40, 1001})
+  {
+    DynamicVector<ct> x(d), y(d);
+    long double one = 0, two = 0, dot = 0, inf = 0;
+    for (int i=0; i<d; i++)
+    {
+      x[i] = ct((i*7) % 13) / ct(3) - ct(2);
+      y[i] = ct((i*5) % 11) / ct(7) + ct(1);
+      one += abs((long double)x[i]);
+      two += (long double)x[i] * x[i];
+      dot += (long double)x[i] * y[i];
+      inf = std::max(inf, abs((long double)x[i]));
+    }
+    const ct tol = ct(4*(d+1)) * eps;
+    if (abs(x.one_norm() - ct(one)) > tol * ct(one)
+        || abs(x.one_norm_real() - ct(one)) > tol * ct(one)
+        || abs(x.two_norm2() - ct(two)) > tol * ct(two)
+        || abs(x.two_norm() - ct(std::sqrt(two))) > tol * ct(std::sqrt(two))
+        || x.infinity_norm() != ct(inf) || x.infinity_norm_real() != ct(inf)
+        || abs(x * y - ct(dot)) > tol * ct(one) * ct(3)
+        || abs(x.dot(y) - ct(dot)) > tol * ct(one) * ct(3))
+      DUNE_THROW(Dune::Exception, "wrong norm or dot product for size " << d);
+
+    // the result does not depend on the alignment of the data: the rows of
+    // a matrix with an odd number of columns start at different offsets
+    Dune::DynamicMatrix<ct> m(3, d);
+    for (int r=0; r<3; r++)
+      m[r] = x;
+    for (int r=0; r<3; r++)
+      if (m[r].two_norm2() != x.two_norm2() || m[r] * y != x * y
+          || m[r].one_norm() != x.one_norm())
+        DUNE_THROW(Dune::Exception, "reduction depends on the alignment of the data");
+  }
+
+  // two_norm neither overflows nor underflows
+  const ct huge = std::numeric_limits<ct>::max() / ct(4);
+  const ct tiny = std::numeric_limits<ct>::min() * ct(4);
+  DynamicVector<ct> big(10, huge), small(10, tiny);
+  big[3] = -huge;
+  if (abs(big.two_norm() - huge * std::sqrt(ct(10))) > ct(8) * eps * huge * std::sqrt(ct(10)))
+    DUNE_THROW(Dune::Exception, "two_norm overflows");
+  if (abs(small.two_norm() - tiny * std::sqrt(ct(10))) > ct(8) * eps * tiny * std::sqrt(ct(10)))
+    DUNE_THROW(Dune::Exception, "two_norm underflows");
+  DynamicVector<ct> zero(20, ct(0));
+  if (zero.two_norm() != ct(0) || zero.infinity_norm() != ct(0))
+    DUNE_THROW(Dune::Exception, "norm of zero vector is not zero");
+
+  // infinite and NaN entries propagate
+  DynamicVector<ct> special(20, ct(1));
+  special[13] = std::numeric_limits<ct>::infinity();
+  if (special.two_norm() != std::numeric_limits<ct>::infinity()
+      || special.infinity_norm() != std::numeric_limits<ct>::infinity())
+    DUNE_THROW(Dune::Exception, "infinite entry not propagated");
+  special[5] = std::numeric_limits<ct>::quiet_NaN();
+  if (!std::isnan(special.two_norm()) || !std::isnan(special.infinity_norm())
+      || !std::isnan(special.one_norm()))
+    DUNE_THROW(Dune::Exception, "NaN entry not propagated");
+}
+
 int main()
 {
   try {
@@ -70,7 +206,11 @@ int main()
       dynamicVectorTest<int>(d);
       dynamicVectorTest<float>(d);
       dynamicVectorTest<double>(d);
+      expressionTest<int>(d);
+      expressionTest<double>(d);
     }
+    reductionTest<float>();
+    reductionTest<double>();
   } catch (Dune::Exception& e) {
     std::cerr << e << std::endl;
     return 1;
@@ -8,9 +8,14 @@
 #include <dune/common/fmatrix.hh>
 #include <dune/common/dynmatrixev.hh>
 #include <dune/common/fmatrixev.hh>
+#include <dune/common/simd/loop.hh>
+#if HAVE_QUADMATH
+#include <dune/common/quadmath.hh>
+#endif
 
 #include <algorithm>
 #include <complex>
+#include <limits>
 
 using namespace Dune;
 
@@ -82,6 +87,96 @@ void testRosserMatrix()
   }
 
   std::cout << "Eigenvalues of Rosser matrix: " << eigenComplex << std::endl;
+
+  // the reusable solvers have to produce the same eigenvalues, also
+  // when they are called repeatedly and with varying sizes
+  DynamicMatrixHelp::SymmetricEigenSolver symSolver;
+  DynamicMatrixHelp::NonSymmetricEigenSolver nonSymSolver;
+  for (int repeat=0; repeat<2; repeat++)
+  {
+    DynamicVector<double> eigenValues;
+    DynamicMatrix<double> eigenVectors;
+    symSolver.eigenValuesVectors(A, eigenValues, eigenVectors);
+    if (eigenValues.size() != 8 || eigenVectors.N() != 8 || eigenVectors.M() != 8)
+      DUNE_THROW(MathError, "SymmetricEigenSolver returned wrong sizes");
+    for (int i=0; i<8; i++)
+    {
+      if( std::fabs(reference[i] - eigenValues[i]) > 1e-10 )
+        DUNE_THROW(MathError, "SymmetricEigenSolver: error computing eigenvalues");
+      DynamicVector<double> Av(8);
+      A.mv(eigenVectors[i], Av);
+      Av.axpy(-eigenValues[i], eigenVectors[i]);
+      if (Av.infinity_norm() > 1e-9 || std::fabs(eigenVectors[i].two_norm() - 1) > 1e-12)
+        DUNE_THROW(MathError, "SymmetricEigenSolver: error computing eigenvectors");
+    }
+
+    // eigenvalues in (999, 1020] and the second to fourth eigenvalue
+    symSolver.eigenValuesVectorsInInterval(A, 999, 1020, eigenValues, eigenVectors);
+    if (eigenValues.size() != 4 || eigenVectors.N() != 4)
+      DUNE_THROW(MathError, "SymmetricEigenSolver: wrong number of eigenvalues in interval");
+    for (int i=0; i<4; i++)
+      if( std::fabs(reference[i+3] - eigenValues[i]) > 1e-10 )
+        DUNE_THROW(MathError, "SymmetricEigenSolver: error computing eigenvalues in interval");
+    symSolver.eigenValuesByIndex(A, 1, 4, eigenValues);
+    if (eigenValues.size() != 3)
+      DUNE_THROW(MathError, "SymmetricEigenSolver: wrong number of eigenvalues in index range");
+    for (int i=0; i<3; i++)
+      if( std::fabs(reference[i+1] - eigenValues[i]) > 1e-10 )
+        DUNE_THROW(MathError, "SymmetricEigenSolver: error computing eigenvalues in index range");
+
+    // a smaller matrix in between
+    DynamicMatrix<double> B = { { 2, 1 }, { 1, 2 } };
+    symSolver.eigenValues(B, eigenValues);
+    if (eigenValues.size() != 2 || std::fabs(eigenValues[0] - 1) > 1e-14 || std::fabs(eigenValues[1] - 3) > 1e-14)
+      DUNE_THROW(MathError, "SymmetricEigenSolver: error computing eigenvalues of 2x2 matrix");
+
+    DynamicVector<std::complex<double> > complexValues;
+    nonSymSolver.eigenValues(A, complexValues);
+    std::vector<double> realParts(8);
+    for (int i=0; i<8; i++)
+      realParts[i] = std::real(complexValues[i]);
+    std::sort(realParts.begin(), realParts.end());
+    for (int i=0; i<8; i++)
+      if( std::fabs(reference[i] - realParts[i]) > 1e-10 )
+        DUNE_THROW(MathError, "NonSymmetricEigenSolver: error computing eigenvalues");
+  }
+}
+
+/** \brief Test the right eigenvectors computed by NonSymmetricEigenSolver
+
+   The matrix has the real eigenvalue 2 and the complex pair 1 +- 2i.
+ */
+void testNonSymmetricEigenVectors()
+{
+  DynamicMatrix<double> A = {
+    { 1, -2, 0.5 },
+    { 2,  1, 0.25 },
+    { 0,  0, 2 }
+  };
+
+  DynamicMatrixHelp::NonSymmetricEigenSolver solver;
+  DynamicVector<std::complex<double> > eigenValues;
+  DynamicMatrix<std::complex<double> > eigenVectors;
+  solver.eigenValuesVectors(A, eigenValues, eigenVectors);
+
+  if (eigenValues.size() != 3 || eigenVectors.N() != 3 || eigenVectors.M() != 3)
+    DUNE_THROW(MathError, "NonSymmetricEigenSolver returned wrong sizes");
+  for (int i=0; i<3; i++)
+  {
+    if (std::abs(eigenValues[i] - std::complex<double>(2, 0)) > 1e-12
+        && std::abs(eigenValues[i] - std::complex<double>(1, 2)) > 1e-12
+        && std::abs(eigenValues[i] - std::complex<double>(1, -2)) > 1e-12)
+      DUNE_THROW(MathError, "NonSymmetricEigenSolver: error computing eigenvalues");
+
+    for (int j=0; j<3; j++)
+    {
+      std::complex<double> Av = -eigenValues[i] * eigenVectors[i][j];
+      for (int k=0; k<3; k++)
+        Av += A[j][k] * eigenVectors[i][k];
+      if (std::abs(Av) > 1e-12)
+        DUNE_THROW(MathError, "NonSymmetricEigenSolver: error computing eigenvectors");
+    }
+  }
 }
 #endif // HAVE_LAPACK
 
@@ -119,17 +214,151 @@ void testSymmetricFieldMatrix()
   }
 }
 
+/** \brief Check eigenvalues and eigenvectors computed by FMatrixHelp::eigenValuesVectors
+
+   Checks A v_i = lambda_i v_i, orthonormality of the eigenvectors, and the
+   ordering of the eigenvalues, relative to the largest entry of A.
+ */
+template <class field_type, int dim>
+void checkEigenValuesVectors(const FieldMatrix<field_type,dim,dim>& testMatrix)
+{
+  using std::abs;
+  using std::max;
+  const field_type tol = 64 * dim * std::numeric_limits<field_type>::epsilon();
+
+  FieldVector<field_type,dim> eigenValues;
+  FieldMatrix<field_type,dim,dim> eigenVectors;
+  FMatrixHelp::eigenValuesVectors(testMatrix, eigenValues, eigenVectors);
+
+  field_type scale = 0;
+  for (int j=0; j<dim; j++)
+    for (int k=0; k<dim; k++)
+      scale = max(scale, abs(testMatrix[j][k]));
+
+  for (int j=0; j<dim; j++)
+  {
+    FieldVector<field_type,dim> Av;
+    testMatrix.mv(eigenVectors[j], Av);
+    Av.axpy(-eigenValues[j], eigenVectors[j]);
+    if (Av.infinity_norm() > tol * max(scale, field_type(1)))
+      DUNE_THROW(MathError, "Vector computed by FMatrixHelp::eigenValuesVectors is not an eigenvector");
+
+    for (int k=0; k<dim; k++)
+      if (abs(eigenVectors[j] * eigenVectors[k] - field_type(j == k)) > tol)
+        DUNE_THROW(MathError, "Eigenvectors computed by FMatrixHelp::eigenValuesVectors are not orthonormal");
+
+    if (j < dim-1 && eigenValues[j] > eigenValues[j+1])
+      DUNE_THROW(MathError, "Values computed by FMatrixHelp::eigenValuesVectors are not in ascending order");
+  }
+
+  // the eigenvalue-only interface has to agree
+  FieldVector<field_type,dim> reference;
+  FMatrixHelp::eigenValues(testMatrix, reference);
+  reference -= eigenValues;
+  if (reference.infinity_norm() > tol * max(scale, field_type(1)))
+    DUNE_THROW(MathError, "FMatrixHelp::eigenValues and FMatrixHelp::eigenValuesVectors disagree");
+}
+
+template <class field_type, int dim>
+void testEigenValuesVectors()
+{
+  // pseudo-random symmetric matrices
+  for (int i=0; i<10; i++)
+  {
+    FieldMatrix<field_type,dim,dim> testMatrix;
+    for (int j=0; j<dim; j++)
+      for (int k=j; k<dim; k++)
+        testMatrix[j][k] = testMatrix[k][j] = ((int)(M_PI*(j+1)*(k+2)*i))%100 - 1;
+    checkEigenValuesVectors(testMatrix);
+  }
+
+  // zero, identity, diagonal, and matrices with repeated eigenvalues
+  FieldMatrix<field_type,dim,dim> zero(0), identity(0), diagonal(0), repeated(1);
+  for (int j=0; j<dim; j++)
+  {
+    identity[j][j] = 1;
+    diagonal[j][j] = dim - 2*j;
+    repeated[j][j] += 2;
+  }
+  checkEigenValuesVectors(zero);
+  checkEigenValuesVectors(identity);
+  checkEigenValuesVectors(diagonal);
+  checkEigenValuesVectors(repeated);
+
+  // badly scaled entries
+  FieldMatrix<field_type,dim,dim> scaled = repeated;
+  scaled[0][dim-1] = scaled[dim-1][0] = 1e-3;
+  scaled *= field_type(1e10);
+  checkEigenValuesVectors(scaled);
+}
+
+/** \brief Check that eigenValuesVectors works lane-wise for SIMD field types */
+template <int dim>
+void testSimdEigenValuesVectors()
+{
+  typedef LoopSIMD<double,4> V;
+  FieldMatrix<double,dim,dim> matrices[4];
+  FieldMatrix<V,dim,dim> simdMatrix;
+  for (int l=0; l<4; l++)
+    for (int j=0; j<dim; j++)
+      for (int k=j; k<dim; k++)
+      {
+        // lane 0 is diagonal, lane 1 a multiple of the identity
+        double value = (l == 0 || l == 1) ? 0 : ((int)(M_PI*(j+l)*(k+2)))%10 - 1;
+        if (j == k)
+          value += (l == 1) ? 3 : j+1;
+        matrices[l][j][k] = matrices[l][k][j] = value;
+        Simd::lane(l, simdMatrix[j][k]) = Simd::lane(l, simdMatrix[k][j]) = value;
+      }
+
+  FieldVector<V,dim> simdValues;
+  FieldMatrix<V,dim,dim> simdVectors;
+  FMatrixHelp::eigenValuesVectors(simdMatrix, simdValues, simdVectors);
+
+  for (int l=0; l<4; l++)
+  {
+    FieldVector<double,dim> eigenValues;
+    FieldMatrix<double,dim,dim> eigenVectors;
+    FMatrixHelp::eigenValuesVectors(matrices[l], eigenValues, eigenVectors);
+    for (int j=0; j<dim; j++)
+    {
+      if (std::abs(Simd::lane(l, simdValues[j]) - eigenValues[j]) > 1e-12)
+        DUNE_THROW(MathError, "SIMD eigenvalues differ from scalar ones");
+      for (int k=0; k<dim; k++)
+        if (std::abs(Simd::lane(l, simdVectors[j][k]) - eigenVectors[j][k]) > 1e-12)
+          DUNE_THROW(MathError, "SIMD eigenvectors differ from scalar ones");
+    }
+  }
+}
+
 int main() try
 {
 #if HAVE_LAPACK
   testRosserMatrix<double>();
+  testNonSymmetricEigenVectors();
 #else
-  std::cout << "WARNING: eigenvaluetest needs LAPACK, test disabled" << std::endl;
+  std::cout << "WARNING: Rosser matrix test needs LAPACK, test disabled" << std::endl;
 #endif // HAVE_LAPACK
 
   testSymmetricFieldMatrix<double,2>();
   testSymmetricFieldMatrix<double,3>();
 
+  testEigenValuesVectors<double,1>();
+  testEigenValuesVectors<double,2>();
+  testEigenValuesVectors<double,3>();
+  testEigenValuesVectors<double,4>();
+  testEigenValuesVectors<double,7>();
+  testEigenValuesVectors<float,3>();
+  testEigenValuesVectors<float,5>();
+#if HAVE_QUADMATH
+  testEigenValuesVectors<Float128,3>();
+  testEigenValuesVectors<Float128,5>();
+#endif
+
+  testSimdEigenValuesVectors<2>();
+  testSimdEigenValuesVectors<3>();
+  testSimdEigenValuesVectors<5>();
+
   return 0;
 } catch (Exception exception)
 {
@@ -0,0 +1,123 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fmatrixbatch.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/simd/loop.hh>
+#include <dune/common/test/testsuite.hh>
+
+using namespace Dune;
+
+// a well-conditioned matrix that differs for every k
+template<class K, int N>
+FieldMatrix<K,N,N> testMatrix (std::size_t k)
+{
+  FieldMatrix<K,N,N> A;
+  for (int i = 0; i < N; ++i)
+    for (int j = 0; j < N; ++j)
+      A[i][j] = (i == j) ? K(N + 1 + k % 3) : K(((i + 2*j + k) % 5)) / K(5);
+  return A;
+}
+
+template<class K, int N>
+FieldVector<K,N> testVector (std::size_t k)
+{
+  FieldVector<K,N> x;
+  for (int i = 0; i < N; ++i)
+    x[i] = K((i + k) % 7) - K(3);
+  return x;
+}
+
+template<class V, class K, int N>
+void checkBatch (TestSuite& suite, std::size_t count, K tol)
+{
+  std::vector<FieldMatrix<K,N,N> > A(count);
+  std::vector<FieldVector<K,N> > x(count), y(count), z(count);
+  for (std::size_t k = 0; k < count; ++k)
+  {
+    A[k] = testMatrix<K,N>(k);
+    x[k] = testVector<K,N>(k);
+    z[k] = testVector<K,N>(k+1);
+  }
+
+  // mv and umv
+  FMatrixBatch::mv<V>(A.data(), x.data(), y.data(), count);
+  FMatrixBatch::umv<V>(A.data(), x.data(), z.data(), count);
+  for (std::size_t k = 0; k < count; ++k)
+  {
+    FieldVector<K,N> ref;
+    A[k].mv(x[k], ref);
+    suite.check((ref - y[k]).infinity_norm() <= tol)
+      << "mv differs for matrix " << k << " of " << count;
+    ref += testVector<K,N>(k+1);
+    suite.check((ref - z[k]).infinity_norm() <= tol)
+      << "umv differs for matrix " << k << " of " << count;
+  }
+
+  // determinant
+  std::vector<K> det(count);
+  FMatrixBatch::determinant<V>(A.data(), det.data(), count);
+  for (std::size_t k = 0; k < count; ++k)
+  {
+    using std::abs;
+    const K ref = A[k].determinant();
+    suite.check(abs(ref - det[k]) <= tol * abs(ref))
+      << "determinant differs for matrix " << k << " of " << count;
+  }
+
+  // solve
+  FMatrixBatch::solve<V>(A.data(), y.data(), x.data(), count);
+  for (std::size_t k = 0; k < count; ++k)
+  {
+    FieldVector<K,N> ref;
+    A[k].solve(ref, x[k]);
+    suite.check((ref - y[k]).infinity_norm() <= tol)
+      << "solve differs for matrix " << k << " of " << count;
+  }
+
+  // invert
+  std::vector<FieldMatrix<K,N,N> > inv(A);
+  FMatrixBatch::invert<V>(inv.data(), count);
+  for (std::size_t k = 0; k < count; ++k)
+  {
+    FieldMatrix<K,N,N> ref = A[k];
+    ref.invert();
+    ref -= inv[k];
+    suite.check(ref.infinity_norm() <= tol)
+      << "invert differs for matrix " << k << " of " << count;
+  }
+}
+
+template<class V, class K>
+void checkSizes (TestSuite& suite, K tol)
+{
+  // batches that fill no, one, and several SIMD vectors, with and without tail
+  for (std::size_t count : {0, 1, 3, 4, 9, 16})
+  {
+    checkBatch<V, K, 1>(suite, count, tol);
+    checkBatch<V, K, 2>(suite, count, tol);
+    checkBatch<V, K, 3>(suite, count, tol);
+    checkBatch<V, K, 4>(suite, count, tol);
+    checkBatch<V, K, 6>(suite, count, tol);
+  }
+}
+
+int main()
+{
+  TestSuite suite;
+
+  checkSizes<void, double>(suite, 1e-12);
+  checkSizes<void, float>(suite, 1e-4f);
+  checkSizes<LoopSIMD<double, 8>, double>(suite, 1e-12);
+  checkSizes<LoopSIMD<double, 1>, double>(suite, 1e-12);
+
+  return suite.exit();
+}
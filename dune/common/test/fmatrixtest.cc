@@ -738,6 +738,50 @@ void test_interface()
   checkMatrixInterface< FMatrix, Traits >( m );
 }
 
+// products of at least 16x16x16 entries go through the cache-blocked kernel
+template< class K, int rows, int inner, int cols >
+int test_blocked_multiply()
+{
+  Dune::FieldMatrix<K, rows, inner> A;
+  Dune::FieldMatrix<K, inner, cols> B;
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < inner; ++j)
+      A[i][j] = K((i*inner+j) % 7) - K(3);
+  for (int i = 0; i < inner; ++i)
+    for (int j = 0; j < cols; ++j)
+      B[i][j] = K((i+2*j) % 5) - K(2);
+
+  Dune::FieldMatrix<K, rows, cols> reference;
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j)
+    {
+      reference[i][j] = K(0);
+      for (int p = 0; p < inner; ++p)
+        reference[i][j] += A[i][p]*B[p][j];
+    }
+
+  int errors = 0;
+  // call twice, the second call reuses the packing buffers of the first
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    if (A.rightmultiplyany(B) != reference)
+    {
+      std::cerr << "ERROR: rightmultiplyany of a " << rows << "x" << inner
+                << " and a " << inner << "x" << cols << " matrix is wrong"
+                << std::endl;
+      ++errors;
+    }
+    if (B.leftmultiplyany(A) != reference)
+    {
+      std::cerr << "ERROR: leftmultiplyany of a " << rows << "x" << inner
+                << " and a " << inner << "x" << cols << " matrix is wrong"
+                << std::endl;
+      ++errors;
+    }
+  }
+  return errors;
+}
+
 void test_initialisation()
 {
   DUNE_UNUSED Dune::FieldMatrix<int, 2, 2> const A = {
@@ -816,6 +860,11 @@ int main()
     test_invert< std::complex< long double >, 2 >();
     errors += test_invert_solve();
 
+    // test the cache-blocked matrix product
+    errors += test_blocked_multiply< double, 16, 16, 16 >();
+    errors += test_blocked_multiply< double, 20, 20, 17 >();
+    errors += test_blocked_multiply< float, 33, 18, 21 >();
+
     return (errors > 0 ? 1 : 0); // convert error count to unix exit status
   }
   catch (Dune::Exception & e)
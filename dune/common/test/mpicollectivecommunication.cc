@@ -9,6 +9,111 @@
 #include <dune/common/test/testsuite.hh>
 
 #include <iostream>
+#include <vector>
+
+template<class E, class F>
+bool throws(F&& f)
+{
+  try {
+    f();
+  }
+  catch (const E&) {
+    return true;
+  }
+  return false;
+}
+
+// the nonblocking collectives of the MPI and the sequential communication
+template<class Comm>
+void testNonblocking(Dune::TestSuite& t, const Comm& comm)
+{
+  const int rank = comm.rank();
+  const int size = comm.size();
+
+  {
+    // a value moved into the future, which is moved itself before it completes
+    auto future = comm.template iallreduce<std::plus<double> >(1.0);
+    t.check(future.valid()) << "future of iallreduce is not valid";
+    auto moved = std::move(future);
+    t.check(!future.valid()) << "moved from future is still valid";
+    while(!moved.ready()) {}
+    t.check(moved.get() == size) << "iallreduce of a value is wrong";
+    t.check(!moved.valid()) << "future is still valid after get";
+    t.check(throws<Dune::InvalidStateException>([&]{ moved.get(); }))
+      << "get of an invalid future does not throw";
+  }
+  {
+    // a vector reduced in place
+    std::vector<int> v(3, rank);
+    auto future = comm.template iallreduce<std::plus<int> >(v);
+    std::vector<int>& result = future.get();
+    t.check(&result == &v) << "iallreduce of an lvalue did not return it";
+    for(int x : v)
+      t.check(x == size*(size-1)/2) << "iallreduce of a vector is wrong";
+  }
+  {
+    const std::vector<int> in = { rank, -rank };
+    auto max = comm.template iallreduce<Dune::Max<int> >(in, std::vector<int>(2)).get();
+    t.check(max[0] == size-1 && max[1] == 0) << "iallreduce with separate output is wrong";
+  }
+  {
+    auto future = comm.ibarrier();
+    future.wait();
+    future.get();
+    t.check(!future.valid()) << "future of ibarrier is still valid after get";
+  }
+  {
+    double x = rank==0 ? 42 : -1;
+    comm.ibroadcast(x, 0).wait();
+    t.check(x == 42) << "ibroadcast is wrong";
+  }
+  {
+    auto all = comm.iallgather(rank, std::vector<int>(size)).get();
+    for(int p=0; p<size; ++p)
+      t.check(all[p] == p) << "iallgather is wrong at " << p;
+
+    std::vector<double> in = { 1.0*rank, 0.5 };
+    std::vector<double> gathered(rank==0 ? 2*size : 0);
+    comm.igather(std::move(in), gathered, 0).get();
+    for(int p=0; rank==0 && p<size; ++p)
+      t.check(gathered[2*p] == p && gathered[2*p+1] == 0.5) << "igather is wrong at " << p;
+
+    t.check(throws<Dune::RangeError>([&]{ comm.iallgather(rank, std::vector<int>(size-1)).get(); }))
+      << "iallgather into a too small output does not throw";
+  }
+  {
+    // an output that is too small on one process only, the others must
+    // not wait forever for it
+    std::vector<double> small(rank==0 ? size : 0);
+    t.check(throws<Dune::RangeError>([&]{
+          comm.igather(std::vector<double>{ 1.0*rank, 0.5 }, small, 0).get();
+        }) == (rank==0))
+      << "igather into a too small output on root does not throw on root only";
+
+    t.check(throws<Dune::RangeError>([&]{
+          comm.template iallreduce<std::plus<int> >(std::vector<int>(2, 1),
+                                                    std::vector<int>(rank==0 ? 1 : 2)).get();
+        }) == (rank==0))
+      << "iallreduce into a too small output on rank 0 does not throw on rank 0 only";
+  }
+  {
+    // the error is reported by the future, not when the communication starts
+    bool started = false;
+    t.check(throws<Dune::RangeError>([&]{
+          auto future = comm.iallgather(rank, std::vector<int>(size-1));
+          started = true;
+          future.wait();
+        }) && started)
+      << "iallgather into a too small output does not throw from wait()";
+
+    std::vector<double> small(0);
+    auto future = comm.igather(1.0*rank, small, 0);
+    t.check(throws<Dune::RangeError>([&]{ future.get(); }) == (rank==0))
+      << "igather into a too small output does not throw from get() on root";
+    t.check(!future.valid()) << "future is still valid after get";
+  }
+}
+
 int main(int argc, char** argv)
 {
   Dune::TestSuite t;
@@ -59,6 +164,9 @@ int main(int argc, char** argv)
     }
   }
 
+  testNonblocking(t, Dune::CollectiveCommunication<Helper::MPICommunicator>(mpi.getCommunicator()));
+  testNonblocking(t, Dune::CollectiveCommunication<Dune::No_Comm>());
+
   std::cout << "We are at the end!"<<std::endl;
 
   return t.exit();
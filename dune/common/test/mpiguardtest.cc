@@ -2,9 +2,61 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include <config.h>
 
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/parallel/mpiguard.hh>
 
+// Run steps with a deferred guard, the processes with rank > 0 fail
+// in the given step. Returns whether the errors were detected wrongly.
+bool testDeferred(Dune::MPIHelper & mpihelper, int steps, int failingStep)
+{
+  int step = 0;
+  bool detected = false;
+  auto work = [&]() {
+    if (step == failingStep && mpihelper.rank() > 0)
+      DUNE_THROW(Dune::Exception, "Fakeproblem on process " << mpihelper.rank());
+  };
+  try
+  {
+    Dune::MPIGuard guard(mpihelper);
+    guard.setDeferred(true);
+    for (; step < steps; ++step)
+    {
+      work();
+      guard.reactivate();
+    }
+    work();
+    guard.finalize();
+  }
+  catch (Dune::MPIGuardError & e)
+  {
+    detected = true;
+    std::cout << "Error (rank " << mpihelper.rank() << ", step " << step << "): "
+              << e.what() << std::endl;
+  }
+  catch (Dune::Exception & e)
+  {
+    std::cout << "Error (rank " << mpihelper.rank() << ", step " << step << "): "
+              << e.what() << std::endl;
+  }
+
+  bool failed;
+  if (mpihelper.rank() > 0)
+    failed = detected || step != failingStep;
+  else if (mpihelper.size() > 1)
+    failed = !detected || step != std::min(failingStep+1, steps);
+  else
+    failed = detected || step != steps;
+  if (failed)
+    std::cerr << "Wrong error detection of the deferred guard on rank "
+              << mpihelper.rank() << " for failing step " << failingStep
+              << " of " << steps << std::endl;
+  return failed;
+}
+
 int main(int argc, char** argv)
 {
   Dune::MPIHelper & mpihelper = Dune::MPIHelper::instance(argc, argv);
@@ -88,6 +140,31 @@ int main(int argc, char** argv)
   }
 
   mpihelper.getCollectiveCommunication().barrier();
+  if (mpihelper.rank() == 0)
+    std::cout << "---- deferred guard" << std::endl;
+  int failed = 0;
+  // the errors of a step are detected by the reactivate() of the next step,
+  // or by finalize() if there are no more steps
+  for (auto steps : { std::make_pair(4, 2), std::make_pair(4, 3),
+                      std::make_pair(4, 4), std::make_pair(0, 0) })
+    if (testDeferred(mpihelper, steps.first, steps.second))
+      ++failed;
+
+  // a deferred guard without errors
+  {
+    Dune::MPIGuard guard(mpihelper);
+    guard.setDeferred(true);
+    if (!guard.deferred())
+    {
+      std::cerr << "setDeferred() had no effect" << std::endl;
+      ++failed;
+    }
+    guard.reactivate();
+    guard.finalize();
+  }
+
+  failed = mpihelper.getCollectiveCommunication().max(failed);
   if (mpihelper.rank() == 0)
     std::cout << "---- done" << std::endl;
+  return failed;
 }
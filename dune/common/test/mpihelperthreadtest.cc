@@ -0,0 +1,80 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+// Let every thread communicate on its own communicator at the same time
+template<class Helper>
+void testThreadCommunicators(Dune::TestSuite& suite, Helper& helper, int threads)
+{
+  helper.createThreadCommunicators(threads);
+  suite.check(helper.threadCommunicators() == threads)
+    << "Wrong number of thread communicators";
+
+  std::vector<int> sums(threads), expected(threads);
+  std::vector<std::thread> workers;
+  for(int t=0; t<threads; ++t)
+    workers.emplace_back([&, t]() {
+        auto comm = Dune::CollectiveCommunication<typename Helper::MPICommunicator>(helper.getThreadCommunicator(t));
+        // several collectives, which would match the ones of other
+        // threads on a shared communicator
+        for(int i=0; i<10; ++i)
+          sums[t] = comm.sum((comm.rank()+1)*(t+1));
+        expected[t] = comm.size()*(comm.size()+1)/2*(t+1);
+      });
+  for(std::thread& worker : workers)
+    worker.join();
+
+  for(int t=0; t<threads; ++t)
+    suite.check(sums[t] == expected[t])
+      << "Wrong sum on the communicator of thread " << t;
+}
+
+int main(int argc, char** argv)
+{
+  typedef Dune::MPIHelper Helper;
+  Helper& helper = Helper::instance(argc, argv, Dune::MPIThreadLevel::multiple);
+  Dune::TestSuite suite;
+
+#if HAVE_MPI
+  int provided;
+  MPI_Query_thread(&provided);
+  suite.check((provided == MPI_THREAD_MULTIPLE) == (helper.threadLevel() == Dune::MPIThreadLevel::multiple))
+    << "threadLevel() does not return the level granted by MPI";
+#endif
+  std::cout << "Thread level " << int(helper.threadLevel()) << std::endl;
+
+  // a later call returns the same instance
+  suite.check(&Helper::instance(argc, argv) == &helper)
+    << "instance() does not return the singleton";
+
+  bool thrown = false;
+  try {
+    helper.getThreadCommunicator(0);
+  }
+  catch(const Dune::RangeError&) {
+    thrown = true;
+  }
+  suite.check(thrown) << "getThreadCommunicator() did not throw without communicators";
+
+  if(helper.threadLevel() == Dune::MPIThreadLevel::multiple)
+    testThreadCommunicators(suite, helper, 4);
+  else
+    std::cout << "MPI does not support concurrent communication of threads" << std::endl;
+
+  Dune::FakeMPIHelper& fake = Dune::FakeMPIHelper::instance(argc, argv, Dune::MPIThreadLevel::multiple);
+  suite.check(fake.threadLevel() == Dune::MPIThreadLevel::multiple)
+    << "The fake helper does not support threads";
+  testThreadCommunicators(suite, fake, 3);
+
+  return suite.exit();
+}